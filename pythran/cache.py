@@ -0,0 +1,139 @@
+'''
+This module implements an on-disk cache of compiled modules, so that compiling
+the same code twice with the same settings only invokes the compiler once.
+
+Each entry is a directory named after a digest of everything that influences
+the generated module, holding both the generated C++ file and the native module.
+Entries are evicted least recently used first when the cache grows over its
+size limit.
+'''
+
+from pythran.config import cfg
+
+import hashlib
+import logging
+import os
+import shutil
+import tempfile
+
+logger = logging.getLogger(__name__)
+
+
+def _sources_tag():
+    '''Summary of the pythonic headers and of the compiler modules, so that
+    modifying them invalidates modules built from a development tree that
+    still has the same version'''
+    root = os.path.dirname(os.path.abspath(__file__))
+    digest = hashlib.sha1()
+    for dirpath, dirnames, filenames in os.walk(root):
+        dirnames[:] = sorted(d for d in dirnames
+                             if not (dirpath == root and d == 'tests'))
+        in_pythonic = os.path.relpath(dirpath, root).startswith('pythonic')
+        for filename in sorted(filenames):
+            if not (in_pythonic or filename.endswith('.py')):
+                continue
+            stat = os.stat(os.path.join(dirpath, filename))
+            digest.update("{0}:{1}:{2}\n".format(
+                os.path.join(dirpath, filename), stat.st_size, stat.st_mtime))
+    return digest.hexdigest()
+
+
+def _settings_tag():
+    '''Every configuration setting but the cache ones, as typing settings
+    change the generated code'''
+    return sorted((section, sorted(cfg.items(section)))
+                  for section in cfg.sections() if section != 'cache')
+
+
+class ModuleCache(object):
+    '''Cache of generated modules, stored in `directory` and limited to
+    `max_size` bytes'''
+
+    _version_tag = None
+
+    def __init__(self, directory, max_size):
+        self.directory = directory
+        self.max_size = max_size
+
+    @staticmethod
+    def from_config():
+        '''Cache described by the [cache] section of pythran.cfg,
+        None if it is disabled'''
+        directory = cfg.get('cache', 'directory')
+        if not directory:
+            return None
+        directory = os.path.expanduser(os.path.expandvars(directory))
+        max_size = int(cfg.get('cache', 'max_size')) * 1024 * 1024
+        return ModuleCache(directory, max_size)
+
+    @classmethod
+    def version_tag(cls):
+        if cls._version_tag is None:
+            from pythran import __version__
+            cls._version_tag = "{0}-{1}".format(__version__, _sources_tag())
+        return cls._version_tag
+
+    def key(self, module_name, code, specs, optimizations, flags):
+        '''Digest identifying a module'''
+        digest = hashlib.sha1()
+        for item in (self.version_tag(), _settings_tag(), module_name, code,
+                     sorted((k, repr(v)) for k, v in specs.items()),
+                     optimizations, flags):
+            digest.update(repr(item))
+            digest.update('\0')
+        return digest.hexdigest()
+
+    def _entry(self, key):
+        return os.path.join(self.directory, key)
+
+    def lookup(self, key, filename):
+        '''Path to `filename` in the entry for `key`, None if missing'''
+        entry = self._entry(key)
+        path = os.path.join(entry, filename)
+        if not os.path.exists(path):
+            return None
+        try:
+            os.utime(entry, None)  # most recently used
+        except OSError:
+            pass
+        logger.info("Cache hit for {0} in {1}".format(filename, entry))
+        return path
+
+    def store(self, key, files):
+        '''Add the entry `key` holding copies of `files`, a dict from file
+        names inside the entry to paths of the files to copy'''
+        if not os.path.isdir(self.directory):
+            os.makedirs(self.directory)
+        # build the entry aside then move it in place, so that a concurrent
+        # lookup never sees a partial entry
+        tmp = tempfile.mkdtemp(dir=self.directory, prefix='.tmp')
+        try:
+            for filename, path in files.items():
+                shutil.copy(path, os.path.join(tmp, filename))
+            entry = self._entry(key)
+            if os.path.isdir(entry):
+                shutil.rmtree(entry, ignore_errors=True)
+            os.rename(tmp, entry)
+        except OSError:  # another process stored the same entry meanwhile
+            shutil.rmtree(tmp, ignore_errors=True)
+            return
+        self.evict()
+
+    def evict(self):
+        '''Remove least recently used entries until the cache fits its size'''
+        entries = []
+        total = 0
+        for name in os.listdir(self.directory):
+            entry = os.path.join(self.directory, name)
+            if name.startswith('.') or not os.path.isdir(entry):
+                continue
+            size = sum(os.path.getsize(os.path.join(entry, f))
+                       for f in os.listdir(entry))
+            entries.append((os.path.getmtime(entry), size, entry))
+            total += size
+        for _, size, entry in sorted(entries):
+            if total <= self.max_size:
+                break
+            logger.info("Evicting {0} from cache".format(entry))
+            shutil.rmtree(entry, ignore_errors=True)
+            total -= size
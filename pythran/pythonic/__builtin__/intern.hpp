@@ -0,0 +1,36 @@
+#ifndef PYTHONIC_BUILTIN_INTERN_HPP
+#define PYTHONIC_BUILTIN_INTERN_HPP
+
+#include "pythonic/types/str.hpp"
+#include "pythonic/utils/flat_hash.hpp"
+#include "pythonic/utils/proxy.hpp"
+
+namespace pythonic {
+
+    namespace __builtin__ {
+
+        /* Equal interned strings share their buffer and come with their
+         * hash, so that comparing them, as dict keys do, does not read
+         * their content.
+         */
+        types::str intern(types::str const &s) {
+            static utils::flat_set<types::str> interned;
+            types::str out;
+            s.hash();
+#pragma omp critical(pythran_intern)
+            {
+                auto found = interned.find(s);
+                // s may be a view on a larger string, that should not be kept alive
+                if(found == interned.end())
+                    found = interned.insert(types::str(s.begin(), s.end())).first;
+                out = *found;
+            }
+            return out;
+        }
+        PROXY(pythonic::__builtin__,intern);
+
+    }
+
+}
+
+#endif
@@ -2,16 +2,56 @@
 #define PYTHONIC_BUILTIN_PYTHRAN_LEN_SET_HPP
 
 #include "pythonic/utils/proxy.hpp"
+#include "pythonic/utils/flat_hash.hpp"
+#include "pythonic/utils/sort.hpp"
 
-#include <set>
+#include <functional>
+#include <type_traits>
+#include <vector>
 
 namespace pythonic {
     namespace __builtin__ {
         namespace pythran {
 
+            // numbers are sorted, and distinct neighbours counted
+            template <class T, class Iterable>
+                size_t _len_set(Iterable const& s, std::true_type) {
+                    std::vector<T> values(s.begin(), s.end());
+                    utils::sort(values.begin(), values.end());
+                    size_t n = 0;
+                    for(size_t i = 0; i < values.size(); ++i)
+                        n += i == 0 or not (values[i] == values[i - 1]);
+                    return n;
+                }
+
+            struct _len_set_deref {
+                template<class T>
+                    T const& operator()(T const* p) const { return *p; }
+            };
+
+            // other values are indexed by address when the iterable stores them, not copied
+            template <class T, class Iterable>
+                size_t _len_set_distinct(Iterable const& s, std::true_type) {
+                    utils::flat_table<T const*, T, _len_set_deref, boost::hash<T>, std::equal_to<T>> seen;
+                    for(auto const& v : s)
+                        seen.insert_index(v, [&v]() { return &v; });
+                    return seen.size();
+                }
+
+            template <class T, class Iterable>
+                size_t _len_set_distinct(Iterable const& s, std::false_type) {
+                    return utils::flat_set<T>(s.begin(), s.end()).size();
+                }
+
+            template <class T, class Iterable>
+                size_t _len_set(Iterable const& s, std::false_type) {
+                    return _len_set_distinct<T>(s, std::is_lvalue_reference<decltype(*s.begin())>());
+                }
+
             template <class Iterable>
                 size_t len_set(Iterable const& s) {
-                    return std::set<typename Iterable::iterator::value_type>(s.begin(), s.end()).size();
+                    typedef typename std::remove_cv<typename Iterable::iterator::value_type>::type T;
+                    return _len_set<T>(s, std::integral_constant<bool, std::is_arithmetic<T>::value>());
                 }
 
             PROXY(pythonic::__builtin__::pythran, len_set);
@@ -20,4 +60,3 @@ namespace pythonic {
 }
 
 #endif
-
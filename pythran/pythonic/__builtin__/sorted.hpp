@@ -3,6 +3,7 @@
 
 #include "pythonic/utils/proxy.hpp"
 #include "pythonic/types/list.hpp"
+#include "pythonic/utils/sort.hpp"
 
 #include <algorithm>
 
@@ -12,13 +13,13 @@ namespace pythonic {
         template <class Iterable>
             types::list<typename std::remove_cv<typename Iterable::iterator::value_type>::type> sorted(Iterable const& seq) {
                 types::list<typename std::remove_cv<typename Iterable::iterator::value_type>::type> out(seq.begin(), seq.end());
-                std::sort(out.begin(), out.end());
+                utils::sort(out.begin(), out.end());
                 return out;
             }
         template <class Iterable, class C>
             types::list<typename std::remove_cv<typename Iterable::iterator::value_type>::type> sorted(Iterable const& seq, C const& cmp) {
                 types::list<typename std::remove_cv<typename Iterable::iterator::value_type>::type> out(seq.begin(), seq.end());
-                std::sort(out.begin(), out.end(), cmp);
+                utils::stable_sort(out.begin(), out.end(), cmp);
                 return out;
             }
         PROXY(pythonic::__builtin__, sorted);
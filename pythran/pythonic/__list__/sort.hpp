@@ -3,6 +3,7 @@
 
 #include "pythonic/utils/proxy.hpp"
 #include "pythonic/types/list.hpp"
+#include "pythonic/utils/sort.hpp"
 #include "pythonic/__builtin__/None.hpp"
 
 namespace pythonic {
@@ -10,7 +11,7 @@ namespace pythonic {
     namespace __list__ {
         template<class T>
             types::none_type sort(types::list<T> &seq) {
-                std::sort(seq.begin(),seq.end());
+                utils::sort(seq.begin(),seq.end());
                 return __builtin__::None;
             }
 
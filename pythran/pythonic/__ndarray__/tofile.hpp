@@ -0,0 +1,82 @@
+#ifndef PYTHONIC_NDARRAY_TOFILE_HPP
+#define PYTHONIC_NDARRAY_TOFILE_HPP
+
+#include "pythonic/utils/proxy.hpp"
+#include "pythonic/utils/numpy_conversion.hpp"
+#include "pythonic/types/ndarray.hpp"
+#include "pythonic/types/file.hpp"
+#include "pythonic/__builtin__/None.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <type_traits>
+
+namespace pythonic {
+
+    namespace __ndarray__ {
+
+        // text representation of an item, as str() would print it
+        template<class T>
+            typename std::enable_if<std::is_floating_point<T>::value, int>::type _tofile_format(char* buffer, size_t size, T value) {
+                int n = snprintf(buffer, size, "%.12g", double(value));
+                // integral values keep a trailing .0, unlike inf and nan
+                if(not std::strpbrk(buffer, ".en")) {
+                    buffer[n++] = '.';
+                    buffer[n++] = '0';
+                    buffer[n] = 0;
+                }
+                return n;
+            }
+        template<class T>
+            typename std::enable_if<std::is_integral<T>::value and std::is_signed<T>::value, int>::type _tofile_format(char* buffer, size_t size, T value) {
+                return snprintf(buffer, size, "%lld", (long long)value);
+            }
+        template<class T>
+            typename std::enable_if<std::is_integral<T>::value and not std::is_signed<T>::value, int>::type _tofile_format(char* buffer, size_t size, T value) {
+                return snprintf(buffer, size, "%llu", (unsigned long long)value);
+            }
+
+        /* Binary data is written in one go, text data is formatted into a
+         * buffer written by blocks.
+         */
+        template<class T, size_t N>
+            types::none_type tofile(types::ndarray<T, N> const& expr, types::file& f, types::str const& sep = "") {
+                if(not sep) {
+                    f.write_bytes(expr.buffer, expr.size() * sizeof(T));
+                    return __builtin__::None;
+                }
+                std::string out;
+                char item[64];
+                for(long i = 0, n = expr.size(); i < n; ++i) {
+                    if(i)
+                        out.append(sep.data(), sep.size());
+                    out.append(item, _tofile_format(item, sizeof(item), expr.buffer[i]));
+                    if(out.size() >= (1 << 16)) {
+                        f.write_bytes(out.data(), out.size());
+                        out.clear();
+                    }
+                }
+                f.write_bytes(out.data(), out.size());
+                return __builtin__::None;
+            }
+
+        template<class T, size_t N>
+            types::none_type tofile(types::ndarray<T, N> const& expr, types::file&& f, types::str const& sep = "") {
+                return tofile(expr, f, sep);
+            }
+
+        template<class T, size_t N>
+            types::none_type tofile(types::ndarray<T, N> const& expr, types::str const& filename, types::str const& sep = "") {
+                types::file f(filename, sep ? "w" : "wb");
+                return tofile(expr, f, sep);
+            }
+
+        NUMPY_EXPR_TO_NDARRAY0(tofile);
+        PROXY(pythonic::__ndarray__, tofile);
+
+    }
+
+}
+
+#endif
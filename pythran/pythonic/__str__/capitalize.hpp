@@ -11,10 +11,10 @@ namespace pythonic {
         {
             if(s.empty()) return s;
             else {
-                types::str copy = s;
+                std::string copy(s.begin(), s.end());
                 copy[0] = ::toupper(s[0]);
                 std::transform(s.begin()+1, s.end(), copy.begin()+1, ::tolower);
-                return copy;
+                return types::str(std::move(copy));
             }
         }
         PROXY(pythonic::__str__, capitalize);
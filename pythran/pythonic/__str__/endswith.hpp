@@ -4,14 +4,14 @@
 #include "pythonic/utils/proxy.hpp"
 #include "pythonic/types/str.hpp"
 
+#include <limits>
+
 namespace pythonic {
 
     namespace __str__ {
-        bool endswith(types::str const& s, types::str const& suffix, long start=0, size_t end=std::string::npos) {
-            if(end == std::string::npos)
-                end = s.size();
-            long rstart = end - suffix.size();
-            return rstart >= start and s.compare(rstart, suffix.size(), suffix) == 0;
+        bool endswith(types::str const& s, types::str const& suffix, long start=0, long end=std::numeric_limits<long>::max()) {
+            s.adjust_indices(start, end);
+            return end - start >= long(suffix.size()) and std::memcmp(s.data() + end - suffix.size(), suffix.data(), suffix.size()) == 0;
         }
         PROXY(pythonic::__str__, endswith);
 
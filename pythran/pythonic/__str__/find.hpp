@@ -4,19 +4,18 @@
 #include "pythonic/utils/proxy.hpp"
 #include "pythonic/types/str.hpp"
 
+#include <limits>
+
 namespace pythonic {
 
     namespace __str__ {
 
-        long find(types::str const & s, types::str const& value, size_t start, long long end) {
-            long a = s.find(value,start);
-            return (a>end)?-1:a;
-        }
-        long find(types::str const & s, types::str const& value, size_t start) {
-            return find(s,value,start,s.size());
-        }
-        long find(types::str const & s, types::str const& value) {
-            return find(s,value,0,s.size());
+        long find(types::str const & s, types::str const& value, long start=0, long end=std::numeric_limits<long>::max()) {
+            s.adjust_indices(start, end);
+            if(end - start < long(value.size()))
+                return -1;
+            size_t a = s.find(value, start);
+            return (a == types::str::npos or a + value.size() > size_t(end)) ? -1 : long(a);
         }
         PROXY(pythonic::__str__, find);
     }
@@ -3,6 +3,7 @@
 
 #include "pythonic/utils/proxy.hpp"
 #include "pythonic/types/str.hpp"
+#include "pythonic/utils/str_search.hpp"
 
 namespace pythonic {
 
@@ -10,7 +11,7 @@ namespace pythonic {
         using std::isdigit;
 
         bool isdigit(types::str const& s) {
-            return not s.empty() and std::all_of(s.begin(), s.end(), (int (*)(int))std::isdigit);
+            return not s.empty() and utils::all_in_range(s.begin(), s.end(), '0', '9');
         }
         PROXY(pythonic::__str__, isdigit);
 
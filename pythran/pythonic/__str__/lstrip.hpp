@@ -9,7 +9,11 @@ namespace pythonic {
     namespace __str__ {
         types::str lstrip(types::str const& self, types::str const& to_del = " ")
         {
-            return types::str(self.begin() + self.find_first_not_of(to_del), self.end());
+            auto first = self.find_first_not_of(to_del);
+            if(first == types::str::npos)
+                return types::str();
+            else
+                return self.substr(first);
         }
         PROXY(pythonic::__str__, lstrip);
 
@@ -0,0 +1,30 @@
+#ifndef PYTHONIC_STR_PARTITION_HPP
+#define PYTHONIC_STR_PARTITION_HPP
+
+#include "pythonic/utils/proxy.hpp"
+#include "pythonic/types/str.hpp"
+#include "pythonic/types/tuple.hpp"
+#include "pythonic/__builtin__/ValueError.hpp"
+
+namespace pythonic {
+
+    namespace __str__ {
+
+        auto partition(types::str const& s, types::str const& sep)
+            -> decltype(types::make_tuple(s, sep, s))
+        {
+            if(sep.empty())
+                throw types::ValueError("empty separator");
+            size_t pos = s.find(sep);
+            if(pos == types::str::npos)
+                return types::make_tuple(s, types::str(), types::str());
+            else
+                return types::make_tuple(s.substr(0, pos), sep, s.substr(pos + sep.size()));
+        }
+        PROXY(pythonic::__str__, partition);
+
+    }
+
+}
+
+#endif
@@ -3,41 +3,44 @@
 
 #include "pythonic/utils/proxy.hpp"
 #include "pythonic/types/str.hpp"
+#include "pythonic/utils/str_search.hpp"
+
+#include <limits>
+#include <string>
 
 namespace pythonic {
 
     namespace __str__ {
         types::str replace(types::str const& self, types::str const& old_pattern, types::str const& new_pattern, long count=std::numeric_limits<long>::max())
         {
-            char const * needle = old_pattern.c_str();
-            char const * new_needle = new_pattern.c_str();
-            char const * new_needle_end = new_needle + new_pattern.size();
-            char const * haystack = self.c_str();
-
-            char const * haystack_next = strstr(haystack, needle);
-            if(not count or not haystack_next) {
-                return types::str(haystack);
-            }
-            else {
-                size_t n = 1 + std::max(self.size(), self.size()* (1+new_pattern.size()) / (1+old_pattern.size()));
-                char *buffer = new char[n];
-                char *iter = buffer;
-                do {
-                    iter = std::copy(haystack, haystack_next, iter);
-                    iter = std::copy(new_needle, new_needle_end, iter);
-                    count -= 1;
-                    haystack = haystack_next + old_pattern.size();
-                    assert(size_t(iter - buffer) < n);
-                } while(count and (haystack_next=strstr(haystack, needle)));
-                std::copy(haystack, self.c_str() + self.size() + 1, iter);
-
-                types::str replaced(buffer);
-                delete [] buffer;
-                return replaced;
+            char const * first = self.begin();
+            char const * last = self.end();
+            std::string replaced;
+            if(old_pattern.empty()) {
+                // new_pattern goes before each character and at the end
+                replaced.reserve(self.size() + std::min<size_t>(count, self.size() + 1) * new_pattern.size());
+                for(; count and first != last; --count, ++first) {
+                    replaced.append(new_pattern.begin(), new_pattern.end());
+                    replaced.push_back(*first);
+                }
+                if(count)
+                    replaced.append(new_pattern.begin(), new_pattern.end());
+                replaced.append(first, last);
+                return types::str(std::move(replaced));
             }
-
+            char const * next = count ? utils::find_substr(first, last, old_pattern.begin(), old_pattern.size()) : nullptr;
+            if(not next)
+                return self;
+            replaced.reserve(self.size());
+            do {
+                replaced.append(first, next);
+                replaced.append(new_pattern.begin(), new_pattern.end());
+                first = next + old_pattern.size();
+                count -= 1;
+            } while(count and (next = utils::find_substr(first, last, old_pattern.begin(), old_pattern.size())));
+            replaced.append(first, last);
+            return types::str(std::move(replaced));
         }
-
         PROXY(pythonic::__str__, replace);
 
     }
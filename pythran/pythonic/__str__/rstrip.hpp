@@ -9,7 +9,11 @@ namespace pythonic {
     namespace __str__ {
         types::str rstrip(types::str const& self, types::str const& to_del = " ")
         {
-            return types::str(self.begin(), self.begin() + self.find_last_not_of(to_del) + 1);
+            auto last = self.find_last_not_of(to_del);
+            if(last == types::str::npos)
+                return types::str();
+            else
+                return self.substr(0, last + 1);
         }
         PROXY(pythonic::__str__, rstrip);
 
@@ -4,13 +4,14 @@
 #include "pythonic/utils/proxy.hpp"
 #include "pythonic/types/str.hpp"
 
+#include <limits>
+
 namespace pythonic {
 
     namespace __str__ {
-        bool startswith(types::str const& s, types::str const& prefix, long start=0, size_t end=std::string::npos) {
-            if(end == std::string::npos)
-                end = s.size();
-            return (end - start) >= prefix.size() and s.compare(start, prefix.size(), prefix) == 0;
+        bool startswith(types::str const& s, types::str const& prefix, long start=0, long end=std::numeric_limits<long>::max()) {
+            s.adjust_indices(start, end);
+            return end - start >= long(prefix.size()) and std::memcmp(s.data() + start, prefix.data(), prefix.size()) == 0;
         }
 
         PROXY(pythonic::__str__, startswith);
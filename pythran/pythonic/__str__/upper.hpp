@@ -3,15 +3,16 @@
 
 #include "pythonic/utils/proxy.hpp"
 #include "pythonic/types/str.hpp"
+#include "pythonic/utils/str_search.hpp"
 
 namespace pythonic {
 
     namespace __str__ {
         types::str upper(types::str const & s)
         {
-            types::str copy = s;
-            std::transform(s.begin(),s.end(), copy.begin(), ::toupper);
-            return copy;
+            std::string copy(s.size(), 0);
+            utils::shift_range(s.begin(), s.end(), &copy[0], 'a', 'z', 'A' - 'a');
+            return types::str(std::move(copy));
         }
         PROXY(pythonic::__str__, upper);
 
@@ -4,7 +4,8 @@
 #include "pythonic/utils/proxy.hpp"
 #include "pythonic/types/ndarray.hpp"
 #include "pythonic/__builtin__/ValueError.hpp"
-#include "pythonic/numpy/multiply.hpp"
+#include "pythonic/numpy/logical_and.hpp"
+#include "pythonic/numpy/reduce.hpp"
 
 namespace pythonic {
 
@@ -30,36 +31,20 @@ namespace pythonic {
                 return _all(expr.begin(), expr.end(), utils::int_<types::numpy_expr_to_ndarray<E>::N>());
             }
 
-        template<class T>
-            bool all(types::ndarray<T,1> const& array, long axis)
+        template<class E>
+            typename std::enable_if<E::value == 1, bool>::type
+            all(E const& array, long axis)
             {
                 if(axis != 0)
                     throw types::ValueError("axis out of bounds");
                 return all(array);
             }
 
-        template<class T, size_t N>
-            types::ndarray<bool,N - 1>
-            all(types::ndarray<T,N> const& array, long axis)
+        template<class E>
+            typename std::enable_if<E::value != 1, types::ndarray<bool, E::value - 1>>::type
+            all(E const& array, long axis)
             {
-                if(axis<0 || axis >=long(N))
-                    throw types::ValueError("axis out of bounds");
-                auto shape = array.shape;
-                if(axis==0)
-                {
-                    types::array<long, N - 1> shp;
-                    std::copy(shape.begin() + 1, shape.end(), shp.begin());
-                    types::ndarray<bool,N-1> out(shp, true);
-                    return std::accumulate(array.begin(), array.end(), out, proxy::multiply());
-                }
-                else
-                {
-                    types::array<long, N-1> shp;
-                    std::copy(shape.begin(), shape.end() - 1, shp.begin());
-                    types::ndarray<bool ,N-1> ally(shp, __builtin__::None);
-                    std::transform(array.begin(), array.end(), ally.begin(), [=](types::ndarray<T,N-1> const& other) {return all(other, axis-1);});
-                    return ally;
-                }
+                return reduce<proxy::logical_and, bool>(array, axis);
             }
 
         PROXY(pythonic::numpy, all);
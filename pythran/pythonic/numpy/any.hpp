@@ -4,7 +4,8 @@
 #include "pythonic/utils/proxy.hpp"
 #include "pythonic/types/ndarray.hpp"
 #include "pythonic/__builtin__/ValueError.hpp"
-#include "pythonic/numpy/add.hpp"
+#include "pythonic/numpy/logical_or.hpp"
+#include "pythonic/numpy/reduce.hpp"
 
 namespace pythonic {
 
@@ -30,40 +31,22 @@ namespace pythonic {
                 return _any(expr.begin(), expr.end(), utils::int_<types::numpy_expr_to_ndarray<E>::N>());
             }
 
-        template<class T>
-            bool any(types::ndarray<T,1> const& array, long axis)
+        template<class E>
+            typename std::enable_if<E::value == 1, bool>::type
+            any(E const& array, long axis)
             {
                 if(axis != 0)
                     throw types::ValueError("axis out of bounds");
                 return any(array);
             }
 
-        template<class T, size_t N>
-            types::ndarray<bool,N - 1>
-            any(types::ndarray<T,N> const& array, long axis)
+        template<class E>
+            typename std::enable_if<E::value != 1, types::ndarray<bool, E::value - 1>>::type
+            any(E const& array, long axis)
             {
-                if(axis<0 || axis >=long(N))
-                    throw types::ValueError("axis out of bounds");
-                auto shape = array.shape;
-                if(axis==0)
-                {
-                    types::array<long, N> shp;
-                    shp[0] = 1;
-                    std::copy(shape.begin() + 1, shape.end(), shp.begin() + 1);
-                    types::ndarray<bool,N> out(shp, false);
-                    return std::accumulate(array.begin(), array.end(), *out.begin(), numpy::proxy::add());
-                }
-                else
-                {
-                    types::array<long, N-1> shp;
-                    std::copy(shape.begin(), shape.end() - 1, shp.begin());
-                    types::ndarray<bool,N-1> anyy(shp, __builtin__::None);
-                    std::transform(array.begin(), array.end(), anyy.begin(), [=](types::ndarray<T,N-1> const& other) {return any(other, axis-1);});
-                    return anyy;
-                }
+                return reduce<proxy::logical_or, bool>(array, axis);
             }
 
-
         PROXY(pythonic::numpy, any);
 
     }
@@ -0,0 +1,48 @@
+#ifndef PYTHONIC_NUMPY_ARGPARTITION_HPP
+#define PYTHONIC_NUMPY_ARGPARTITION_HPP
+
+#include "pythonic/utils/proxy.hpp"
+#include "pythonic/utils/numpy_conversion.hpp"
+#include "pythonic/utils/sort.hpp"
+#include "pythonic/types/ndarray.hpp"
+#include "pythonic/numpy/sort.hpp"
+#include "pythonic/numpy/partition.hpp"
+
+#include <numeric>
+
+namespace pythonic {
+
+    namespace numpy {
+        template<class T, size_t N, class K>
+            types::ndarray<long,N> argpartition(types::ndarray<T,N> const& a, K const& kth, long axis=-1)
+            {
+                while(axis<0)
+                    axis += N;
+                axis = axis%N;
+                std::vector<long> const positions = _kth_positions(kth, a.shape[axis]);
+                types::ndarray<long,N> indices(a.shape, __builtin__::None);
+                T const* values = a.buffer;
+                long* data = indices.buffer;
+                _foreach_lane<long>(a.shape, axis,
+                        [values, data, &positions](long, long offset, long n, long stride, long* buffer) {
+                            long* lane = stride == 1 ? data + offset : buffer;
+                            std::iota(lane, lane + n, 0L);
+                            utils::sort_less<T> less;
+                            T const* first = values + offset;
+                            utils::multi_select(lane, lane + n, positions.begin(), positions.end(),
+                                                [first, stride, less](long i, long j) { return less(first[i * stride], first[j * stride]); });
+                            if(stride != 1)
+                                for(long i = 0; i < n; ++i)
+                                    data[offset + i * stride] = buffer[i];
+                        });
+                return indices;
+            }
+
+        NUMPY_EXPR_TO_NDARRAY0(argpartition)
+            PROXY(pythonic::numpy, argpartition);
+
+    }
+
+}
+
+#endif
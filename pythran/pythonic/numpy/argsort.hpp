@@ -2,34 +2,40 @@
 #define PYTHONIC_NUMPY_ARGSORT_HPP
 
 #include "pythonic/utils/proxy.hpp"
+#include "pythonic/utils/numpy_conversion.hpp"
+#include "pythonic/utils/sort.hpp"
 #include "pythonic/types/ndarray.hpp"
+#include "pythonic/numpy/sort.hpp"
 
 namespace pythonic {
 
     namespace numpy {
         template<class T, size_t N>
-            types::ndarray<long, N> argsort(types::ndarray<T,N> const& a) {
-                size_t last_axis = a.shape[N-1];
-                size_t n = a.size();
+            types::ndarray<long, N> argsort(types::ndarray<T,N> const& a, long axis=-1) {
+                while(axis<0)
+                    axis += N;
+                axis = axis%N;
                 types::ndarray<long, N> indices(a.shape, __builtin__::None);
-                for(long j=0, * iter_indices = indices.buffer, *end_indices = indices.buffer + n;
-                        iter_indices != end_indices;
-                        iter_indices += last_axis, j+=last_axis)
-                {
-                    // fill with the original indices
-                    std::iota(iter_indices, iter_indices + last_axis, 0L);
-                    // sort the index using the value from a
-                    std::sort(iter_indices, iter_indices + last_axis,
-                            [&a,j](long i1, long i2) {return *(a.fbegin() + j + i1) < *(a.fbegin() + j + i2);});
-                }
+                T const* values = a.buffer;
+                long* data = indices.buffer;
+                _foreach_lane<long>(a.shape, axis,
+                        [values, data](long, long offset, long n, long stride, long* buffer) {
+                            if(stride == 1)
+                                utils::argsort(values + offset, n, 1, data + offset);
+                            else {
+                                utils::argsort(values + offset, n, stride, buffer);
+                                for(long i = 0; i < n; ++i)
+                                    data[offset + i * stride] = buffer[i];
+                            }
+                        });
                 return indices;
             }
 
-        PROXY(pythonic::numpy, argsort);
+        NUMPY_EXPR_TO_NDARRAY0(argsort)
+            PROXY(pythonic::numpy, argsort);
 
     }
 
 }
 
 #endif
-
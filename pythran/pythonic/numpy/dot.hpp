@@ -4,6 +4,24 @@
 #include "pythonic/numpy/asarray.hpp"
 #include "pythonic/numpy/sum.hpp"
 #include "pythonic/types/traits.hpp"
+#include "pythonic/types/ndarray.hpp"
+#include "pythonic/types/vectorizable_type.hpp"
+#include "pythonic/utils/allocate.hpp"
+#include "pythonic/utils/broadcast_copy.hpp"
+#include "pythonic/__builtin__/ValueError.hpp"
+
+#include <algorithm>
+#include <memory>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#ifdef USE_BOOST_SIMD
+#include <boost/simd/sdk/simd/native.hpp>
+#include <boost/simd/include/functions/aligned_load.hpp>
+#include <boost/simd/include/functions/aligned_store.hpp>
+#endif
 
 namespace pythonic {
 
@@ -26,6 +44,338 @@ namespace pythonic {
                 dot(E const& e, F const& f) {
                     return sum(e*f);
                 }
+        /* Matrix products
+         *
+         * The operands of 1-D / 2-D products are read through a strided view,
+         * so that arrays, transposed arrays and sliced arrays are used in
+         * place. Other expressions are evaluated first.
+         */
+        template<class T>
+            struct _dot_view {
+                T const* data;
+                long shape[2];
+                long stride[2];
+
+                T const& operator()(long i, long j) const { return data[i * stride[0] + j * stride[1]]; }
+                _dot_view transposed() const { return {data, {shape[1], shape[0]}, {stride[1], stride[0]}}; }
+            };
+
+        // a 1-D operand is viewed as a column
+        template<class T>
+            _dot_view<T> _make_dot_view(types::ndarray<T, 1> const& a) {
+                return {a.buffer, {a.shape[0], 1}, {1, 0}};
+            }
+        template<class T>
+            _dot_view<T> _make_dot_view(types::ndarray<T, 2> const& a) {
+                return {a.buffer, {a.shape[0], a.shape[1]}, {a.shape[1], 1}};
+            }
+        template<class T>
+            _dot_view<T> _make_dot_view(types::numpy_texpr<types::ndarray<T, 2>> const& a) {
+                return _make_dot_view(a.arg).transposed();
+            }
+        template<class Arg>
+            typename std::enable_if<types::numpy_iexpr<Arg>::value == 1,
+                                    _dot_view<typename types::numpy_iexpr<Arg>::dtype>>::type
+            _make_dot_view(types::numpy_iexpr<Arg> const& a) {
+                return {a.buffer, {a.shape[0], 1}, {1, 0}};
+            }
+
+        // slices of arrays, lower and step are expressed in terms of the sliced array
+        template<class Arg>
+            struct _is_dot_viewable_arg {
+                typedef typename std::remove_cv<typename std::remove_reference<Arg>::type>::type type;
+                static const bool value = std::is_same<type, types::ndarray<typename type::dtype, type::value>>::value and type::value <= 2;
+            };
+
+        template<class Arg, class S>
+            typename std::enable_if<_is_dot_viewable_arg<Arg>::value and not std::is_same<S, long>::value,
+                                    _dot_view<typename types::numpy_gexpr<Arg, S>::dtype>>::type
+            _make_dot_view(types::numpy_gexpr<Arg, S> const& a) {
+                auto v = _make_dot_view(a.arg);
+                return {v.data + a.lower[0] * v.stride[0], {a.shape[0], v.shape[1]}, {a.step[0] * v.stride[0], v.stride[1]}};
+            }
+        template<class Arg, class S0, class S1>
+            typename std::enable_if<_is_dot_viewable_arg<Arg>::value and not std::is_same<S0, long>::value and not std::is_same<S1, long>::value,
+                                    _dot_view<typename types::numpy_gexpr<Arg, S0, S1>::dtype>>::type
+            _make_dot_view(types::numpy_gexpr<Arg, S0, S1> const& a) {
+                auto v = _make_dot_view(a.arg);
+                return {v.data + a.lower[0] * v.stride[0] + a.lower[1] * v.stride[1],
+                        {a.shape[0], a.shape[1]},
+                        {a.step[0] * v.stride[0], a.step[1] * v.stride[1]}};
+            }
+        template<class Arg, class S>
+            typename std::enable_if<_is_dot_viewable_arg<Arg>::value and not std::is_same<S, long>::value,
+                                    _dot_view<typename types::numpy_gexpr<Arg, long, S>::dtype>>::type
+            _make_dot_view(types::numpy_gexpr<Arg, long, S> const& a) { // a[i, s]
+                auto v = _make_dot_view(a.arg);
+                return {v.data + a.indices[0] * v.stride[0] + a.lower[0] * v.stride[1], {a.shape[0], 1}, {a.step[0] * v.stride[1], 0}};
+            }
+        template<class Arg, class S>
+            typename std::enable_if<_is_dot_viewable_arg<Arg>::value and not std::is_same<S, long>::value,
+                                    _dot_view<typename types::numpy_gexpr<Arg, S, long>::dtype>>::type
+            _make_dot_view(types::numpy_gexpr<Arg, S, long> const& a) { // a[s, j]
+                auto v = _make_dot_view(a.arg);
+                return {v.data + a.lower[0] * v.stride[0] + a.indices[0] * v.stride[1], {a.shape[0], 1}, {a.step[0] * v.stride[0], 0}};
+            }
+
+        template<class E, class _ = void>
+            struct _has_dot_view : std::false_type {
+            };
+        template<class E>
+            struct _has_dot_view<E, decltype(void(_make_dot_view(std::declval<E const&>())))> : std::true_type {
+            };
+
+        template<class E>
+            typename std::enable_if<_has_dot_view<E>::value, E const&>::type
+            _dot_operand(E const& e) {
+                return e;
+            }
+        template<class E>
+            typename std::enable_if<not _has_dot_view<E>::value, typename types::numpy_expr_to_ndarray<E>::type>::type
+            _dot_operand(E const& e) {
+                return typename types::numpy_expr_to_ndarray<E>::type(e);
+            }
+
+        /* Blocking parameters of the matrix-matrix product
+         *
+         * The kernel computes an ``mr'' x ``nr'' block of the result in
+         * registers. Panels of ``mc'' x ``kc'' elements of the left operand and
+         * ``kc'' x ``nc'' elements of the right operand are packed in
+         * contiguous buffers beforehand, so that the kernel only performs
+         * unit-stride reads.
+         */
+        template<class T, bool vectorize = types::is_vectorizable<T>::value>
+            struct _dot_blocking {
+                static const long vN = 1;
+                static const long mr = 4;
+                static const long nr = 4;
+                static const long kc = 256;
+                static const long mc = 64;
+                static const long nc = 2048;
+            };
+#ifdef USE_BOOST_SIMD
+        template<class T>
+            struct _dot_blocking<T, true> {
+                typedef boost::simd::native<T, BOOST_SIMD_DEFAULT_EXTENSION> vT;
+                static const long vN = boost::simd::meta::cardinal_of<vT>::value;
+                static const long mr = 4;
+                static const long nr = 2 * vN;
+                static const long kc = 256;
+                static const long mc = 64;
+                static const long nc = 2048 / nr * nr;
+            };
+#endif
+
+        // c[:m, :n] += a.b where a is a packed mr x kc panel and b a packed kc x nr panel
+        template<class T>
+            typename std::enable_if<_dot_blocking<T>::vN == 1>::type
+            _dot_kernel(long kc, T const* a, T const* b, T* c, long ldc, long m, long n) {
+                typedef _dot_blocking<T> blk;
+                T acc[blk::mr][blk::nr] = {};
+                for(long p = 0; p < kc; ++p, a += blk::mr, b += blk::nr)
+                    for(long i = 0; i < blk::mr; ++i)
+                        for(long j = 0; j < blk::nr; ++j)
+                            acc[i][j] += a[i] * b[j];
+                for(long i = 0; i < m; ++i)
+                    for(long j = 0; j < n; ++j)
+                        c[i * ldc + j] += acc[i][j];
+            }
+#ifdef USE_BOOST_SIMD
+        template<class T>
+            typename std::enable_if<(_dot_blocking<T>::vN > 1)>::type
+            _dot_kernel(long kc, T const* a, T const* b, T* c, long ldc, long m, long n) {
+                typedef _dot_blocking<T> blk;
+                typedef typename blk::vT vT;
+                vT acc[blk::mr][2];
+                for(long i = 0; i < blk::mr; ++i)
+                    acc[i][0] = acc[i][1] = boost::simd::splat<vT>(T(0));
+                for(long p = 0; p < kc; ++p, a += blk::mr, b += blk::nr) {
+                    vT b0 = boost::simd::aligned_load<vT>(b, 0),
+                       b1 = boost::simd::aligned_load<vT>(b, blk::vN);
+                    for(long i = 0; i < blk::mr; ++i) {
+                        vT ai = boost::simd::splat<vT>(a[i]);
+                        acc[i][0] = acc[i][0] + ai * b0;
+                        acc[i][1] = acc[i][1] + ai * b1;
+                    }
+                }
+                alignas(PYTHRAN_ARRAY_ALIGNMENT) T tmp[blk::nr];
+                for(long i = 0; i < m; ++i) {
+                    boost::simd::aligned_store<vT>(acc[i][0], tmp, 0);
+                    boost::simd::aligned_store<vT>(acc[i][1], tmp, blk::vN);
+                    for(long j = 0; j < n; ++j)
+                        c[i * ldc + j] += tmp[j];
+                }
+            }
+#endif
+
+        // pack a[i0:i0+m, p0:p0+k] as panels of mr rows, zero-padded
+        template<class R, class T>
+            void _dot_pack_lhs(_dot_view<T> const& a, long i0, long p0, long m, long k, R* out) {
+                typedef _dot_blocking<R> blk;
+                for(long ir = 0; ir < m; ir += blk::mr)
+                    for(long p = 0; p < k; ++p)
+                        for(long i = 0; i < blk::mr; ++i)
+                            *out++ = ir + i < m ? R(a(i0 + ir + i, p0 + p)) : R();
+            }
+
+        // pack b[p0:p0+k, j0:j0+n] as panels of nr columns, zero-padded
+        template<class R, class T>
+            void _dot_pack_rhs(_dot_view<T> const& b, long p0, long j0, long k, long n, R* out) {
+                typedef _dot_blocking<R> blk;
+                for(long jr = 0; jr < n; jr += blk::nr)
+                    for(long p = 0; p < k; ++p)
+                        for(long j = 0; j < blk::nr; ++j)
+                            *out++ = jr + j < n ? R(b(p0 + p, j0 + jr + j)) : R();
+            }
+
+        // c += a.b, c being a contiguous a.shape[0] x b.shape[1] array
+        template<class R, class T, class U>
+            void _gemm(_dot_view<T> const& a, _dot_view<U> const& b, R* c) {
+                typedef _dot_blocking<R> blk;
+                long const m = a.shape[0], n = b.shape[1], k = a.shape[1];
+#ifdef _OPENMP
+                long const nthreads = omp_get_max_threads();
+#else
+                long const nthreads = 1;
+#endif
+                // one panel of b, and one panel of a per thread: nothing is allocated in the parallel region
+                R* bp = static_cast<R*>(utils::aligned_malloc(sizeof(R) * blk::kc * blk::nc));
+                if(not bp) throw std::bad_alloc();
+                R* aps = static_cast<R*>(utils::aligned_malloc(sizeof(R) * blk::mc * blk::kc * nthreads));
+                if(not aps) {
+                    free(bp);
+                    throw std::bad_alloc();
+                }
+                for(long jc = 0; jc < n; jc += blk::nc) {
+                    long const nc = std::min(blk::nc, n - jc);
+                    for(long pc = 0; pc < k; pc += blk::kc) {
+                        long const kc = std::min(blk::kc, k - pc);
+                        _dot_pack_rhs(b, pc, jc, kc, nc, bp);
+#ifdef _OPENMP
+                        #pragma omp parallel if(utils::omp_worth((m + blk::mc - 1) / blk::mc, blk::mc * kc * nc)) num_threads(nthreads)
+#endif
+                        {
+#ifdef _OPENMP
+                            R* ap = aps + omp_get_thread_num() * blk::mc * blk::kc;
+                            #pragma omp for
+#else
+                            R* ap = aps;
+#endif
+                            for(long ic = 0; ic < m; ic += blk::mc) {
+                                long const mc = std::min(blk::mc, m - ic);
+                                _dot_pack_lhs(a, ic, pc, mc, kc, ap);
+                                for(long jr = 0; jr < nc; jr += blk::nr)
+                                    for(long ir = 0; ir < mc; ir += blk::mr)
+                                        _dot_kernel(kc, ap + ir * kc, bp + jr * kc,
+                                                    c + (ic + ir) * n + jc + jr, n,
+                                                    std::min(blk::mr, mc - ir), std::min(blk::nr, nc - jr));
+                            }
+                        }
+                    }
+                }
+                free(aps);
+                free(bp);
+            }
+
+        // y += a.x, y being a contiguous array of a.shape[0] elements
+        template<class R, class T, class U>
+            void _gemv(_dot_view<T> const& a, _dot_view<U> const& x, R* y) {
+                long const m = a.shape[0], k = a.shape[1];
+                std::unique_ptr<R[]> xc(new R[k]);
+                for(long p = 0; p < k; ++p)
+                    xc[p] = x(p, 0);
+                if(a.stride[1] == 1) {
+                    // contiguous rows: one dot product per row
+#ifdef _OPENMP
+                    #pragma omp parallel for if(utils::omp_worth(m, k))
+#endif
+                    for(long i = 0; i < m; ++i) {
+                        T const* row = a.data + i * a.stride[0];
+                        R acc[4] = {};
+                        long p = 0;
+                        for(; p + 4 <= k; p += 4) {
+                            acc[0] += row[p] * xc[p];
+                            acc[1] += row[p + 1] * xc[p + 1];
+                            acc[2] += row[p + 2] * xc[p + 2];
+                            acc[3] += row[p + 3] * xc[p + 3];
+                        }
+                        for(; p < k; ++p)
+                            acc[0] += row[p] * xc[p];
+                        y[i] += (acc[0] + acc[1]) + (acc[2] + acc[3]);
+                    }
+                }
+                else {
+                    // strided rows, e.g. a transposed array: accumulate scaled columns, by blocks of rows
+                    long const block = 256;
+#ifdef _OPENMP
+                    #pragma omp parallel for if(utils::omp_worth((m + block - 1) / block, block * k))
+#endif
+                    for(long i0 = 0; i0 < m; i0 += block) {
+                        long const i1 = std::min(i0 + block, m);
+                        for(long p = 0; p < k; ++p) {
+                            R const xp = xc[p];
+                            T const* col = a.data + p * a.stride[1];
+                            for(long i = i0; i < i1; ++i)
+                                y[i] += col[i * a.stride[0]] * xp;
+                        }
+                    }
+                }
+            }
+
+        template<class E, class F>
+            typename std::enable_if<types::is_numexpr_arg<E>::value and types::is_numexpr_arg<F>::value
+                                    and types::numpy_expr_to_ndarray<E>::N == 2 and types::numpy_expr_to_ndarray<F>::N == 2,
+                                    types::ndarray<decltype(std::declval<typename types::numpy_expr_to_ndarray<E>::T>()*std::declval<typename types::numpy_expr_to_ndarray<F>::T>()), 2>
+                                   >::type
+                dot(E const& e, F const& f) {
+                    typedef decltype(std::declval<typename types::numpy_expr_to_ndarray<E>::T>()*std::declval<typename types::numpy_expr_to_ndarray<F>::T>()) R;
+                    auto const& a = _dot_operand(e);
+                    auto const& b = _dot_operand(f);
+                    auto va = _make_dot_view(a);
+                    auto vb = _make_dot_view(b);
+                    if(va.shape[1] != vb.shape[0])
+                        throw types::ValueError("matrices are not aligned");
+                    types::ndarray<R, 2> out(types::array<long, 2>{{va.shape[0], vb.shape[1]}}, R());
+                    _gemm(va, vb, out.buffer);
+                    return out;
+                }
+
+        template<class E, class F>
+            typename std::enable_if<types::is_numexpr_arg<E>::value and types::is_numexpr_arg<F>::value
+                                    and types::numpy_expr_to_ndarray<E>::N == 2 and types::numpy_expr_to_ndarray<F>::N == 1,
+                                    types::ndarray<decltype(std::declval<typename types::numpy_expr_to_ndarray<E>::T>()*std::declval<typename types::numpy_expr_to_ndarray<F>::T>()), 1>
+                                   >::type
+                dot(E const& e, F const& f) {
+                    typedef decltype(std::declval<typename types::numpy_expr_to_ndarray<E>::T>()*std::declval<typename types::numpy_expr_to_ndarray<F>::T>()) R;
+                    auto const& a = _dot_operand(e);
+                    auto const& x = _dot_operand(f);
+                    auto va = _make_dot_view(a);
+                    auto vx = _make_dot_view(x);
+                    if(va.shape[1] != vx.shape[0])
+                        throw types::ValueError("matrices are not aligned");
+                    types::ndarray<R, 1> out(types::array<long, 1>{{va.shape[0]}}, R());
+                    _gemv(va, vx, out.buffer);
+                    return out;
+                }
+
+        template<class E, class F>
+            typename std::enable_if<types::is_numexpr_arg<E>::value and types::is_numexpr_arg<F>::value
+                                    and types::numpy_expr_to_ndarray<E>::N == 1 and types::numpy_expr_to_ndarray<F>::N == 2,
+                                    types::ndarray<decltype(std::declval<typename types::numpy_expr_to_ndarray<E>::T>()*std::declval<typename types::numpy_expr_to_ndarray<F>::T>()), 1>
+                                   >::type
+                dot(E const& e, F const& f) {
+                    typedef decltype(std::declval<typename types::numpy_expr_to_ndarray<E>::T>()*std::declval<typename types::numpy_expr_to_ndarray<F>::T>()) R;
+                    auto const& x = _dot_operand(e);
+                    auto const& b = _dot_operand(f);
+                    auto vx = _make_dot_view(x);
+                    auto vb = _make_dot_view(b);
+                    if(vx.shape[0] != vb.shape[0])
+                        throw types::ValueError("matrices are not aligned");
+                    types::ndarray<R, 1> out(types::array<long, 1>{{vb.shape[1]}}, R());
+                    _gemv(vb.transposed(), vx, out.buffer);
+                    return out;
+                }
+
         template<class E, class F>
             typename std::enable_if<
             (std::is_scalar<E>::value or types::is_complex<E>::value) and (std::is_scalar<F>::value or types::is_complex<F>::value),
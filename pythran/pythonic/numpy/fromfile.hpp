@@ -0,0 +1,69 @@
+#ifndef PYTHONIC_NUMPY_FROMFILE_HPP
+#define PYTHONIC_NUMPY_FROMFILE_HPP
+
+#include "pythonic/utils/proxy.hpp"
+#include "pythonic/types/ndarray.hpp"
+#include "pythonic/types/file.hpp"
+#include "pythonic/numpy/fromstring.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <sys/stat.h>
+
+namespace pythonic {
+
+    namespace numpy {
+
+        /* Binary data from a regular file is read straight into the array
+         * buffer. Pipes and other special files have no size, their data is
+         * read by blocks until the end of file. Text data is read as a whole
+         * and parsed by fromstring.
+         */
+        template<class dtype=double>
+            types::ndarray<typename types::numpy_type<dtype>::type, 1> fromfile(types::file& f, dtype d=dtype(), long count = -1, types::str const& sep = "") {
+                typedef typename types::numpy_type<dtype>::type T;
+                if(sep)
+                    return fromstring(f.read(), d, count, sep);
+                struct stat st;
+                if(fstat(f.fileno(), &st) == 0 and S_ISREG(st.st_mode)) {
+                    long available = f.remaining() / sizeof(T);
+                    if(count < 0 or count > available)
+                        count = available;
+                    types::ndarray<T, 1> out(types::make_tuple(count), __builtin__::None);
+                    size_t read = f.read_bytes(out.buffer, count * sizeof(T)) / sizeof(T);
+                    if(long(read) < count)
+                        out.shape[0] = read;
+                    return out;
+                }
+                size_t const wanted = count < 0 ? std::string::npos : count * sizeof(T);
+                std::string content;
+                char buffer[1 << 16];
+                while(content.size() < wanted)
+                    if(size_t n = f.read_bytes(buffer, std::min(sizeof(buffer), wanted - content.size())))
+                        content.append(buffer, n);
+                    else
+                        break;
+                types::ndarray<T, 1> out(types::make_tuple(long(content.size() / sizeof(T))), __builtin__::None);
+                std::memcpy(out.buffer, content.data(), out.shape[0] * sizeof(T));
+                return out;
+            }
+
+        template<class dtype=double>
+            types::ndarray<typename types::numpy_type<dtype>::type, 1> fromfile(types::file&& f, dtype d=dtype(), long count = -1, types::str const& sep = "") {
+                return fromfile(f, d, count, sep);
+            }
+
+        template<class dtype=double>
+            types::ndarray<typename types::numpy_type<dtype>::type, 1> fromfile(types::str const& filename, dtype d=dtype(), long count = -1, types::str const& sep = "") {
+                types::file f(filename, sep ? "r" : "rb");
+                return fromfile(f, d, count, sep);
+            }
+
+        PROXY(pythonic::numpy, fromfile);
+
+    }
+
+}
+
+#endif
@@ -2,42 +2,144 @@
 #define PYTHONIC_NUMPY_FROMSTRING_HPP
 
 #include "pythonic/utils/proxy.hpp"
+#include "pythonic/utils/parse.hpp"
+#include "pythonic/utils/str_search.hpp"
 #include "pythonic/types/ndarray.hpp"
-#include "pythonic/types/list.hpp"
+#include "pythonic/types/str.hpp"
+#include "pythonic/__builtin__/ValueError.hpp"
 
+#include <algorithm>
+#include <cstring>
 #include <limits>
-#include <sstream>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#include "pythonic/utils/omp_cost.hpp"
+#endif
 
 namespace pythonic {
 
     namespace numpy {
-        template<class dtype=double>
-            types::ndarray<typename types::numpy_type<dtype>::type,1> fromstring(types::str const& string, dtype d=dtype(), long count = -1 , types::str const& sep = "") {
-                if(sep) {
-                    types::list<typename types::numpy_type<dtype>::type> res(0);
-                    if(count<0) count = std::numeric_limits<long>::max();
-                    else res.reserve(count);
-                    size_t current;
-                    size_t next = -1;
-                    long numsplit = 0;
-                    do {
-                        current = next + 1;
-                        next = string.find_first_of( sep, current );
-                        typename types::numpy_type<dtype>::type item;
-                        std::istringstream iss(string.substr( current, next - current ).get_data());
-                        iss >> item;
-                        res.push_back(item);
+
+        /* Separator of text input, as understood by numpy
+         *
+         * Whitespace in the separator matches any run of whitespace, possibly
+         * empty, so that only its other characters, the core, must be found
+         * between two items. Without core, items are separated by whitespace.
+         */
+        struct _text_separator {
+            char const* core;
+            char const* core_end;
+
+            _text_separator(char const* first, char const* last) {
+                core = utils::skip_space(first, last);
+                core_end = utils::skip_space_backward(core, last);
+            }
+
+            // start of the first separator in [first, last), last if none
+            char const* find(char const* first, char const* last) const {
+                if(core == core_end) {
+                    for(; first != last; ++first)
+                        if(utils::is_space(*first))
+                            break;
+                    return first;
+                }
+                char const* found = utils::find_substr(first, last, core, core_end - core);
+                return found ? found : last;
+            }
+
+            // end of the separator found at first
+            char const* skip(char const* first, char const* last) const {
+                return core == core_end ? utils::skip_space(first, last) : first + (core_end - core);
+            }
+        };
+
+        /* Parses at most count items of [first, last) into out
+         *
+         * Returns false if parsing stopped on something that is not a number.
+         * Trailing whitespace and separators are ignored.
+         */
+        template<class T>
+            bool _fromstring_parse(char const* first, char const* last, _text_separator const& sep, long count, std::vector<T>& out) {
+                for(first = utils::skip_space(first, last); first != last and long(out.size()) < count; ) {
+                    char const* field_end = sep.find(first, last);
+                    T item;
+                    if(not utils::parse_field(first, field_end, item))
+                        return false;
+                    out.push_back(item);
+                    if(field_end == last)
+                        break;
+                    first = utils::skip_space(sep.skip(field_end, last), last);
+                }
+                return true;
+            }
+
+        template<class T>
+            types::ndarray<T, 1> _fromstring_text(char const* first, char const* last, long count, types::str const& separator) {
+                _text_separator sep(separator.data(), separator.data() + separator.size());
+                long const limit = count < 0 ? std::numeric_limits<long>::max() : count;
+                std::vector<std::vector<T>> parts(1);
+#ifdef _OPENMP
+                /* Large inputs are cut into chunks at separator boundaries,
+                 * each chunk being parsed by a thread. As a sequential parse
+                 * would, the result stops at the first chunk that could not
+                 * be parsed up to its end.
+                 */
+                long const chunk_size = 1 << 16;
+                long const nchunks = (last - first) / chunk_size;
+                if(count < 0 and utils::omp_worth(nchunks, chunk_size)) {
+                    std::vector<char const*> bounds(1, first);
+                    for(long j = 1; j < nchunks; ++j) {
+                        char const* cut = std::max(bounds.back(), first + j * chunk_size);
+                        cut = sep.find(cut, last);
+                        bounds.push_back(cut == last ? last : sep.skip(cut, last));
                     }
-                    while (next != types::str::npos && ++numsplit<count);
-                    return types::ndarray<typename types::numpy_type<dtype>::type, 1>(res);
+                    bounds.push_back(last);
+                    parts.resize(nchunks);
+                    std::vector<char> complete(nchunks);
+                    #pragma omp parallel for schedule(dynamic)
+                    for(long j = 0; j < nchunks; ++j) {
+                        parts[j].reserve((bounds[j + 1] - bounds[j]) / 8);
+                        complete[j] = _fromstring_parse(bounds[j], bounds[j + 1], sep, limit, parts[j]);
+                    }
+                    auto stop = std::find(complete.begin(), complete.end(), false);
+                    if(stop != complete.end())
+                        parts.resize(stop - complete.begin() + 1);
                 }
+                else
+#endif
+                    _fromstring_parse(first, last, sep, limit, parts[0]);
+
+                long size = 0;
+                for(auto const& part : parts)
+                    size += part.size();
+                if(size < count)
+                    throw types::ValueError("string is smaller than requested size");
+                types::ndarray<T, 1> out(types::make_tuple(size), __builtin__::None);
+                T* iter = out.buffer;
+                for(auto const& part : parts)
+                    iter = std::copy(part.begin(), part.end(), iter);
+                return out;
+            }
+
+        template<class dtype=double>
+            types::ndarray<typename types::numpy_type<dtype>::type,1> fromstring(types::str const& string, dtype d=dtype(), long count = -1 , types::str const& sep = "") {
+                typedef typename types::numpy_type<dtype>::type T;
+                if(sep)
+                    return _fromstring_text<T>(string.data(), string.data() + string.size(), count, sep);
                 else {
-                    if(count <0) count = string.size();
-                    long shape[1] = { count };
-                    typename types::numpy_type<dtype>::type* buffer = (typename types::numpy_type<dtype>::type*)malloc(shape[0] * sizeof(typename types::numpy_type<dtype>::type));
-                    typename types::numpy_type<dtype>::type const* tstring = reinterpret_cast<typename types::numpy_type<dtype>::type const*>(string.c_str());
-                    std::copy(tstring, tstring + shape[0], buffer);
-                    return types::ndarray<typename types::numpy_type<dtype>::type,1>(buffer, shape);
+                    long const size = string.size() / sizeof(T);
+                    if(count < 0) {
+                        if(string.size() % sizeof(T))
+                            throw types::ValueError("string size must be a multiple of element size");
+                        count = size;
+                    }
+                    else if(count > size)
+                        throw types::ValueError("string is smaller than requested size");
+                    types::ndarray<T, 1> out(types::make_tuple(count), __builtin__::None);
+                    std::memcpy(out.buffer, string.data(), count * sizeof(T));
+                    return out;
                 }
             }
 
@@ -48,4 +150,3 @@ namespace pythonic {
 }
 
 #endif
-
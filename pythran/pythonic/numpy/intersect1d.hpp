@@ -2,11 +2,13 @@
 #define PYTHONIC_NUMPY_INTERSECT1D_HPP
 
 #include "pythonic/utils/proxy.hpp"
+#include "pythonic/utils/sort.hpp"
 #include "pythonic/types/ndarray.hpp"
 #include "pythonic/types/combined.hpp"
 #include "pythonic/numpy/asarray.hpp"
+#include "pythonic/numpy/unique.hpp"
 
-#include <algorithm>
+#include <vector>
 
 namespace pythonic {
 
@@ -21,22 +23,26 @@ namespace pythonic {
                 typedef typename __combined<typename types::numpy_expr_to_ndarray<E>::T,
                                             typename types::numpy_expr_to_ndarray<F>::T
                                            >::type T;
-                auto ae = asarray(e);
-                auto af = asarray(f);
-                std::set<T> sae(ae.fbegin(), ae.fend());
-                std::set<T> found;
-                types::list<T> lout(0);
-                lout.reserve(sae.size());
-                for(auto iter = af.fbegin(), end = af.fend(); iter != end; ++iter)
-                {
-                    auto curr = *iter;
-                    if(sae.find(curr) != sae.end() and found.find(curr) == found.end()) {
-                        found.insert(curr);
-                        lout.push_back(curr);
+                // merge of the sorted unique values of both arrays
+                auto ue = unique(e);
+                auto uf = unique(f);
+                auto ie = ue.buffer, ee = ue.buffer + ue.size();
+                auto if_ = uf.buffer, ef = uf.buffer + uf.size();
+                utils::sort_less<T> less;
+                std::vector<T> out;
+                while(ie != ee and if_ != ef) {
+                    T const ve = *ie, vf = *if_;
+                    if(less(ve, vf))
+                        ++ie;
+                    else if(less(vf, ve))
+                        ++if_;
+                    else {
+                        if(ve == vf) // NaN are not in the intersection
+                            out.push_back(ve);
+                        ++ie, ++if_;
                     }
                 }
-                std::sort(lout.begin(), lout.end());
-                return types::ndarray<T, 1> (lout);
+                return types::ndarray<T, 1>(out);
             }
 
         PROXY(pythonic::numpy, intersect1d);
@@ -46,4 +52,3 @@ namespace pythonic {
 }
 
 #endif
-
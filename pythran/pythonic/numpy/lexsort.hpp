@@ -2,6 +2,7 @@
 #define PYTHONIC_NUMPY_LEXSORT_HPP
 
 #include "pythonic/utils/proxy.hpp"
+#include "pythonic/utils/sort.hpp"
 #include "pythonic/types/ndarray.hpp"
 
 namespace pythonic {
@@ -12,7 +13,7 @@ namespace pythonic {
                 K const& keys;
                 lexcmp(K const& keys) : keys(keys) {
                 }
-                bool operator()(long i0, long i1) {
+                bool operator()(long i0, long i1) const {
                     for(long i= keys.size() -1; i>=0; --i)
                         if(keys[i][i0] < keys[i][i1]) return true;
                         else if(keys[i][i0] > keys[i][i1]) return false;
@@ -26,8 +27,8 @@ namespace pythonic {
                 types::ndarray<long, 1> out(types::make_tuple(n), __builtin__::None);
                 // fill with the original indices
                 std::iota(out.buffer, out.buffer + n, 0L);
-                // then sort using keys as the comparator
-                std::sort(out.buffer, out.buffer +n, lexcmp<types::array<T, N>>(keys));
+                // then sort using keys as the comparator, ties keep their order
+                utils::stable_sort(out.buffer, out.buffer +n, lexcmp<types::array<T, N>>(keys));
                 return out;
             }
         PROXY(pythonic::numpy, lexsort)
@@ -0,0 +1,266 @@
+#ifndef PYTHONIC_NUMPY_LOADTXT_HPP
+#define PYTHONIC_NUMPY_LOADTXT_HPP
+
+#include "pythonic/utils/proxy.hpp"
+#include "pythonic/utils/parse.hpp"
+#include "pythonic/utils/str_search.hpp"
+#include "pythonic/types/ndarray.hpp"
+#include "pythonic/types/numpy_type.hpp"
+#include "pythonic/types/file.hpp"
+#include "pythonic/types/none.hpp"
+#include "pythonic/types/str.hpp"
+#include "pythonic/__builtin__/None.hpp"
+#include "pythonic/__builtin__/ValueError.hpp"
+
+#include <algorithm>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#include "pythonic/utils/omp_cost.hpp"
+#endif
+
+namespace pythonic {
+
+    namespace numpy {
+
+        /* Text of a file from its current position, which is moved to the end
+         *
+         * Regular files are mapped rather than read, so that their content is
+         * not copied: pages are loaded as they are parsed. Pipes and other
+         * special files have no size, they are read into a string.
+         */
+        class _loadtxt_text {
+            void* mapping;
+            size_t length;
+            std::string content;
+
+            public:
+            char const* first, *last;
+
+            _loadtxt_text(types::file& f) : mapping(MAP_FAILED), length(0) {
+                struct stat st;
+                if(fstat(f.fileno(), &st) == 0 and S_ISREG(st.st_mode) and f.remaining()) {
+                    off_t offset = st.st_size - f.remaining();
+                    // the mapping starts on a page boundary
+                    off_t start = offset - offset % sysconf(_SC_PAGE_SIZE);
+                    length = st.st_size - start;
+                    mapping = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, f.fileno(), start);
+                    if(mapping != MAP_FAILED) {
+                        first = static_cast<char const*>(mapping) + (offset - start);
+                        last = static_cast<char const*>(mapping) + length;
+                        f.seek(0, SEEK_END);
+                        return;
+                    }
+                }
+                char buffer[1 << 16];
+                while(size_t n = f.read_bytes(buffer, sizeof(buffer)))
+                    content.append(buffer, n);
+                first = content.data();
+                last = first + content.size();
+            }
+            _loadtxt_text(types::file&& f) : _loadtxt_text(f) {}
+            _loadtxt_text(types::str const& filename) : _loadtxt_text(types::file(filename, "rb")) {}
+            _loadtxt_text(_loadtxt_text const&) = delete;
+            ~_loadtxt_text() {
+                if(mapping != MAP_FAILED)
+                    munmap(mapping, length);
+            }
+        };
+
+        inline types::str _loadtxt_option(types::str const& s) { return s; }
+        inline types::str _loadtxt_option(types::none_type) { return ""; }
+
+        inline std::vector<long> _loadtxt_columns(types::none_type) { return {}; }
+        inline std::vector<long> _loadtxt_columns(long column) { return {column}; }
+        template<class Iterable>
+            std::vector<long> _loadtxt_columns(Iterable const& columns) {
+                return std::vector<long>(columns.begin(), columns.end());
+            }
+
+        /* Splits a line into fields, the line being stripped of its comment
+         *
+         * An empty delimiter stands for runs of whitespace. Fields are
+         * appended to bounds as (begin, end) pairs, and are not stripped.
+         */
+        struct _loadtxt_splitter {
+            types::str delimiter;
+
+            template<class Bounds>
+                void operator()(char const* first, char const* last, Bounds& bounds) const {
+                    if(delimiter.empty()) {
+                        for(first = utils::skip_space(first, last); first != last; first = utils::skip_space(first, last)) {
+                            char const* end = first;
+                            while(end != last and not utils::is_space(*end))
+                                ++end;
+                            bounds.emplace_back(first, end);
+                            first = end;
+                        }
+                    }
+                    else {
+                        while(true) {
+                            char const* end = utils::find_substr(first, last, delimiter.data(), delimiter.size());
+                            if(not end) {
+                                bounds.emplace_back(first, last);
+                                break;
+                            }
+                            bounds.emplace_back(first, end);
+                            first = end + delimiter.size();
+                        }
+                    }
+                }
+        };
+
+        // numpy converts integer fields through float
+        template<class T>
+            typename std::enable_if<std::is_integral<T>::value, bool>::type _loadtxt_convert(char const* first, char const* last, T& out) {
+                double value;
+                if(utils::parse_field(first, last, out))
+                    return true;
+                if(not utils::parse_field(first, last, value))
+                    return false;
+                out = static_cast<T>(static_cast<long long>(value));
+                return true;
+            }
+        template<class T>
+            typename std::enable_if<not std::is_integral<T>::value, bool>::type _loadtxt_convert(char const* first, char const* last, T& out) {
+                return utils::parse_field(first, last, out);
+            }
+
+        /* Parses a data line into out, or returns an error message
+         *
+         * columns maps output columns to fields, ncols is the expected number
+         * of fields.
+         */
+        template<class T>
+            char const* _loadtxt_row(char const* first, char const* last, _loadtxt_splitter const& split,
+                                     std::vector<long> const& columns, long ncols,
+                                     std::vector<std::pair<char const*, char const*>>& fields, T* out) {
+                fields.clear();
+                split(first, last, fields);
+                if(long(fields.size()) != ncols)
+                    return "Wrong number of columns";
+                for(size_t j = 0; j < columns.size(); ++j) {
+                    auto const& field = fields[columns[j]];
+                    if(not _loadtxt_convert(field.first, field.second, out[j]))
+                        return "could not convert string to number";
+                }
+                return nullptr;
+            }
+
+        /* Parses a text table, one row per data line
+         *
+         * Lines are first located, so that the output is allocated once and
+         * rows can be parsed in parallel. Comments and blank lines are
+         * skipped, after the first skiprows lines.
+         */
+        template<class T>
+            types::ndarray<T, 2> _loadtxt(char const* first, char const* last, types::str const& comments, types::str const& delimiter,
+                                          long skiprows, std::vector<long> columns, bool unpack, long ndmin) {
+                std::vector<std::pair<char const*, char const*>> lines;
+                std::vector<long> numbers;
+                for(long number = 1; first != last; ++number) {
+                    char const* eol = utils::find_char(first, last, '\n');
+                    char const* end = eol ? eol : last;
+                    if(number > skiprows) {
+                        if(not comments.empty())
+                            if(char const* comment = utils::find_substr(first, end, comments.data(), comments.size()))
+                                end = comment;
+                        end = utils::skip_space_backward(first, end);
+                        if(utils::skip_space(first, end) != end) {
+                            lines.emplace_back(first, end);
+                            numbers.push_back(number);
+                        }
+                    }
+                    first = eol ? eol + 1 : last;
+                }
+
+                _loadtxt_splitter split{delimiter};
+                std::vector<std::pair<char const*, char const*>> fields;
+                long ncols = 0;
+                if(not lines.empty()) {
+                    split(lines[0].first, lines[0].second, fields);
+                    ncols = fields.size();
+                }
+                if(columns.empty()) {
+                    columns.resize(ncols);
+                    for(long j = 0; j < ncols; ++j)
+                        columns[j] = j;
+                }
+                for(long& column : columns) {
+                    if(column < 0)
+                        column += ncols;
+                    if(not lines.empty() and (column < 0 or column >= ncols))
+                        throw types::ValueError("usecols out of range");
+                }
+
+                long const nrows = lines.size(), nout = columns.size();
+                types::ndarray<T, 2> out(types::make_tuple(nrows, nout), __builtin__::None);
+                // first line in error, if any
+                long error = nrows;
+#ifdef _OPENMP
+                #pragma omp parallel if(utils::omp_worth(nrows, 32 * ncols))
+#endif
+                {
+                    std::vector<std::pair<char const*, char const*>> fields;
+#ifdef _OPENMP
+                    #pragma omp for schedule(static)
+#endif
+                    for(long i = 0; i < nrows; ++i)
+                        if(_loadtxt_row(lines[i].first, lines[i].second, split, columns, ncols, fields, out.buffer + i * nout)) {
+#ifdef _OPENMP
+                            #pragma omp critical
+#endif
+                            error = std::min(error, i);
+                        }
+                }
+                if(error < nrows) {
+                    char const* message = _loadtxt_row(lines[error].first, lines[error].second, split, columns, ncols, fields, out.buffer + error * nout);
+                    throw types::ValueError(std::string(message) + " at line " + std::to_string(numbers[error]) +
+                                            ": " + std::string(lines[error].first, lines[error].second));
+                }
+
+                // numpy would squeeze the result
+                if(ndmin < 2 and (nrows < 2 or nout < 2))
+                    throw types::ValueError("loadtxt only returns 2-D arrays, pass ndmin=2 to load a single row or column");
+
+                if(unpack) {
+                    types::ndarray<T, 2> transposed(types::make_tuple(nout, nrows), __builtin__::None);
+                    for(long i = 0; i < nrows; ++i)
+                        for(long j = 0; j < nout; ++j)
+                            transposed.buffer[j * nrows + i] = out.buffer[i * nout + j];
+                    return transposed;
+                }
+                return out;
+            }
+
+        /* The result always has two dimensions, because the number of
+         * dimensions must be known at compile time: a single row or column,
+         * that numpy would squeeze, is only loaded with ndmin=2. Converters
+         * are not supported.
+         */
+        template<class F, class dtype=double, class C=types::str, class D=types::none_type, class U=types::none_type>
+            types::ndarray<typename types::numpy_type<dtype>::type, 2>
+            loadtxt(F&& fname, dtype d=dtype(), C const& comments="#", D const& delimiter=__builtin__::None,
+                    types::none_type converters=__builtin__::None, long skiprows=0, U const& usecols=__builtin__::None,
+                    bool unpack=false, long ndmin=0) {
+                if(ndmin < 0 or ndmin > 2)
+                    throw types::ValueError("Illegal value of ndmin keyword: " + std::to_string(ndmin));
+                _loadtxt_text text(std::forward<F>(fname));
+                return _loadtxt<typename types::numpy_type<dtype>::type>(text.first, text.last,
+                                                                         _loadtxt_option(comments), _loadtxt_option(delimiter),
+                                                                         skiprows, _loadtxt_columns(usecols), unpack, ndmin);
+            }
+
+        PROXY(pythonic::numpy, loadtxt);
+
+    }
+
+}
+
+#endif
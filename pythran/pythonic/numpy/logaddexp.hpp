@@ -3,16 +3,28 @@
 
 #include "pythonic/utils/proxy.hpp"
 #include "pythonic/types/ndarray.hpp"
-#include <nt2/include/functions/log.hpp>
+#include <nt2/include/functions/log1p.hpp>
 #include <nt2/include/functions/exp.hpp>
+#include <nt2/include/functions/abs.hpp>
+#include <nt2/include/functions/max.hpp>
+#include <nt2/include/functions/if_else.hpp>
+#include <nt2/include/functions/is_equal.hpp>
+#include <nt2/include/constants/zero.hpp>
 
 namespace pythonic {
 
     namespace numpy {
         namespace wrapper {
+        /* log(exp(t0) + exp(t1)) computed as max(t0, t1) + log1p(exp(-|t0 - t1|))
+         * so that it does not overflow, written with functions that also accept
+         * vector arguments. Equal arguments are special-cased for infinities.
+         */
         template<class T0, class T1>
-            auto logaddexp(T0 const& t0, T1 const& t1) -> decltype(nt2::log(nt2::exp(t0) + nt2::exp(t1))) {
-                return nt2::log(nt2::exp(t0) + nt2::exp(t1));
+            auto logaddexp(T0 const& t0, T1 const& t1) -> decltype(nt2::exp(t0) + nt2::exp(t1)) {
+                typedef decltype(nt2::exp(t0) + nt2::exp(t1)) T;
+                T const a = t0, b = t1;
+                T const d = nt2::if_else(nt2::is_equal(a, b), nt2::Zero<T>(), a - b);
+                return nt2::max(a, b) + nt2::log1p(nt2::exp(-nt2::abs(d)));
             }
 
         }
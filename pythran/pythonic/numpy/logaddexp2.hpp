@@ -5,14 +5,24 @@
 #include "pythonic/types/ndarray.hpp"
 
 #include <nt2/include/functions/log2.hpp>
-#include <nt2/include/functions/pow.hpp>
+#include <nt2/include/functions/exp2.hpp>
+#include <nt2/include/functions/abs.hpp>
+#include <nt2/include/functions/max.hpp>
+#include <nt2/include/functions/if_else.hpp>
+#include <nt2/include/functions/is_equal.hpp>
+#include <nt2/include/constants/zero.hpp>
+#include <nt2/include/constants/one.hpp>
 namespace pythonic {
 
     namespace numpy {
         namespace wrapper {
+        // same as logaddexp, in base 2
         template<class T0, class T1>
-            auto logaddexp2(T0 const& t0, T1 const& t1) -> decltype(nt2::log2(nt2::pow(T0(2),t0) + nt2::pow(T1(2),t1))) {
-                return nt2::log2(nt2::pow(T0(2),t0) + nt2::pow(T1(2),t1));
+            auto logaddexp2(T0 const& t0, T1 const& t1) -> decltype(nt2::exp2(t0) + nt2::exp2(t1)) {
+                typedef decltype(nt2::exp2(t0) + nt2::exp2(t1)) T;
+                T const a = t0, b = t1;
+                T const d = nt2::if_else(nt2::is_equal(a, b), nt2::Zero<T>(), a - b);
+                return nt2::max(a, b) + nt2::log2(nt2::One<T>() + nt2::exp2(-nt2::abs(d)));
             }
         }
 #define NUMPY_BINARY_FUNC_NAME logaddexp2
@@ -0,0 +1,16 @@
+#ifndef PYTHONIC_NUMPY_MATMUL_HPP
+#define PYTHONIC_NUMPY_MATMUL_HPP
+
+#include "pythonic/numpy/dot.hpp"
+
+namespace pythonic {
+
+    namespace numpy {
+
+        FPROXY(pythonic::numpy, matmul, dot);
+
+    }
+
+}
+
+#endif
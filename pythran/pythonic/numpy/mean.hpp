@@ -2,12 +2,16 @@
 #define PYTHONIC_NUMPY_MEAN_HPP
 
 #include "pythonic/numpy/sum.hpp"
+#include "pythonic/numpy/reduce.hpp"
 #include "pythonic/types/numpy_type.hpp"
 #include "pythonic/__builtin__/None.hpp"
 
 namespace pythonic {
 
     namespace numpy {
+        template<class E, class dtype>
+            using mean_type = decltype(std::declval<sum_type<E>>() / std::declval<typename types::numpy_type<dtype>::type>());
+
         template<class E, class dtype=double>
             auto
             mean(E const& expr, types::none_type axis=__builtin__::None, dtype d=dtype())
@@ -17,11 +21,22 @@ namespace pythonic {
             }
 
         template<class E, class dtype=double>
-            auto
+            typename std::enable_if<E::value == 1, mean_type<E, dtype>>::type
+            mean(E const& expr, long axis, dtype d=dtype())
+            {
+                if(axis != 0)
+                    throw types::ValueError("axis out of bounds");
+                return mean(expr, __builtin__::None, d);
+            }
+
+        // the sum is accumulated in the result type, and the expression is never evaluated
+        template<class E, class dtype=double>
+            typename std::enable_if<E::value != 1, types::ndarray<mean_type<E, dtype>, E::value - 1>>::type
             mean(E const& expr, long axis, dtype d=dtype())
-            -> decltype(sum(expr, axis))
             {
-                return sum(expr, axis) /= typename types::numpy_type<dtype>::type(expr.shape[axis]);
+                auto out = reduce<proxy::add, mean_type<E, dtype>>(expr, axis);
+                out /= typename types::numpy_type<dtype>::type(expr.shape[axis]);
+                return out;
             }
 
         PROXY(pythonic::numpy, mean);
@@ -31,4 +46,3 @@ namespace pythonic {
 }
 
 #endif
-
@@ -2,28 +2,31 @@
 #define PYTHONIC_NUMPY_MEDIAN_HPP
 
 #include "pythonic/utils/proxy.hpp"
+#include "pythonic/utils/numpy_conversion.hpp"
 #include "pythonic/types/ndarray.hpp"
-#include <algorithm>
+#include "pythonic/numpy/percentile.hpp"
+#include "pythonic/__builtin__/None.hpp"
 
 namespace pythonic {
 
     namespace numpy {
         template<class T, size_t N>
-            decltype(std::declval<T>()+1.) median(types::ndarray<T,N> const& arr) {
-                size_t n = arr.size();
-                T* tmp = new T[n];
-                std::copy(arr.buffer, arr.buffer + n, tmp);
-                std::sort(tmp, tmp + n);
-                auto out = (tmp[n/2]+tmp[(n-1)/2])/double(2);
-                delete [] tmp;
-                return out;
+            quantile_type<T> median(types::ndarray<T,N> const& arr, types::none_type=__builtin__::None) {
+                return _quantile(arr, .5);
             }
 
-        PROXY(pythonic::numpy, median);
+        template<class T, size_t N>
+            auto median(types::ndarray<T,N> const& arr, long axis)
+            -> decltype(_quantile(arr, axis, .5))
+            {
+                return _quantile(arr, axis, .5);
+            }
+
+        NUMPY_EXPR_TO_NDARRAY0(median)
+            PROXY(pythonic::numpy, median);
 
     }
 
 }
 
 #endif
-
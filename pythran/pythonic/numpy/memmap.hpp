@@ -0,0 +1,109 @@
+#ifndef PYTHONIC_NUMPY_MEMMAP_HPP
+#define PYTHONIC_NUMPY_MEMMAP_HPP
+
+#include "pythonic/utils/proxy.hpp"
+#include "pythonic/types/ndarray.hpp"
+#include "pythonic/types/numpy_type.hpp"
+#include "pythonic/types/str.hpp"
+#include "pythonic/__builtin__/IOError.hpp"
+#include "pythonic/__builtin__/ValueError.hpp"
+#include "pythonic/__builtin__/None.hpp"
+#include "pythonic/types/none.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <functional>
+#include <numeric>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace pythonic {
+
+    namespace numpy {
+
+        /* An ndarray over the pages of a file, without copy
+         *
+         * Pages are loaded on first access, and the mapping lives as long as
+         * the array or one of its views. In mode 'r+', writes to the array go
+         * to the file. In modes 'r' and 'c', they stay private to the process:
+         * pythran arrays cannot be made read-only, so a copy-on-write mapping
+         * is used in both cases. The file must already hold the data.
+         */
+        template<class T, size_t N>
+            types::ndarray<T, N> _memmap(types::str const& filename, types::str const& mode, long offset, types::array<long, N> shape) {
+                bool shared;
+                if(mode == "r+" or mode == "readwrite")
+                    shared = true;
+                else if(mode == "r" or mode == "readonly" or mode == "c" or mode == "copyonwrite")
+                    shared = false;
+                else
+                    throw types::ValueError("mode must be one of 'r', 'c' or 'r+'");
+                if(offset < 0)
+                    throw types::ValueError("negative offset");
+
+                int fd = open(filename.c_str(), shared ? O_RDWR : O_RDONLY);
+                if(fd == -1)
+                    throw types::IOError("Couldn't open file " + filename);
+                struct stat st;
+                if(fstat(fd, &st) == -1) {
+                    close(fd);
+                    throw types::IOError(strerror(errno));
+                }
+                // a negative first dimension is deduced from the file size
+                if(shape[0] < 0) {
+                    long row = std::accumulate(shape.begin() + 1, shape.end(), long(sizeof(T)), std::multiplies<long>());
+                    shape[0] = std::max(0L, long(st.st_size) - offset) / row;
+                }
+                size_t nbytes = std::accumulate(shape.begin(), shape.end(), sizeof(T), std::multiplies<size_t>());
+                if(nbytes == 0) {
+                    close(fd);
+                    throw types::ValueError("cannot mmap an empty file");
+                }
+                if(offset + nbytes > size_t(st.st_size)) {
+                    close(fd);
+                    throw types::ValueError("mmap length is greater than file size");
+                }
+                // the mapping starts on a page boundary
+                long start = offset - offset % sysconf(_SC_PAGE_SIZE);
+                size_t length = nbytes + (offset - start);
+                void* mapping = mmap(nullptr, length, PROT_READ | PROT_WRITE, shared ? MAP_SHARED : MAP_PRIVATE, fd, start);
+                close(fd);
+                if(mapping == MAP_FAILED)
+                    throw types::IOError(strerror(errno));
+                T* data = reinterpret_cast<T*>(static_cast<char*>(mapping) + (offset - start));
+                return types::ndarray<T, N>(utils::shared_ref<types::raw_array<T>>(data, mapping, length), shape);
+            }
+
+        // bytes unless told otherwise
+        template<class dtype>
+            struct _memmap_type : types::numpy_type<dtype> {};
+        template<>
+            struct _memmap_type<types::none_type> {
+                typedef unsigned char type;
+            };
+
+        template<class dtype, size_t N>
+            types::ndarray<typename _memmap_type<dtype>::type, N> memmap(types::str const& filename, dtype d, types::str const& mode, long offset, types::array<long, N> const& shape) {
+                return _memmap<typename _memmap_type<dtype>::type>(filename, mode, offset, shape);
+            }
+
+        template<class dtype>
+            types::ndarray<typename _memmap_type<dtype>::type, 1> memmap(types::str const& filename, dtype d, types::str const& mode, long offset, long size) {
+                return memmap(filename, d, mode, offset, types::make_tuple(size));
+            }
+
+        template<class dtype=types::none_type>
+            types::ndarray<typename _memmap_type<dtype>::type, 1> memmap(types::str const& filename, dtype d=dtype(), types::str const& mode="r+", long offset=0, types::none_type shape=__builtin__::None) {
+                return memmap(filename, d, mode, offset, -1L);
+            }
+
+        PROXY(pythonic::numpy, memmap);
+
+    }
+
+}
+
+#endif
@@ -0,0 +1,78 @@
+#ifndef PYTHONIC_NUMPY_PARTITION_HPP
+#define PYTHONIC_NUMPY_PARTITION_HPP
+
+#include "pythonic/utils/proxy.hpp"
+#include "pythonic/utils/numpy_conversion.hpp"
+#include "pythonic/utils/sort.hpp"
+#include "pythonic/types/ndarray.hpp"
+#include "pythonic/numpy/sort.hpp"
+
+#include <algorithm>
+#include <vector>
+
+namespace pythonic {
+
+    namespace numpy {
+        template<class K>
+            typename std::enable_if<std::is_integral<K>::value>::type
+            _push_kth(std::vector<long>& out, K kth)
+            {
+                out.push_back(kth);
+            }
+
+        template<class K>
+            typename std::enable_if<not std::is_integral<K>::value>::type
+            _push_kth(std::vector<long>& out, K const& kth)
+            {
+                out.insert(out.end(), kth.begin(), kth.end());
+            }
+
+        /* positions from kth in lanes of n elements, sorted */
+        template<class K>
+            std::vector<long> _kth_positions(K const& kth, long n)
+            {
+                std::vector<long> out;
+                _push_kth(out, kth);
+                for(long& k : out) {
+                    if(k < 0)
+                        k += n;
+                    if(k < 0 or k >= n)
+                        throw types::ValueError("kth out of bounds");
+                }
+                std::sort(out.begin(), out.end());
+                return out;
+            }
+
+        template<class T, size_t N, class K>
+            types::ndarray<T,N> partition(types::ndarray<T,N> const& a, K const& kth, long axis=-1)
+            {
+                while(axis<0)
+                    axis += N;
+                axis = axis%N;
+                std::vector<long> const positions = _kth_positions(kth, a.shape[axis]);
+                types::ndarray<T,N> out(a.shape, __builtin__::None);
+                std::copy(a.buffer, a.buffer + a.size(), out.buffer);
+                T* data = out.buffer;
+                _foreach_lane<T>(out.shape, axis,
+                        [data, &positions](long, long offset, long n, long stride, T* buffer) {
+                            if(stride == 1)
+                                utils::multi_select(data + offset, data + offset + n, positions.begin(), positions.end(), utils::sort_less<T>());
+                            else {
+                                for(long i = 0; i < n; ++i)
+                                    buffer[i] = data[offset + i * stride];
+                                utils::multi_select(buffer, buffer + n, positions.begin(), positions.end(), utils::sort_less<T>());
+                                for(long i = 0; i < n; ++i)
+                                    data[offset + i * stride] = buffer[i];
+                            }
+                        });
+                return out;
+            }
+
+        NUMPY_EXPR_TO_NDARRAY0(partition)
+            PROXY(pythonic::numpy, partition);
+
+    }
+
+}
+
+#endif
@@ -0,0 +1,108 @@
+#ifndef PYTHONIC_NUMPY_PERCENTILE_HPP
+#define PYTHONIC_NUMPY_PERCENTILE_HPP
+
+#include "pythonic/utils/proxy.hpp"
+#include "pythonic/utils/numpy_conversion.hpp"
+#include "pythonic/utils/sort.hpp"
+#include "pythonic/types/ndarray.hpp"
+#include "pythonic/numpy/sort.hpp"
+#include "pythonic/__builtin__/None.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+namespace pythonic {
+
+    namespace numpy {
+        template<class T>
+            using quantile_type = decltype(std::declval<T>() + 1.);
+
+        /* q-th quantile of the n values of lane, q being in [0, 1], linearly
+         * interpolated between the two closest ranks, as numpy does. It is NaN
+         * if one of the values is NaN. The lane is reordered */
+        template<class T>
+            quantile_type<T> _quantile(T* lane, long n, double q)
+            {
+                std::is_floating_point<T> floating;
+                if(n == 0 or (floating and std::any_of(lane, lane + n, [floating](T v) { return utils::is_nan(v, floating); })))
+                    return std::numeric_limits<quantile_type<T>>::quiet_NaN();
+                double const index = q * (n - 1);
+                long const below = index;
+                double const weight = index - below;
+                utils::select(lane, lane + below, lane + n);
+                quantile_type<T> out = lane[below];
+                if(weight > 0) // the next rank is the smallest value after below
+                    out = out * (1 - weight) + *std::min_element(lane + below + 1, lane + n) * weight;
+                return out;
+            }
+
+        template<class T, size_t N>
+            quantile_type<T> _quantile(types::ndarray<T,N> const& a, double q)
+            {
+                std::vector<T> lane(a.buffer, a.buffer + a.size());
+                return _quantile(lane.data(), lane.size(), q);
+            }
+
+        template<class T>
+            quantile_type<T> _quantile(types::ndarray<T,1> const& a, long axis, double q)
+            {
+                if(axis != 0 and axis != -1)
+                    throw types::ValueError("axis out of bounds");
+                return _quantile(a, q);
+            }
+
+        // each lane is copied to a per-thread scratch buffer, then selected in place
+        template<class T, size_t N>
+            typename std::enable_if<N != 1, types::ndarray<quantile_type<T>, N - 1>>::type
+            _quantile(types::ndarray<T,N> const& a, long axis, double q)
+            {
+                if(axis < 0)
+                    axis += N;
+                if(axis < 0 || axis >= long(N))
+                    throw types::ValueError("axis out of bounds");
+                types::array<long, N - 1> shape;
+                auto next = std::copy(a.shape.begin(), a.shape.begin() + axis, shape.begin());
+                std::copy(a.shape.begin() + axis + 1, a.shape.end(), next);
+                types::ndarray<quantile_type<T>, N - 1> out(shape, __builtin__::None);
+                if(a.shape[axis] == 0)
+                    std::fill(out.buffer, out.buffer + out.size(), std::numeric_limits<quantile_type<T>>::quiet_NaN());
+                T const* values = a.buffer;
+                quantile_type<T>* data = out.buffer;
+                _foreach_lane<T>(a.shape, axis,
+                        [values, data, q](long lane, long offset, long n, long stride, T* buffer) {
+                            for(long i = 0; i < n; ++i)
+                                buffer[i] = values[offset + i * stride];
+                            data[lane] = _quantile(buffer, n, q);
+                        }, true);
+                return out;
+            }
+
+        inline double _percentile_q(double q)
+        {
+            if(q < 0 or q > 100)
+                throw types::ValueError("Percentiles must be in the range [0,100]");
+            return q / 100;
+        }
+
+        template<class T, size_t N>
+            quantile_type<T> percentile(types::ndarray<T,N> const& a, double q, types::none_type=__builtin__::None)
+            {
+                return _quantile(a, _percentile_q(q));
+            }
+
+        template<class T, size_t N>
+            auto percentile(types::ndarray<T,N> const& a, double q, long axis)
+            -> decltype(_quantile(a, axis, q))
+            {
+                return _quantile(a, axis, _percentile_q(q));
+            }
+
+        NUMPY_EXPR_TO_NDARRAY0(percentile)
+            PROXY(pythonic::numpy, percentile);
+
+    }
+
+}
+
+#endif
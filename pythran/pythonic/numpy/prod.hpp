@@ -6,6 +6,7 @@
 #include "pythonic/__builtin__/None.hpp"
 #include "pythonic/__builtin__/ValueError.hpp"
 #include "pythonic/numpy/multiply.hpp"
+#include "pythonic/numpy/reduce.hpp"
 
 #include <algorithm>
 
@@ -25,7 +26,14 @@ namespace pythonic {
             }
 
         template<class E>
-            typename types::numpy_expr_to_ndarray<E>::T
+            typename std::enable_if<types::is_array<E>::value, typename E::dtype>::type
+            prod(E const& expr, types::none_type _ = types::none_type()) {
+                return reduce<proxy::multiply>(expr, typename E::dtype(1));
+            }
+
+        // lists of lists go through their iterators
+        template<class E>
+            typename std::enable_if<not types::is_array<E>::value, typename types::numpy_expr_to_ndarray<E>::T>::type
             prod(E const& expr, types::none_type _ = types::none_type()) {
                 typename types::numpy_expr_to_ndarray<E>::T p = 1;
                 _prod(expr.begin(), expr.end(), p, utils::int_<types::numpy_expr_to_ndarray<E>::N>());
@@ -45,25 +53,7 @@ namespace pythonic {
             typename std::enable_if<E::value != 1, types::ndarray<typename E::dtype, E::value - 1>>::type
             prod(E const& array, long axis)
             {
-                if(axis<0 || axis >= E::value)
-                    throw types::ValueError("axis out of bounds");
-                auto shape = array.shape;
-                if(axis==0)
-                {
-                    types::array<long, E::value - 1> shp;
-                    std::copy(shape.begin() + 1, shape.end(), shp.begin());
-                    types::ndarray<typename E::dtype, E::value - 1> out(shp, 1);
-                    return std::accumulate(array.begin(), array.end(), out, proxy::multiply());
-                }
-                else
-                {
-                    types::array<long, E::value-1> shp;
-                    auto next = std::copy(shape.begin(), shape.begin() + axis, shp.begin());
-                    std::copy(shape.begin() + axis + 1, shape.end(), next);
-                    types::ndarray<typename E::dtype, E::value-1> prody(shp, __builtin__::None);
-                    std::transform(array.begin(), array.end(), prody.begin(), [axis](decltype((*array.begin())) other) { return prod(other, axis - 1); });
-                    return prody;
-                }
+                return reduce<proxy::multiply, typename E::dtype>(array, axis);
             }
 
         PROXY(pythonic::numpy, prod);
@@ -73,4 +63,3 @@ namespace pythonic {
 }
 
 #endif
-
@@ -0,0 +1,39 @@
+#ifndef PYTHONIC_NUMPY_QUANTILE_HPP
+#define PYTHONIC_NUMPY_QUANTILE_HPP
+
+#include "pythonic/utils/proxy.hpp"
+#include "pythonic/utils/numpy_conversion.hpp"
+#include "pythonic/types/ndarray.hpp"
+#include "pythonic/numpy/percentile.hpp"
+
+namespace pythonic {
+
+    namespace numpy {
+        inline double _quantile_q(double q)
+        {
+            if(q < 0 or q > 1)
+                throw types::ValueError("Quantiles must be in the range [0, 1]");
+            return q;
+        }
+
+        template<class T, size_t N>
+            quantile_type<T> quantile(types::ndarray<T,N> const& a, double q, types::none_type=__builtin__::None)
+            {
+                return _quantile(a, _quantile_q(q));
+            }
+
+        template<class T, size_t N>
+            auto quantile(types::ndarray<T,N> const& a, double q, long axis)
+            -> decltype(_quantile(a, axis, q))
+            {
+                return _quantile(a, axis, _quantile_q(q));
+            }
+
+        NUMPY_EXPR_TO_NDARRAY0(quantile)
+            PROXY(pythonic::numpy, quantile);
+
+    }
+
+}
+
+#endif
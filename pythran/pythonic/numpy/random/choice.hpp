@@ -0,0 +1,176 @@
+#ifndef PYTHONIC_NUMPY_RANDOM_CHOICE_HPP
+#define PYTHONIC_NUMPY_RANDOM_CHOICE_HPP
+
+#include "pythonic/utils/proxy.hpp"
+#include "pythonic/numpy/asarray.hpp"
+#include "pythonic/numpy/random/randint.hpp"
+#include "pythonic/__builtin__/ValueError.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <vector>
+
+namespace pythonic {
+
+    namespace numpy {
+
+        namespace random {
+
+            // k indices drawn from [0, n), uniformly
+            inline void _choice_indices(long* out, long k, long n, bool replace, types::none_type) {
+                if(replace) {
+                    utils::random_fill(out, k, 2, [n](utils::philox4x32& engine, long* first, long* last) {
+                            _randint_chunk(engine, first, last, 0, n);
+                            });
+                    return;
+                }
+                if(k > n)
+                    throw types::ValueError("Cannot take a larger sample than population when 'replace=False'");
+                // partial Fisher-Yates: only the first k draws are needed
+                std::vector<long> indices(n);
+                std::iota(indices.begin(), indices.end(), 0L);
+                utils::philox4x32& engine = utils::random_engine();
+                for(long i = 0; i < k; ++i) {
+                    std::swap(indices[i], indices[i + engine.below(n - i)]);
+                    out[i] = indices[i];
+                }
+            }
+
+            // k indices drawn from [0, n), with probabilities p
+            template<class P>
+                void _choice_indices(long* out, long k, long n, bool replace, P const& p) {
+                    auto weights = numpy::asarray(p);
+                    if(long(weights.size()) != n)
+                        throw types::ValueError("a and p must have same size");
+                    std::vector<double> cdf(n);
+                    double total = 0.;
+                    for(long i = 0; i < n; ++i) {
+                        if(weights.buffer[i] < 0)
+                            throw types::ValueError("probabilities are not non-negative");
+                        cdf[i] = total += weights.buffer[i];
+                    }
+                    if(std::abs(total - 1.) > 1e-8)
+                        throw types::ValueError("probabilities do not sum to 1");
+                    if(replace) {
+                        // inversion: the first item whose cumulated probability exceeds U[0, total)
+                        double const* c = cdf.data();
+                        utils::random_fill(out, k, 20, [c, n, total](utils::philox4x32& engine, long* first, long* last) {
+                                double u[utils::random_chunk];
+                                long size = last - first;
+                                _uniform_chunk(engine, u, u + size, 0., total);
+                                for(long i = 0; i < size; ++i)
+                                    first[i] = std::min(n - 1, long(std::upper_bound(c, c + n, u[i]) - c));
+                                });
+                        return;
+                    }
+                    // Efraimidis-Spirakis: the k largest log(U) / p_i
+                    std::vector<std::pair<double, long>> keys;
+                    keys.reserve(n);
+                    utils::philox4x32& engine = utils::random_engine();
+                    for(long i = 0; i < n; ++i)
+                        if(double w = weights.buffer[i])
+                            keys.emplace_back(std::log(1. - engine.uniform()) / w, i);
+                    if(k > long(keys.size()))
+                        throw types::ValueError("Fewer non-zero entries in p than size");
+                    std::partial_sort(keys.begin(), keys.begin() + k, keys.end(),
+                                      [](std::pair<double, long> const& x, std::pair<double, long> const& y) { return x.first > y.first; });
+                    for(long i = 0; i < k; ++i)
+                        out[i] = keys[i].second;
+                }
+
+            // choice from an integer n draws from arange(n)
+            long _choice_population(long a) {
+                return a;
+            }
+
+            template<class E>
+                auto _choice_population(E const& a) -> decltype(numpy::asarray(a)) {
+                    return numpy::asarray(a);
+                }
+
+            long _choice_size(long a) {
+                return a;
+            }
+
+            template<class T>
+                long _choice_size(types::ndarray<T, 1> const& a) {
+                    return a.size();
+                }
+
+            template<class Pop>
+                struct _choice_type;
+
+            template<>
+                struct _choice_type<long> {
+                    typedef long type;
+                };
+
+            template<class T>
+                struct _choice_type<types::ndarray<T, 1>> {
+                    typedef T type;
+                };
+
+            long _choice_item(long, long index) {
+                return index;
+            }
+
+            template<class T>
+                T _choice_item(types::ndarray<T, 1> const& a, long index) {
+                    return a.buffer[index];
+                }
+
+            template<size_t N>
+                types::ndarray<long, N> _choice_gather(long, types::ndarray<long, N> const& indices) {
+                    return indices;
+                }
+
+            template<class T, size_t N>
+                types::ndarray<T, N> _choice_gather(types::ndarray<T, 1> const& a, types::ndarray<long, N> const& indices) {
+                    types::ndarray<T, N> out(indices.shape, __builtin__::None);
+                    for(long i = 0, n = indices.size(); i < n; ++i)
+                        out.buffer[i] = a.buffer[indices.buffer[i]];
+                    return out;
+                }
+
+            template<class Pop, class P>
+                typename _choice_type<Pop>::type _choice(Pop const& pop, types::none_type, bool replace, P const& p) {
+                    long n = _choice_size(pop);
+                    if(n <= 0)
+                        throw types::ValueError("a must be non-empty");
+                    long index;
+                    _choice_indices(&index, 1, n, replace, p);
+                    return _choice_item(pop, index);
+                }
+
+            template<class Pop, size_t N, class P>
+                types::ndarray<typename _choice_type<Pop>::type, N> _choice(Pop const& pop, types::array<long, N> const& shape, bool replace, P const& p) {
+                    types::ndarray<long, N> indices(shape, __builtin__::None);
+                    long n = _choice_size(pop);
+                    if(n <= 0 and indices.size())
+                        throw types::ValueError("a must be non-empty");
+                    _choice_indices(indices.buffer, indices.size(), n, replace, p);
+                    return _choice_gather(pop, indices);
+                }
+
+            template<class Pop, class P>
+                types::ndarray<typename _choice_type<Pop>::type, 1> _choice(Pop const& pop, long size, bool replace, P const& p) {
+                    return _choice(pop, types::make_tuple(size), replace, p);
+                }
+
+            template<class A, class S=types::none_type, class P=types::none_type>
+                auto choice(A const& a, S const& size = S(), bool replace = true, P const& p = P())
+                -> decltype(_choice(_choice_population(a), size, replace, p))
+                {
+                    return _choice(_choice_population(a), size, replace, p);
+                }
+
+            PROXY(pythonic::numpy::random, choice);
+
+        }
+
+    }
+
+}
+
+#endif
@@ -0,0 +1,47 @@
+#ifndef PYTHONIC_NUMPY_RANDOM_EXPONENTIAL_HPP
+#define PYTHONIC_NUMPY_RANDOM_EXPONENTIAL_HPP
+
+#include "pythonic/utils/proxy.hpp"
+#include "pythonic/numpy/random/random_sample.hpp"
+
+#include <cmath>
+
+namespace pythonic {
+
+    namespace numpy {
+
+        namespace random {
+
+            // scale * -log(1 - U[0, 1)), by inversion
+            inline void _exponential_chunk(utils::philox4x32& engine, double* first, double* last, double scale) {
+                uint32_t words[2 * utils::random_chunk];
+                long n = last - first;
+                engine.fill(words, 2 * n);
+                for(long i = 0; i < n; ++i)
+                    first[i] = -scale * std::log(1. - utils::uniform_from_words(words[2 * i], words[2 * i + 1]));
+            }
+
+            double exponential(double scale = 1., types::none_type = __builtin__::None) {
+                return scale * utils::random_engine().exponential();
+            }
+
+            template<size_t N>
+                types::ndarray<double, N> exponential(double scale, types::array<long, N> const& shape) {
+                    return _random_array<double>(shape, 20, [scale](utils::philox4x32& engine, double* first, double* last) {
+                            _exponential_chunk(engine, first, last, scale);
+                            });
+                }
+
+            types::ndarray<double, 1> exponential(double scale, long size) {
+                return exponential(scale, types::make_tuple(size));
+            }
+
+            PROXY(pythonic::numpy::random, exponential);
+
+        }
+
+    }
+
+}
+
+#endif
@@ -0,0 +1,46 @@
+#ifndef PYTHONIC_NUMPY_RANDOM_NORMAL_HPP
+#define PYTHONIC_NUMPY_RANDOM_NORMAL_HPP
+
+#include "pythonic/utils/proxy.hpp"
+#include "pythonic/numpy/random/random_sample.hpp"
+
+namespace pythonic {
+
+    namespace numpy {
+
+        namespace random {
+
+            // loc + scale * N(0, 1), see utils::ziggurat
+            inline void _normal_chunk(utils::philox4x32& engine, double* first, double* last, double loc, double scale) {
+                uint32_t words[2 * utils::random_chunk];
+                long n = last - first;
+                engine.fill(words, 2 * n);
+                utils::ziggurat const& ziggurat = utils::ziggurat::get();
+                for(long i = 0; i < n; ++i)
+                    first[i] = loc + scale * ziggurat(uint64_t(words[2 * i]) << 32 | words[2 * i + 1], engine);
+            }
+
+            double normal(double loc = 0., double scale = 1., types::none_type = __builtin__::None) {
+                return loc + scale * utils::random_engine().normal();
+            }
+
+            template<size_t N>
+                types::ndarray<double, N> normal(double loc, double scale, types::array<long, N> const& shape) {
+                    return _random_array<double>(shape, 8, [loc, scale](utils::philox4x32& engine, double* first, double* last) {
+                            _normal_chunk(engine, first, last, loc, scale);
+                            });
+                }
+
+            types::ndarray<double, 1> normal(double loc, double scale, long size) {
+                return normal(loc, scale, types::make_tuple(size));
+            }
+
+            PROXY(pythonic::numpy::random, normal);
+
+        }
+
+    }
+
+}
+
+#endif
@@ -0,0 +1,40 @@
+#ifndef PYTHONIC_NUMPY_RANDOM_PERMUTATION_HPP
+#define PYTHONIC_NUMPY_RANDOM_PERMUTATION_HPP
+
+#include "pythonic/utils/proxy.hpp"
+#include "pythonic/numpy/asarray.hpp"
+#include "pythonic/numpy/copy.hpp"
+#include "pythonic/numpy/random/shuffle.hpp"
+
+#include <numeric>
+
+namespace pythonic {
+
+    namespace numpy {
+
+        namespace random {
+
+            types::ndarray<long, 1> permutation(long n) {
+                types::ndarray<long, 1> out(types::make_tuple(n), __builtin__::None);
+                std::iota(out.buffer, out.buffer + n, 0L);
+                shuffle(out);
+                return out;
+            }
+
+            // a shuffled copy, along the first axis
+            template<class E>
+                auto permutation(E const& a) -> decltype(numpy::copy(numpy::asarray(a))) {
+                    auto out = numpy::copy(numpy::asarray(a));
+                    shuffle(out);
+                    return out;
+                }
+
+            PROXY(pythonic::numpy::random, permutation);
+
+        }
+
+    }
+
+}
+
+#endif
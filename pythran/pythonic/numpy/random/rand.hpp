@@ -0,0 +1,30 @@
+#ifndef PYTHONIC_NUMPY_RANDOM_RAND_HPP
+#define PYTHONIC_NUMPY_RANDOM_RAND_HPP
+
+#include "pythonic/utils/proxy.hpp"
+#include "pythonic/numpy/random/random_sample.hpp"
+
+namespace pythonic {
+
+    namespace numpy {
+
+        namespace random {
+
+            double rand() {
+                return random_sample();
+            }
+
+            template<class... Types>
+                types::ndarray<double, sizeof...(Types)> rand(Types... dims) {
+                    return random_sample(types::array<long, sizeof...(Types)>{{dims...}});
+                }
+
+            PROXY(pythonic::numpy::random, rand);
+
+        }
+
+    }
+
+}
+
+#endif
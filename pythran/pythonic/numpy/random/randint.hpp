@@ -0,0 +1,85 @@
+#ifndef PYTHONIC_NUMPY_RANDOM_RANDINT_HPP
+#define PYTHONIC_NUMPY_RANDOM_RANDINT_HPP
+
+#include "pythonic/utils/proxy.hpp"
+#include "pythonic/numpy/random/random_sample.hpp"
+#include "pythonic/__builtin__/ValueError.hpp"
+
+namespace pythonic {
+
+    namespace numpy {
+
+        namespace random {
+
+            /* low + [0, n), without modulo bias
+             *
+             * Ranges that fit in 32 bits use one word per item (Lemire's
+             * multiply and shift), a word is redrawn with probability below
+             * n / 2**32. Wider ranges fall back to utils::philox4x32::below.
+             */
+            inline void _randint_chunk(utils::philox4x32& engine, long* first, long* last, long low, uint64_t n) {
+                long size = last - first;
+                if(n > (uint64_t(1) << 32)) {
+                    for(long i = 0; i < size; ++i)
+                        first[i] = low + engine.below(n);
+                    return;
+                }
+                uint32_t words[utils::random_chunk];
+                engine.fill(words, size);
+                uint32_t const threshold = uint32_t(-n) % n;
+                for(long i = 0; i < size; ++i) {
+                    uint64_t m = uint64_t(words[i]) * n;
+                    while(uint32_t(m) < threshold)
+                        m = uint64_t(engine()) * n;
+                    first[i] = low + long(m >> 32);
+                }
+            }
+
+            uint64_t _randint_range(long low, long high) {
+                if(low >= high)
+                    throw types::ValueError("low >= high");
+                return uint64_t(high) - uint64_t(low);
+            }
+
+            long randint(long low, long high) {
+                return low + utils::random_engine().below(_randint_range(low, high));
+            }
+
+            long randint(long high, types::none_type = __builtin__::None) {
+                return randint(0, high);
+            }
+
+            long randint(long low, long high, types::none_type) {
+                return randint(low, high);
+            }
+
+            template<size_t N>
+                types::ndarray<long, N> randint(long low, long high, types::array<long, N> const& shape) {
+                    uint64_t n = _randint_range(low, high);
+                    return _random_array<long>(shape, 2, [low, n](utils::philox4x32& engine, long* first, long* last) {
+                            _randint_chunk(engine, first, last, low, n);
+                            });
+                }
+
+            template<size_t N>
+                types::ndarray<long, N> randint(long high, types::none_type, types::array<long, N> const& shape) {
+                    return randint(0, high, shape);
+                }
+
+            types::ndarray<long, 1> randint(long low, long high, long size) {
+                return randint(low, high, types::make_tuple(size));
+            }
+
+            types::ndarray<long, 1> randint(long high, types::none_type, long size) {
+                return randint(0, high, types::make_tuple(size));
+            }
+
+            PROXY(pythonic::numpy::random, randint);
+
+        }
+
+    }
+
+}
+
+#endif
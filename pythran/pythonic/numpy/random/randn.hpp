@@ -0,0 +1,30 @@
+#ifndef PYTHONIC_NUMPY_RANDOM_RANDN_HPP
+#define PYTHONIC_NUMPY_RANDOM_RANDN_HPP
+
+#include "pythonic/utils/proxy.hpp"
+#include "pythonic/numpy/random/normal.hpp"
+
+namespace pythonic {
+
+    namespace numpy {
+
+        namespace random {
+
+            double randn() {
+                return normal();
+            }
+
+            template<class... Types>
+                types::ndarray<double, sizeof...(Types)> randn(Types... dims) {
+                    return normal(0., 1., types::array<long, sizeof...(Types)>{{dims...}});
+                }
+
+            PROXY(pythonic::numpy::random, randn);
+
+        }
+
+    }
+
+}
+
+#endif
@@ -0,0 +1,58 @@
+#ifndef PYTHONIC_NUMPY_RANDOM_RANDOM_SAMPLE_HPP
+#define PYTHONIC_NUMPY_RANDOM_RANDOM_SAMPLE_HPP
+
+#include "pythonic/utils/proxy.hpp"
+#include "pythonic/utils/random.hpp"
+#include "pythonic/types/ndarray.hpp"
+#include "pythonic/__builtin__/None.hpp"
+
+namespace pythonic {
+
+    namespace numpy {
+
+        namespace random {
+
+            /* an array of the given shape, filled by chunks with draw
+             *
+             * see utils::random_fill
+             */
+            template<class T, size_t N, class F>
+                types::ndarray<T, N> _random_array(types::array<long, N> const& shape, long cost, F const& draw) {
+                    types::ndarray<T, N> out(shape, __builtin__::None);
+                    utils::random_fill(out.buffer, out.size(), cost, draw);
+                    return out;
+                }
+
+            // low + scale * U[0, 1), two words per item
+            inline void _uniform_chunk(utils::philox4x32& engine, double* first, double* last, double low, double scale) {
+                uint32_t words[2 * utils::random_chunk];
+                long n = last - first;
+                engine.fill(words, 2 * n);
+                for(long i = 0; i < n; ++i)
+                    first[i] = low + scale * utils::uniform_from_words(words[2 * i], words[2 * i + 1]);
+            }
+
+            double random_sample(types::none_type = __builtin__::None) {
+                return utils::random_engine().uniform();
+            }
+
+            template<size_t N>
+                types::ndarray<double, N> random_sample(types::array<long, N> const& shape) {
+                    return _random_array<double>(shape, 2, [](utils::philox4x32& engine, double* first, double* last) {
+                            _uniform_chunk(engine, first, last, 0., 1.);
+                            });
+                }
+
+            types::ndarray<double, 1> random_sample(long size) {
+                return random_sample(types::make_tuple(size));
+            }
+
+            PROXY(pythonic::numpy::random, random_sample);
+
+        }
+
+    }
+
+}
+
+#endif
@@ -0,0 +1,24 @@
+#ifndef PYTHONIC_NUMPY_RANDOM_SEED_HPP
+#define PYTHONIC_NUMPY_RANDOM_SEED_HPP
+
+#include "pythonic/utils/proxy.hpp"
+#include "pythonic/random/seed.hpp"
+
+namespace pythonic {
+
+    namespace numpy {
+
+        namespace random {
+
+            // numpy.random and random draw from the same streams
+            using pythonic::random::seed;
+
+            PROXY(pythonic::numpy::random, seed);
+
+        }
+
+    }
+
+}
+
+#endif
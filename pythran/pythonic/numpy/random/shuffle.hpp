@@ -0,0 +1,50 @@
+#ifndef PYTHONIC_NUMPY_RANDOM_SHUFFLE_HPP
+#define PYTHONIC_NUMPY_RANDOM_SHUFFLE_HPP
+
+#include "pythonic/utils/proxy.hpp"
+#include "pythonic/utils/random.hpp"
+#include "pythonic/types/ndarray.hpp"
+#include "pythonic/types/list.hpp"
+#include "pythonic/__builtin__/None.hpp"
+
+#include <algorithm>
+
+namespace pythonic {
+
+    namespace numpy {
+
+        namespace random {
+
+            // Fisher-Yates, along the first axis
+            template<class T, size_t N>
+                types::none_type shuffle(types::ndarray<T, N> & a) {
+                    long n = a.shape[0];
+                    if(n > 1) {
+                        long row = a.size() / n;
+                        utils::philox4x32& engine = utils::random_engine();
+                        for(long i = n - 1; i > 0; --i) {
+                            long j = engine.below(i + 1);
+                            if(j != i)
+                                std::swap_ranges(a.buffer + i * row, a.buffer + (i + 1) * row, a.buffer + j * row);
+                        }
+                    }
+                    return __builtin__::None;
+                }
+
+            template<class T>
+                types::none_type shuffle(types::list<T> & seq) {
+                    utils::philox4x32& engine = utils::random_engine();
+                    for(long i = long(seq.size()) - 1; i > 0; --i)
+                        std::swap(seq[i], seq[engine.below(i + 1)]);
+                    return __builtin__::None;
+                }
+
+            PROXY(pythonic::numpy::random, shuffle);
+
+        }
+
+    }
+
+}
+
+#endif
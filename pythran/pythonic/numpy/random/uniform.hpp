@@ -0,0 +1,37 @@
+#ifndef PYTHONIC_NUMPY_RANDOM_UNIFORM_HPP
+#define PYTHONIC_NUMPY_RANDOM_UNIFORM_HPP
+
+#include "pythonic/utils/proxy.hpp"
+#include "pythonic/numpy/random/random_sample.hpp"
+
+namespace pythonic {
+
+    namespace numpy {
+
+        namespace random {
+
+            double uniform(double low = 0., double high = 1., types::none_type = __builtin__::None) {
+                return low + (high - low) * utils::random_engine().uniform();
+            }
+
+            template<size_t N>
+                types::ndarray<double, N> uniform(double low, double high, types::array<long, N> const& shape) {
+                    double const scale = high - low;
+                    return _random_array<double>(shape, 2, [low, scale](utils::philox4x32& engine, double* first, double* last) {
+                            _uniform_chunk(engine, first, last, low, scale);
+                            });
+                }
+
+            types::ndarray<double, 1> uniform(double low, double high, long size) {
+                return uniform(low, high, types::make_tuple(size));
+            }
+
+            PROXY(pythonic::numpy::random, uniform);
+
+        }
+
+    }
+
+}
+
+#endif
@@ -0,0 +1,244 @@
+#ifndef PYTHONIC_NUMPY_REDUCE_HPP
+#define PYTHONIC_NUMPY_REDUCE_HPP
+
+#include "pythonic/types/ndarray.hpp"
+#include "pythonic/types/vectorizable_type.hpp"
+#include "pythonic/utils/broadcast_copy.hpp"
+#include "pythonic/utils/neutral.hpp"
+#include "pythonic/__builtin__/ValueError.hpp"
+
+#ifdef USE_BOOST_SIMD
+#include <boost/simd/sdk/simd/native.hpp>
+#include <boost/simd/include/functions/aligned_store.hpp>
+#endif
+
+#include <algorithm>
+#include <memory>
+
+/* Reduction engine shared by sum, prod, max, min, any, all...
+ *
+ * Full reductions are split in chunks of about PYTHRAN_REDUCE_CHUNK elements,
+ * whose partial results are combined in chunk order. As the splitting only
+ * depends on the shape, the result does not depend on the number of threads.
+ * Axis reductions accumulate in place in the output array, each output element
+ * being folded in the order of the reduced axis.
+ */
+#ifndef PYTHRAN_REDUCE_CHUNK
+#define PYTHRAN_REDUCE_CHUNK 4096
+#endif
+
+namespace pythonic {
+
+    namespace numpy {
+
+        /* fold e[first:last] into acc */
+        template<class Op, size_t N, bool vector_form>
+            struct _reduce {
+                template<class E, class F>
+                    F operator()(E const& e, long first, long last, F acc) const
+                    {
+                        for(long i = first; i < last; ++i) {
+                            auto sub = e.fast(i);
+                            acc = _reduce<Op, N - 1, vector_form>()(sub, 0, sub.shape[0], acc);
+                        }
+                        return acc;
+                    }
+            };
+
+        // four independent accumulators break the dependency chain
+        template<class Op, bool vector_form>
+            struct _reduce<Op, 1, vector_form> {
+                template<class E, class F>
+                    F operator()(E const& e, long first, long last, F acc) const
+                    {
+                        Op op;
+                        F acc0 = utils::neutral<Op, F>::value(), acc1 = acc0, acc2 = acc0, acc3 = acc0;
+                        long i = first;
+                        for(; i + 4 <= last; i += 4) {
+                            acc0 = op(acc0, e.fast(i));
+                            acc1 = op(acc1, e.fast(i + 1));
+                            acc2 = op(acc2, e.fast(i + 2));
+                            acc3 = op(acc3, e.fast(i + 3));
+                        }
+                        for(; i < last; ++i)
+                            acc0 = op(acc0, e.fast(i));
+                        return op(acc, F(op(F(op(acc0, acc1)), F(op(acc2, acc3)))));
+                    }
+            };
+
+#ifdef USE_BOOST_SIMD
+        template<class Op>
+            struct _reduce<Op, 1, true> {
+                template<class E, class F>
+                    F operator()(E const& e, long first, long last, F acc) const
+                    {
+                        typedef typename E::dtype T;
+                        typedef typename boost::simd::native<T, BOOST_SIMD_DEFAULT_EXTENSION> vT;
+                        static const long vN = boost::simd::meta::cardinal_of<vT>::value;
+                        // a load reads vS elements, see types::vector_step
+                        static const long vS = types::vector_step<E>::value;
+                        Op op;
+                        vT acc0 = boost::simd::splat<vT>(utils::neutral<Op, T>::value()), acc1 = acc0, acc2 = acc0, acc3 = acc0;
+                        long i = first;
+                        for(; i + 3 * vN + vS <= last; i += 4 * vN) {
+                            acc0 = op(acc0, e.load(i));
+                            acc1 = op(acc1, e.load(i + vN));
+                            acc2 = op(acc2, e.load(i + 2 * vN));
+                            acc3 = op(acc3, e.load(i + 3 * vN));
+                        }
+                        for(; i + vS <= last; i += vN)
+                            acc0 = op(acc0, e.load(i));
+                        alignas(sizeof(vT)) T lanes[vN];
+                        boost::simd::aligned_store<vT>(op(op(acc0, acc1), op(acc2, acc3)), lanes, 0);
+                        T r = lanes[0];
+                        for(long l = 1; l < vN; ++l)
+                            r = op(r, lanes[l]);
+                        for(; i < last; ++i)
+                            r = op(r, e.fast(i));
+                        return op(acc, r);
+                    }
+            };
+#endif
+
+        /* out[first:last] = op(out[first:last], e[first:last]), element-wise */
+        template<class Op, size_t N, bool vector_form>
+            struct _reduce_into {
+                template<class O, class E>
+                    void operator()(O&& out, E const& e, long first, long last) const
+                    {
+                        for(long i = first; i < last; ++i) {
+                            auto sub = e.fast(i);
+                            _reduce_into<Op, N - 1, vector_form>()(out.fast(i), sub, 0, sub.shape[0]);
+                        }
+                    }
+            };
+
+        template<class Op, bool vector_form>
+            struct _reduce_into<Op, 1, vector_form> {
+                template<class O, class E>
+                    void operator()(O&& out, E const& e, long first, long last) const
+                    {
+                        Op op;
+                        for(long i = first; i < last; ++i)
+                            out.fast(i) = op(out.fast(i), e.fast(i));
+                    }
+            };
+
+#ifdef USE_BOOST_SIMD
+        template<class Op>
+            struct _reduce_into<Op, 1, true> {
+                template<class O, class E>
+                    void operator()(O&& out, E const& e, long first, long last) const
+                    {
+                        typedef typename E::dtype T;
+                        typedef typename boost::simd::native<T, BOOST_SIMD_DEFAULT_EXTENSION> vT;
+                        static const long vN = boost::simd::meta::cardinal_of<vT>::value;
+                        static const long vS = types::vector_step<E>::value;
+                        Op op;
+                        long i = first;
+                        for(; i + vS <= last; i += vN)
+                            out.store(op(out.load(i), e.load(i)), i);
+                        for(; i < last; ++i)
+                            out.fast(i) = op(out.fast(i), e.fast(i));
+                    }
+            };
+#endif
+
+        /* fold e along axis into out, out having the shape of e without axis */
+        template<class Op, size_t N, bool vector_form>
+            struct _reduce_axis {
+                template<class O, class E>
+                    void operator()(O&& out, E const& e, long axis) const
+                    {
+                        if(axis == 0)
+                            for(long i = 0; i < e.shape[0]; ++i)
+                                _reduce_into<Op, N - 1, vector_form>()(out, e.fast(i), 0, out.shape[0]);
+                        else
+                            for(long i = 0; i < e.shape[0]; ++i)
+                                _reduce_axis<Op, N - 1, vector_form>()(out.fast(i), e.fast(i), axis - 1);
+                    }
+            };
+
+        template<class Op, bool vector_form>
+            struct _reduce_axis<Op, 1, vector_form> {
+                template<class O, class E>
+                    void operator()(O&& out, E const& e, long) const
+                    {
+                        out = _reduce<Op, 1, vector_form>()(e, 0, e.shape[0], out);
+                    }
+            };
+
+        template<class E, class F>
+            struct _reduce_vector_form {
+                static const bool value = E::is_vectorizable and
+                                          types::is_vectorizable<typename E::dtype>::value and
+                                          std::is_same<typename E::dtype, F>::value;
+            };
+
+        // fold every element of expr into acc
+        template<class Op, class E, class F>
+            F reduce(E const& expr, F acc)
+            {
+                typedef _reduce<Op, E::value, _reduce_vector_form<E, F>::value> reducer;
+                long const n = expr.shape[0];
+                long const row = std::accumulate(expr.shape.begin() + 1, expr.shape.end(), 1L, std::multiplies<long>());
+                if(n == 0 or row == 0)
+                    return acc;
+                long const chunk = std::max(1L, PYTHRAN_REDUCE_CHUNK / row);
+                long const nchunks = (n + chunk - 1) / chunk;
+                if(nchunks == 1)
+                    return reducer()(expr, 0, n, acc);
+
+                std::unique_ptr<F[]> partials(new F[nchunks]);
+#ifdef _OPENMP
+                #pragma omp parallel for if(utils::omp_worth(nchunks, chunk * row * types::expr_cost<E>::value))
+#endif
+                for(long c = 0; c < nchunks; ++c)
+                    partials[c] = reducer()(expr, c * chunk, std::min(n, (c + 1) * chunk), utils::neutral<Op, F>::value());
+                Op op;
+                for(long c = 0; c < nchunks; ++c)
+                    acc = op(acc, partials[c]);
+                return acc;
+            }
+
+        // fold expr along axis, the result being stored as F
+        template<class Op, class F, class E>
+            types::ndarray<F, E::value - 1> reduce(E const& expr, long axis)
+            {
+                static const bool vector_form = _reduce_vector_form<E, F>::value;
+                if(axis < 0 || axis >= long(E::value))
+                    throw types::ValueError("axis out of bounds");
+                types::array<long, E::value - 1> shp;
+                auto next = std::copy(expr.shape.begin(), expr.shape.begin() + axis, shp.begin());
+                std::copy(expr.shape.begin() + axis + 1, expr.shape.end(), next);
+                types::ndarray<F, E::value - 1> out(shp, utils::neutral<Op, F>::value());
+
+                long const size = std::accumulate(expr.shape.begin(), expr.shape.end(), 1L, std::multiplies<long>());
+                if(size == 0)
+                    return out;
+                if(axis == 0) {
+                    // each task folds every row of expr into a slice of out
+                    long const n = out.shape[0];
+                    long const step = std::max(1L, PYTHRAN_REDUCE_CHUNK * n / size);
+#ifdef _OPENMP
+                    #pragma omp parallel for if(utils::omp_worth((n + step - 1) / step, step * expr.shape[0] * types::expr_cost<E>::value))
+#endif
+                    for(long j = 0; j < n; j += step)
+                        for(long i = 0; i < expr.shape[0]; ++i)
+                            _reduce_into<Op, E::value - 1, vector_form>()(out, expr.fast(i), j, std::min(n, j + step));
+                }
+                else {
+#ifdef _OPENMP
+                    #pragma omp parallel for if(utils::omp_worth(expr.shape[0], size / expr.shape[0] * types::expr_cost<E>::value))
+#endif
+                    for(long i = 0; i < expr.shape[0]; ++i)
+                        _reduce_axis<Op, E::value - 1, vector_form>()(out.fast(i), expr.fast(i), axis - 1);
+                }
+                return out;
+            }
+
+    }
+
+}
+
+#endif
@@ -3,11 +3,49 @@
 
 #include "pythonic/utils/proxy.hpp"
 #include "pythonic/utils/numpy_conversion.hpp"
+#include "pythonic/utils/sort.hpp"
 #include "pythonic/types/ndarray.hpp"
 
+#include <functional>
+#include <numeric>
+#include <vector>
+
 namespace pythonic {
 
     namespace numpy {
+
+        /* calls f(lane, offset, n, stride, buffer) on each lane of an array
+         * along axis, the lane elements being at offset, offset + stride, ...
+         * offset + (n - 1) * stride. Lanes are numbered as the elements of the
+         * array without axis. buffer holds n elements of type B, it is reused
+         * by the lanes processed by the same thread and is only allocated when
+         * lanes are not contiguous, unless scratch is set. Lanes are
+         * independent, so they are processed in parallel when there is enough
+         * of them */
+        template<class B, size_t N, class F>
+            void _foreach_lane(types::array<long, N> const& shape, long axis, F const& f, bool scratch=false)
+            {
+                long const n = shape[axis];
+                if(n == 0)
+                    return;
+                long const stride = std::accumulate(shape.begin() + axis + 1, shape.end(), 1L, std::multiplies<long>());
+                long const lanes = std::accumulate(shape.begin(), shape.end(), 1L, std::multiplies<long>()) / n;
+#ifdef _OPENMP
+                long log2n = 1;
+                while((1L << log2n) < n)
+                    ++log2n;
+                #pragma omp parallel if(lanes > 1 and utils::omp_worth(lanes, n * log2n))
+#endif
+                {
+                    std::vector<B> buffer(stride == 1 and not scratch ? 0 : n);
+#ifdef _OPENMP
+                    #pragma omp for
+#endif
+                    for(long l = 0; l < lanes; ++l)
+                        f(l, l / stride * n * stride + l % stride, n, stride, buffer.data());
+                }
+            }
+
         template<class T, size_t N>
             types::ndarray<T,N> sort(types::ndarray<T,N> const& expr, long axis=-1)
             {
@@ -16,24 +54,19 @@ namespace pythonic {
                 axis = axis%N;
                 types::ndarray<T,N> out(expr.shape, __builtin__::None);
                 std::copy(expr.buffer, expr.buffer + expr.size(), out.buffer);
-                long step = std::accumulate(expr.shape.begin() + axis, expr.shape.end(), 1L, std::multiplies<long>());
-                for(size_t i=0; i<expr.size()/expr.shape[axis]*step; i+=step)
-                {
-                    std::vector<T> to_sort;
-                    T* iter = out.buffer + (i%expr.size() + i/expr.size());
-                    while(iter!=out.buffer + (i%expr.size() + i/expr.size()) + step)
-                    {
-                        to_sort.push_back(*iter);
-                        iter+=step/expr.shape[axis];
-                    }
-                    std::sort(to_sort.begin(), to_sort.end());
-                    iter = out.buffer + (i%expr.size() + i/expr.size());
-                    for(auto val: to_sort)
-                    {
-                        *iter = val;
-                        iter += step/expr.shape[axis];
-                    }
-                }
+                T* data = out.buffer;
+                _foreach_lane<T>(out.shape, axis,
+                        [data](long, long offset, long n, long stride, T* buffer) {
+                            if(stride == 1)
+                                utils::sort(data + offset, data + offset + n);
+                            else {
+                                for(long i = 0; i < n; ++i)
+                                    buffer[i] = data[offset + i * stride];
+                                utils::sort(buffer, buffer + n);
+                                for(long i = 0; i < n; ++i)
+                                    data[offset + i * stride] = buffer[i];
+                            }
+                        });
                 return out;
             }
 
@@ -45,4 +78,3 @@ namespace pythonic {
 }
 
 #endif
-
@@ -3,12 +3,14 @@
 
 #include "pythonic/utils/proxy.hpp"
 #include "pythonic/utils/numpy_conversion.hpp"
+#include "pythonic/utils/sort.hpp"
 #include "pythonic/types/ndarray.hpp"
+#include "pythonic/numpy/sort.hpp"
 
 namespace pythonic {
 
     namespace numpy {
-        bool comp_complex(std::complex<double> const& i, std::complex<double> const& j)
+        inline bool comp_complex(std::complex<double> const& i, std::complex<double> const& j)
         {
             if(std::real(i) == std::real(j))
                 return std::imag(i) < std::imag(j);
@@ -21,8 +23,11 @@ namespace pythonic {
             {
                 types::ndarray<std::complex<double>,N> out(expr.shape, __builtin__::None);
                 std::copy(expr.buffer, expr.buffer + expr.size(), out.buffer);
-                for(int i=0; i<expr.size()/expr.shape[N-1]; ++i)
-                    std::sort(out.buffer + i * expr.shape[N-1], out.buffer + (i+1) * expr.shape[N-1], comp_complex);
+                std::complex<double>* data = out.buffer;
+                _foreach_lane<std::complex<double>>(out.shape, N - 1,
+                        [data](long, long offset, long n, long, std::complex<double>*) {
+                            utils::sort(data + offset, data + offset + n, comp_complex);
+                        });
                 return out;
             }
 
@@ -34,4 +39,3 @@ namespace pythonic {
 }
 
 #endif
-
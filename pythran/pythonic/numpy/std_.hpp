@@ -0,0 +1,49 @@
+#ifndef PYTHONIC_NUMPY_STD_HPP
+#define PYTHONIC_NUMPY_STD_HPP
+
+#include "pythonic/utils/proxy.hpp"
+#include "pythonic/types/ndarray.hpp"
+#include "pythonic/__builtin__/None.hpp"
+#include "pythonic/numpy/var.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace pythonic {
+
+    namespace numpy {
+
+        template<class T>
+            void _std_sqrt(T& v)
+            {
+                v = std::sqrt(v);
+            }
+        template<class T, size_t N>
+            void _std_sqrt(types::ndarray<T, N>& v)
+            {
+                std::transform(v.buffer, v.buffer + v.size(), v.buffer, [](T x) { return std::sqrt(x); });
+            }
+
+        template<class E>
+            auto std_(E const& expr, types::none_type axis = __builtin__::None, types::none_type dtype = __builtin__::None, types::none_type out = __builtin__::None, long ddof = 0)
+            -> decltype(var(expr))
+            {
+                return std::sqrt(var(expr, axis, dtype, out, ddof));
+            }
+
+        template<class E>
+            auto std_(E const& expr, long axis, types::none_type dtype = __builtin__::None, types::none_type out = __builtin__::None, long ddof = 0)
+            -> decltype(var(expr, axis))
+            {
+                auto v = var(expr, axis, dtype, out, ddof);
+                _std_sqrt(v);
+                return v;
+            }
+
+        PROXY(pythonic::numpy, std_);
+
+    }
+
+}
+
+#endif
@@ -2,31 +2,44 @@
 #define PYTHONIC_NUMPY_UNION1D_HPP
 
 #include "pythonic/utils/proxy.hpp"
+#include "pythonic/utils/sort.hpp"
 #include "pythonic/types/ndarray.hpp"
+#include "pythonic/numpy/unique.hpp"
+
+#include <vector>
 
 namespace pythonic {
 
     namespace numpy {
-        template<class I, class O>
-            void _union1d(I begin, I end, O& out, utils::int_<1>)
-            {
-                for(; begin != end; ++begin)
-                    out.insert(*begin);
-            }
-        template<class I, class O, size_t N>
-            void _union1d(I begin, I end, O& out, utils::int_<N>)
-            {
-                for(; begin != end; ++begin)
-                    _union1d((*begin).begin(), (*begin).end(), out, utils::int_<N - 1>());
-            }
         template<class E, class F>
             types::ndarray<decltype(std::declval<typename types::numpy_expr_to_ndarray<E>::T>() + std::declval<typename types::numpy_expr_to_ndarray<F>::T>()), 1>
             union1d(E const& e, F const& f)
             {
-                std::set<decltype(std::declval<typename types::numpy_expr_to_ndarray<E>::T>() + std::declval<typename types::numpy_expr_to_ndarray<F>::T>())> res;
-                _union1d(e.begin(), e.end(), res, utils::int_<types::numpy_expr_to_ndarray<E>::N>());
-                _union1d(f.begin(), f.end(), res, utils::int_<types::numpy_expr_to_ndarray<F>::N>());
-                return res;
+                typedef decltype(std::declval<typename types::numpy_expr_to_ndarray<E>::T>() + std::declval<typename types::numpy_expr_to_ndarray<F>::T>()) T;
+                // merge of the sorted unique values of both arrays
+                auto ue = unique(e);
+                auto uf = unique(f);
+                auto ie = ue.buffer, ee = ue.buffer + ue.size();
+                auto if_ = uf.buffer, ef = uf.buffer + uf.size();
+                utils::sort_less<T> less;
+                std::vector<T> out;
+                out.reserve(ue.size() + uf.size());
+                while(ie != ee and if_ != ef) {
+                    T const ve = *ie, vf = *if_;
+                    if(less(ve, vf))
+                        out.push_back(ve), ++ie;
+                    else if(less(vf, ve))
+                        out.push_back(vf), ++if_;
+                    else {
+                        out.push_back(ve);
+                        if(not (ve == vf)) // NaN are all kept
+                            out.push_back(vf);
+                        ++ie, ++if_;
+                    }
+                }
+                out.insert(out.end(), ie, ee);
+                out.insert(out.end(), if_, ef);
+                return types::ndarray<T, 1>(out);
             }
 
         PROXY(pythonic::numpy, union1d)
@@ -36,4 +49,3 @@ namespace pythonic {
 }
 
 #endif
-
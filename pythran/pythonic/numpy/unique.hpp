@@ -2,81 +2,170 @@
 #define PYTHONIC_NUMPY_UNIQUE_HPP
 
 #include "pythonic/utils/proxy.hpp"
+#include "pythonic/utils/sort.hpp"
 #include "pythonic/types/ndarray.hpp"
 #include "pythonic/types/tuple.hpp"
+#include "pythonic/numpy/asarray.hpp"
 
+#include <complex>
+#include <functional>
+#include <numeric>
+#include <vector>
+
+/* Set operations on arrays
+ *
+ * The n values of an array are split into groups of equal values, sorted by
+ * value, the indices of each group being increasing. Integers and floating
+ * point numbers are grouped by a stable argsort. Other values are grouped
+ * through an open addressing hash table, so that only one value per group is
+ * sorted. NaN are never equal, each of them is a group of its own.
+ */
 namespace pythonic {
 
     namespace numpy {
-        template<class I, class O>
-            void _unique1(I begin, I end, O& out, utils::int_<1>)
+
+        template<class T>
+            struct _unique_hash : std::hash<T> {
+            };
+
+        template<class T>
+            struct _unique_hash<std::complex<T>> {
+                size_t operator()(std::complex<T> const& v) const {
+                    std::hash<T> h;
+                    return h(v.real()) * 31 + h(v.imag());
+                }
+            };
+
+        /* indices of the group g are order[start[g]], ... order[start[g + 1] - 1] */
+        struct _unique_groups {
+            std::vector<long> order;
+            std::vector<long> start;
+            long size() const { return start.size() - 1; }
+        };
+
+        template<class T>
+            _unique_groups _group(T const* values, long n, std::true_type)
             {
-                    out.insert(begin, end);
+                _unique_groups groups;
+                groups.order.resize(n);
+                utils::argsort(values, n, 1, groups.order.data());
+                for(long i = 0; i < n; ++i)
+                    if(i == 0 or not (values[groups.order[i]] == values[groups.order[i - 1]]))
+                        groups.start.push_back(i);
+                groups.start.push_back(n);
+                return groups;
             }
-        template<class I, class O, size_t N>
-            void _unique1(I begin, I end, O& out, utils::int_<N>)
+
+        template<class T>
+            _unique_groups _group(T const* values, long n, std::false_type)
             {
-                for(; begin != end; ++begin)
-                    _unique1((*begin).begin(), (*begin).end(), out, utils::int_<N - 1>());
-            }
+                // slots hold the group of their value, -1 if empty
+                long capacity = 16;
+                while(capacity < 2 * n)
+                    capacity *= 2;
+                std::vector<long> slots(capacity, -1);
+                std::vector<long> first, group(n);
+                _unique_hash<T> hash;
+                for(long i = 0; i < n; ++i) {
+                    long slot = hash(values[i]) & (capacity - 1);
+                    while(slots[slot] != -1 and not (values[first[slots[slot]]] == values[i]))
+                        slot = (slot + 1) & (capacity - 1);
+                    if(slots[slot] == -1) {
+                        slots[slot] = first.size();
+                        first.push_back(i);
+                    }
+                    group[i] = slots[slot];
+                }
 
-        template<class E>
-            types::ndarray<typename types::numpy_expr_to_ndarray<E>::T, 1> unique(E const& expr) {
-                std::set<typename types::numpy_expr_to_ndarray<E>::T> res;
-                _unique1(expr.begin(), expr.end(), res, utils::int_<types::numpy_expr_to_ndarray<E>::N>());
-                return types::ndarray<typename types::numpy_expr_to_ndarray<E>::T, 1>(res);
+                // sort the groups by value, then bucket the indices
+                long const size = first.size();
+                std::vector<long> sorted(size), rank(size);
+                std::iota(sorted.begin(), sorted.end(), 0L);
+                utils::sort_less<T> less;
+                utils::stable_sort(sorted.begin(), sorted.end(),
+                                   [values, &first, less](long g0, long g1) { return less(values[first[g0]], values[first[g1]]); });
+                for(long r = 0; r < size; ++r)
+                    rank[sorted[r]] = r;
+
+                _unique_groups groups;
+                groups.start.assign(size + 1, 0);
+                for(long i = 0; i < n; ++i)
+                    ++groups.start[rank[group[i]] + 1];
+                std::partial_sum(groups.start.begin(), groups.start.end(), groups.start.begin());
+                std::vector<long> next(groups.start.begin(), groups.start.end() - 1);
+                groups.order.resize(n);
+                for(long i = 0; i < n; ++i)
+                    groups.order[next[rank[group[i]]]++] = i;
+                return groups;
             }
 
-        template<class I, class O0, class O1>
-            void _unique2(I begin, I end, O0& out0, O1& out1, long & i, utils::int_<1>)
+        template<class T>
+            _unique_groups _group(T const* values, long n)
             {
-                for(; begin != end; ++begin, ++i) {
-                    auto pair = out0.insert(*begin);
-                    if(pair.second)
-                        out1.push_back(i);
-                }
+                return _group(values, n, std::integral_constant<bool, utils::radix_key<T>::value>());
             }
-        template<class I, class O0, class O1, size_t N>
-            void _unique2(I begin, I end, O0& out0, O1& out1, long & i, utils::int_<N>)
+
+        template<class T>
+            types::ndarray<T, 1> _unique_values(T const* values, _unique_groups const& groups)
             {
-                for(; begin != end; ++begin)
-                    _unique2((*begin).begin(), (*begin).end(), out0, out1, i, utils::int_<N - 1>());
+                types::ndarray<T, 1> out(types::make_tuple(groups.size()), __builtin__::None);
+                for(long g = 0; g < groups.size(); ++g)
+                    out.buffer[g] = values[groups.order[groups.start[g]]];
+                return out;
             }
 
-        template<class E>
-            std::tuple<types::ndarray<typename types::numpy_expr_to_ndarray<E>::T, 1>, types::ndarray<long, 1>> unique(E const& expr, bool return_index) {
-                std::set<typename types::numpy_expr_to_ndarray<E>::T> res;
-                std::vector<long> return_index_res;
-                long i = 0;
-                _unique2(expr.begin(), expr.end(), res, return_index_res, i, utils::int_<types::numpy_expr_to_ndarray<E>::N>());
-                return std::make_tuple(types::ndarray<typename types::numpy_expr_to_ndarray<E>::T, 1>(res), types::ndarray<long, 1>(return_index_res));
-            }
+        // indices of the first occurrence of each unique value
+        inline types::ndarray<long, 1> _unique_index(_unique_groups const& groups)
+        {
+            types::ndarray<long, 1> out(types::make_tuple(groups.size()), __builtin__::None);
+            for(long g = 0; g < groups.size(); ++g)
+                out.buffer[g] = groups.order[groups.start[g]];
+            return out;
+        }
 
+        // index of the unique value of each value
+        inline types::ndarray<long, 1> _unique_inverse(_unique_groups const& groups)
+        {
+            types::ndarray<long, 1> out(types::make_tuple(long(groups.order.size())), __builtin__::None);
+            for(long g = 0; g < groups.size(); ++g)
+                for(long i = groups.start[g]; i < groups.start[g + 1]; ++i)
+                    out.buffer[groups.order[i]] = g;
+            return out;
+        }
 
-        template<class I, class O0, class O1, class O2>
-            void _unique3(I begin, I end, O0& out0, O1& out1, O2& out2, long & i, utils::int_<1>)
-            {
-                for(; begin != end; ++begin, ++i) {
-                    auto pair = out0.insert(*begin);
-                    out2[i] = std::distance(out0.begin(), pair.first);
-                    if(pair.second)
-                        out1.push_back(i);
-                }
+        inline types::ndarray<long, 1> _unique_counts(_unique_groups const& groups)
+        {
+            types::ndarray<long, 1> out(types::make_tuple(groups.size()), __builtin__::None);
+            for(long g = 0; g < groups.size(); ++g)
+                out.buffer[g] = groups.start[g + 1] - groups.start[g];
+            return out;
+        }
+
+        template<class E>
+            types::ndarray<typename types::numpy_expr_to_ndarray<E>::T, 1> unique(E const& expr) {
+                auto a = asarray(expr);
+                return _unique_values(a.buffer, _group(a.buffer, a.size()));
             }
-        template<class I, class O0, class O1, class O2, size_t N>
-            void _unique3(I begin, I end, O0& out0, O1& out1, O2& out2, long & i, utils::int_<N>)
-            {
-                for(; begin != end; ++begin)
-                    _unique3((*begin).begin(), (*begin).end(), out0, out1, out2, i, utils::int_<N - 1>());
+
+        template<class E>
+            std::tuple<types::ndarray<typename types::numpy_expr_to_ndarray<E>::T, 1>, types::ndarray<long, 1>> unique(E const& expr, bool return_index) {
+                auto a = asarray(expr);
+                auto groups = _group(a.buffer, a.size());
+                return std::make_tuple(_unique_values(a.buffer, groups), _unique_index(groups));
             }
+
         template<class E>
             std::tuple<types::ndarray<typename types::numpy_expr_to_ndarray<E>::T, 1>, types::ndarray<long, 1>, types::ndarray<long, 1>> unique(E const& expr, bool return_index, bool return_inverse) {
-                std::set<typename types::numpy_expr_to_ndarray<E>::T> res;
-                std::vector<long> return_index_res;
-                types::ndarray<long, 1> return_inverse_res(types::array<long,1>{{expr.size()}}, __builtin__::None);
-                long i = 0;
-                _unique3(expr.begin(), expr.end(), res, return_index_res, return_inverse_res, i, utils::int_<types::numpy_expr_to_ndarray<E>::N>());
-                return std::make_tuple(types::ndarray<typename types::numpy_expr_to_ndarray<E>::T, 1>(res), types::ndarray<long, 1>(return_index_res), return_inverse_res);
+                auto a = asarray(expr);
+                auto groups = _group(a.buffer, a.size());
+                return std::make_tuple(_unique_values(a.buffer, groups), _unique_index(groups), _unique_inverse(groups));
+            }
+
+        template<class E>
+            std::tuple<types::ndarray<typename types::numpy_expr_to_ndarray<E>::T, 1>, types::ndarray<long, 1>, types::ndarray<long, 1>, types::ndarray<long, 1>> unique(E const& expr, bool return_index, bool return_inverse, bool return_counts) {
+                auto a = asarray(expr);
+                auto groups = _group(a.buffer, a.size());
+                return std::make_tuple(_unique_values(a.buffer, groups), _unique_index(groups), _unique_inverse(groups), _unique_counts(groups));
             }
 
         PROXY(pythonic::numpy, unique)
@@ -86,4 +175,3 @@ namespace pythonic {
 }
 
 #endif
-
@@ -1,13 +1,12 @@
 #ifndef PYTHONIC_NUMPY_VAR_HPP
 #define PYTHONIC_NUMPY_VAR_HPP
 #include "pythonic/utils/proxy.hpp"
+#include "pythonic/utils/neutral.hpp"
 #include "pythonic/types/ndarray.hpp"
 #include "pythonic/__builtin__/None.hpp"
 #include "pythonic/__builtin__/ValueError.hpp"
-#include "pythonic/numpy/add.hpp"
 #include "pythonic/numpy/mean.hpp"
-#include "pythonic/numpy/reshape.hpp"
-#include "pythonic/numpy/sum.hpp"
+#include "pythonic/numpy/reduce.hpp"
 
 #include <algorithm>
 
@@ -19,56 +18,153 @@ namespace pythonic {
                                                        double,
                                                        typename E::dtype>::type;
 
+        /* Running state of Welford's algorithm: number of elements, mean and
+         * sum of squared deviations from the mean. Variance is computed in a
+         * single pass, without evaluating ``expr - mean(expr)''.
+         */
+        template<class T>
+            struct _welford {
+                long n;
+                T mean;
+                T m2;
+            };
+
+        struct _welford_op {
+            // add an element
+            template<class T, class V>
+                _welford<T> operator()(_welford<T> s, V const& x) const
+                {
+                    T const delta = T(x) - s.mean;
+                    s.n += 1;
+                    s.mean += delta / T(s.n);
+                    s.m2 += delta * (T(x) - s.mean);
+                    return s;
+                }
+            // merge two states, as described by Chan et al.
+            template<class T>
+                _welford<T> operator()(_welford<T> const& a, _welford<T> const& b) const
+                {
+                    if(b.n == 0) return a;
+                    if(a.n == 0) return b;
+                    long const n = a.n + b.n;
+                    T const delta = b.mean - a.mean;
+                    return {n, a.mean + delta * T(b.n) / T(n), a.m2 + b.m2 + delta * delta * T(a.n) * T(b.n) / T(n)};
+                }
+        };
+
+    }
+
+    namespace utils {
+        template<class T>
+            struct neutral<numpy::_welford_op, numpy::_welford<T>> {
+                static numpy::_welford<T> value() { return {0, T(0), T(0)}; }
+            };
+    }
+
+    namespace numpy {
+
         template<class E>
-            auto
+            var_type<E>
             var(E const& expr, types::none_type axis = __builtin__::None, types::none_type dtype = __builtin__::None, types::none_type out = __builtin__::None, long ddof = 0)
-            -> decltype(var_type<E>(mean(expr)))
             {
-                auto m = mean(expr);
-                auto t = expr - m;
-                return sum(t*t) / var_type<E>(expr.size() - ddof);
+                auto s = reduce<_welford_op>(expr, utils::neutral<_welford_op, _welford<var_type<E>>>::value());
+                return s.m2 / var_type<E>(s.n - ddof);
             }
 
-        // this is a workaround for the lack of efficient support for broadcasting in pythonic
-        template<class T, class E, class M>
-            void _enlarge_copy_minus(T&& t, E const& e, M const& m, long axis, utils::int_<1>)
-            {
-                for(long i = 0, n = e.shape[0], p = m.shape[0]; i < n ;) {
-                    for(long j = 0; j < p; ++j, ++i)
-                        t.fast(i) = e.fast(i) - m.fast(j);
-                }
-            }
+        /* Welford updates of mean[first:last] and m2[first:last] with the
+         * element-wise row e, n being the number of rows seen so far
+         */
+        template<size_t N>
+            struct _welford_into {
+                template<class M, class E, class T>
+                    void operator()(M&& mean, M&& m2, E const& e, T n, long first, long last) const
+                    {
+                        for(long i = first; i < last; ++i) {
+                            auto sub = e.fast(i);
+                            _welford_into<N - 1>()(mean.fast(i), m2.fast(i), sub, n, 0, sub.shape[0]);
+                        }
+                    }
+            };
+        template<>
+            struct _welford_into<1> {
+                template<class M, class E, class T>
+                    void operator()(M&& mean, M&& m2, E const& e, T n, long first, long last) const
+                    {
+                        for(long i = first; i < last; ++i) {
+                            T const x = e.fast(i);
+                            T const delta = x - mean.fast(i);
+                            mean.fast(i) += delta / n;
+                            m2.fast(i) += delta * (x - mean.fast(i));
+                        }
+                    }
+            };
 
-        template<class T, class E, class M, size_t N>
-            void _enlarge_copy_minus(T&& t, E const& e, M const& m, long axis, utils::int_<N>)
-            {
-                for(long i = 0, n = e.shape[0], p = m.shape[0]; i < n ; ) {
-                    for(long j = 0; j < p; ++j, ++i) {
-                        _enlarge_copy_minus(t.fast(i), e.fast(i), m.fast(j), axis, utils::int_<N - 1>());
+        // store in m2 the sum of squared deviations of e along axis, mean being a scratch buffer of the same shape
+        template<size_t N>
+            struct _var_axis {
+                template<class M, class E>
+                    void operator()(M&& mean, M&& m2, E const& e, long axis) const
+                    {
+                        typedef typename std::remove_reference<M>::type::dtype T;
+                        if(axis == 0)
+                            for(long i = 0; i < e.shape[0]; ++i)
+                                _welford_into<N - 1>()(mean, m2, e.fast(i), T(i + 1), 0, m2.shape[0]);
+                        else
+                            for(long i = 0; i < e.shape[0]; ++i)
+                                _var_axis<N - 1>()(mean.fast(i), m2.fast(i), e.fast(i), axis - 1);
                     }
-                }
+            };
+        template<>
+            struct _var_axis<1> {
+                template<class M, class E>
+                    void operator()(M&&, M&& m2, E const& e, long) const
+                    {
+                        typedef typename std::remove_reference<M>::type T;
+                        m2 = reduce<_welford_op>(e, utils::neutral<_welford_op, _welford<T>>::value()).m2;
+                    }
+            };
+
+        template<class E>
+            typename std::enable_if<E::value == 1, var_type<E>>::type
+            var(E const& expr, long axis, types::none_type dtype = __builtin__::None, types::none_type out = __builtin__::None, long ddof = 0)
+            {
+                if(axis != 0)
+                    throw types::ValueError("axis out of bounds");
+                return var(expr, __builtin__::None, dtype, out, ddof);
             }
 
         template<class E>
-            auto
+            typename std::enable_if<E::value != 1, types::ndarray<var_type<E>, E::value - 1>>::type
             var(E const& expr, long axis, types::none_type dtype = __builtin__::None, types::none_type out = __builtin__::None, long ddof = 0)
-            -> typename assignable<decltype(var_type<E>() * mean(expr, axis))>::type
             {
-                auto m = mean(expr, axis);
+                typedef var_type<E> T;
+                if(axis < 0 || axis >= long(E::value))
+                    throw types::ValueError("axis out of bounds");
+                types::array<long, E::value - 1> shp;
+                auto next = std::copy(expr.shape.begin(), expr.shape.begin() + axis, shp.begin());
+                std::copy(expr.shape.begin() + axis + 1, expr.shape.end(), next);
+                types::ndarray<T, E::value - 1> m2(shp, T(0)), mean(shp, T(0));
+
+                long const size = std::accumulate(expr.shape.begin(), expr.shape.end(), 1L, std::multiplies<long>());
                 if(axis == 0) {
-                    auto t = expr - m ;
-                    return sum(t*t, axis) /= var_type<E>(expr.shape[axis] - ddof);
+                    long const n = m2.shape[0];
+                    long const step = std::max(1L, size ? PYTHRAN_REDUCE_CHUNK * n / size : n);
+#ifdef _OPENMP
+                    #pragma omp parallel for if(utils::omp_worth((n + step - 1) / step, step * expr.shape[0] * (types::expr_cost<E>::value + 4)))
+#endif
+                    for(long j = 0; j < n; j += step)
+                        for(long i = 0; i < expr.shape[0]; ++i)
+                            _welford_into<E::value - 1>()(mean, m2, expr.fast(i), T(i + 1), j, std::min(n, j + step));
                 }
                 else {
-                    types::array<long, E::value> shp;
-                    std::copy(expr.shape.begin(), expr.shape.end(), shp.begin());
-                    shp[axis] = 1;
-                    auto mp = m.reshape(shp);
-
-                    typename assignable<E>::type t{expr.shape, __builtin__::None};
-                    _enlarge_copy_minus(t, expr, mp, axis, utils::int_<E::value>());
-                    return sum(t*t, axis) /= var_type<E>(expr.shape[axis] - ddof);
+#ifdef _OPENMP
+                    #pragma omp parallel for if(utils::omp_worth(expr.shape[0], size / std::max(1L, expr.shape[0]) * (types::expr_cost<E>::value + 4)))
+#endif
+                    for(long i = 0; i < expr.shape[0]; ++i)
+                        _var_axis<E::value - 1>()(mean.fast(i), m2.fast(i), expr.fast(i), axis - 1);
                 }
+                m2 /= T(expr.shape[axis] - ddof);
+                return m2;
             }
 
         PROXY(pythonic::numpy, var);
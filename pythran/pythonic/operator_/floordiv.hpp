@@ -2,25 +2,39 @@
 #define PYTHONIC_OPERATOR_FLOORDIV_HPP
 
 #include "pythonic/utils/proxy.hpp"
+#include "pythonic/numpy/floor_divide.hpp"
 #include <nt2/include/functions/divfloor.hpp>
 
 namespace pythonic {
 
     namespace operator_ {
-        long floordiv(long a, long b) {
-            return std::floor(static_cast<double>(a)/b);
-        }
-        long floordiv(double a, long b) {
-            return std::floor(a/b);
-        }
-
-        long floordiv(long a, double b) {
-            return std::floor(a/b);
-        }
-
-        long floordiv(double a, double b) {
-            return std::floor(a/b);
-        }
+
+        /* Python semantic: round toward negative infinity */
+        template<class A, class B>
+            typename std::enable_if<std::is_integral<A>::value and std::is_integral<B>::value,
+                                    decltype(std::declval<A>() / std::declval<B>())>::type
+            floordiv(A const& a, B const& b)
+            {
+                auto q = a / b;
+                return (a % b != 0 and (a < 0) != (b < 0)) ? q - 1 : q;
+            }
+
+        template<class A, class B>
+            typename std::enable_if<std::is_fundamental<A>::value and std::is_fundamental<B>::value and
+                                    (std::is_floating_point<A>::value or std::is_floating_point<B>::value),
+                                    decltype(std::floor(std::declval<A>() / std::declval<B>()))>::type
+            floordiv(A const& a, B const& b)
+            {
+                return std::floor(a / b);
+            }
+
+        template<class A, class B>
+            auto floordiv(A const& a, B const& b) // for ndarrays
+            -> typename std::enable_if<not std::is_fundamental<A>::value or not std::is_fundamental<B>::value,
+                                       decltype(numpy::proxy::floor_divide()(a, b))>::type
+            {
+                return numpy::proxy::floor_divide()(a, b);
+            }
         PROXY(pythonic::operator_, floordiv);
 
     }
@@ -4,25 +4,31 @@
 #include "pythonic/utils/proxy.hpp"
 #include "pythonic/types/str.hpp"
 
+#ifdef USE_BOOST_SIMD
+#include <boost/simd/sdk/simd/native.hpp>
+#include <nt2/include/functions/floor.hpp>
+#endif
+
 namespace pythonic {
 
     namespace operator_ {
 
+        /* Python semantic: the result has the sign of the divisor */
         template <class A, class B>
             auto mod(A const& a, B const& b)
             -> typename std::enable_if<std::is_fundamental<A>::value and std::is_fundamental<B>::value,
                                        decltype(a % b)>::type
             {
                 auto t = a % b;
-                return t < 0 ? (t + b) : t;
+                return (t != 0 and (t < 0) != (b < 0)) ? (t + b) : t;
             }
         inline double mod(double a, long b) {
             auto t = std::fmod(a, double(b));
-            return t < 0 ? (t + b) : t;
+            return (t != 0 and (t < 0) != (b < 0)) ? (t + b) : t;
         }
         inline double mod(double a, double b) {
             auto t = std::fmod(a, b);
-            return t < 0 ? (t + b) : t;
+            return (t != 0 and (t < 0) != (b < 0)) ? (t + b) : t;
         }
         template<class A, class B>
             auto mod(A const& a, B const& b) // for ndarrays
@@ -31,6 +37,19 @@ namespace pythonic {
             {
                 return a % b;
             }
+#ifdef USE_BOOST_SIMD
+        /* vector form, used when a floating point modulo appears in a
+         * vectorized numpy expression. It computes a - floor(a / b) * b, which
+         * may differ from the scalar form in the last bit for large quotients.
+         * Integer modulo has no vector form, see is_vector_op.
+         */
+        template<class T, class X>
+            typename std::enable_if<std::is_floating_point<T>::value, boost::simd::native<T, X>>::type
+            mod(boost::simd::native<T, X> const& a, boost::simd::native<T, X> const& b)
+            {
+                return a - nt2::floor(a / b) * b;
+            }
+#endif
         PROXY(pythonic::operator_, mod);
     }
 
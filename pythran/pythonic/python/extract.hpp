@@ -2,8 +2,19 @@
 #define PYTHONIC_PYTHON_EXTRACT_HPP
 
 #include <boost/python/extract.hpp>
+#include <boost/python/object.hpp>
 
+#include <complex>
+
+/* Element-wise conversions between CPython objects and pythran values
+ *
+ * Containers convert each of their elements through extract and to_python.
+ * Scalar types are converted through the CPython API when the object has
+ * exactly the expected type, and through boost::python otherwise, so that
+ * subclasses, numpy scalars and type errors are still handled by boost.
+ */
 namespace pythonic {
+
     template<class T>
         struct _extract {
             T operator()(PyObject* obj) {
@@ -21,17 +32,88 @@ namespace pythonic {
     template<>
         struct _extract<long> {
             long operator()(PyObject* obj) {
-                return PyInt_AS_LONG(obj);
+                if(PyInt_CheckExact(obj))
+                    return PyInt_AS_LONG(obj);
+                else
+                    return boost::python::extract<long>(obj);
             }
         };
 
     template<>
         struct _extract<double> {
             double operator()(PyObject* obj) {
-                if(PyFloat_Check(obj))
+                if(PyFloat_CheckExact(obj))
                     return PyFloat_AS_DOUBLE(obj);
-                else
+                else if(PyInt_CheckExact(obj))
                     return PyInt_AS_LONG(obj);
+                else
+                    return boost::python::extract<double>(obj);
+            }
+        };
+
+    template<>
+        struct _extract<bool> {
+            bool operator()(PyObject* obj) {
+                if(obj == Py_True)
+                    return true;
+                else if(obj == Py_False)
+                    return false;
+                else
+                    return boost::python::extract<bool>(obj);
+            }
+        };
+
+    template<>
+        struct _extract<std::complex<double>> {
+            std::complex<double> operator()(PyObject* obj) {
+                if(PyComplex_CheckExact(obj)) {
+                    Py_complex c = reinterpret_cast<PyComplexObject*>(obj)->cval;
+                    return std::complex<double>(c.real, c.imag);
+                }
+                else
+                    return boost::python::extract<std::complex<double>>(obj);
+            }
+        };
+
+    /* new reference to a python object holding a copy of v */
+    template<class T>
+        struct _to_python {
+            PyObject* operator()(T const& v) {
+                return boost::python::incref(boost::python::object(v).ptr());
+            }
+        };
+
+    template<class T>
+        inline PyObject* to_python(T const& v) {
+            return _to_python<T>()(v);
+        }
+
+    template<>
+        struct _to_python<long> {
+            PyObject* operator()(long v) {
+                return PyInt_FromLong(v);
+            }
+        };
+
+    template<>
+        struct _to_python<double> {
+            PyObject* operator()(double v) {
+                return PyFloat_FromDouble(v);
+            }
+        };
+
+    // also used for the proxies returned by std::vector<bool>
+    template<>
+        struct _to_python<bool> {
+            PyObject* operator()(bool v) {
+                return PyBool_FromLong(v);
+            }
+        };
+
+    template<>
+        struct _to_python<std::complex<double>> {
+            PyObject* operator()(std::complex<double> const& v) {
+                return PyComplex_FromDoubles(v.real(), v.imag());
             }
         };
 }
@@ -3,6 +3,7 @@
 
 #include "pythonic/utils/proxy.hpp"
 #include "pythonic/random/random.hpp"
+#include "pythonic/__builtin__/IndexError.hpp"
 
 namespace pythonic {
 
@@ -10,7 +11,9 @@ namespace pythonic {
 
         template<class Seq>
             typename Seq::value_type choice(Seq const& seq){
-                return seq[long(random() * seq.size())];
+                if(seq.size() == 0)
+                    throw types::IndexError("Cannot choose from an empty sequence");
+                return seq[utils::random_engine().below(seq.size())];
             }
         PROXY(pythonic::random, choice);
 
@@ -8,7 +8,7 @@ namespace pythonic {
 
     namespace random {
         double expovariate(double l) {
-            return std::exponential_distribution<>(l)(__random_generator);
+            return utils::random_engine().exponential() / l;
         }
         PROXY(pythonic::random, expovariate);
 
@@ -8,7 +8,7 @@ namespace pythonic {
 
     namespace random {
         double gauss(double mu, double sigma) {
-            return std::normal_distribution<>(mu, sigma)(__random_generator);
+            return mu + sigma * utils::random_engine().normal();
         }
         PROXY(pythonic::random, gauss);
 
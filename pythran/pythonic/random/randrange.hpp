@@ -3,22 +3,26 @@
 
 #include "pythonic/utils/proxy.hpp"
 #include "pythonic/random/random.hpp"
-
-#include <cmath>
+#include "pythonic/__builtin__/ValueError.hpp"
 
 namespace pythonic {
 
     namespace random {
-        long randrange(long stop) {
-            return long(random() * stop);
+        long randrange(long start, long stop, long step) {
+            if(step == 0)
+                throw types::ValueError("zero step for randrange()");
+            long n = (stop - start + step - (step > 0 ? 1 : -1)) / step;
+            if(n <= 0)
+                throw types::ValueError("empty range for randrange()");
+            return start + step * long(utils::random_engine().below(n));
         }
 
         long randrange(long start, long stop) {
-            return start + long(random() * (stop - start));
+            return randrange(start, stop, 1);
         }
 
-        long randrange(long start, long stop, long step) {
-            return start + step * long((random() * (stop - start)) / std::abs(step));
+        long randrange(long stop) {
+            return randrange(0, stop, 1);
         }
         PROXY(pythonic::random, randrange)
 
@@ -5,6 +5,9 @@
 #include "pythonic/random/random.hpp"
 
 #include "pythonic/types/list.hpp"
+#include "pythonic/__builtin__/ValueError.hpp"
+
+#include <numeric>
 
 namespace pythonic {
 
@@ -14,12 +17,18 @@ namespace pythonic {
             sample(Iterable&& s, size_t k) {
                 typedef typename std::remove_cv<typename std::remove_reference<Iterable>::type>::type::iterator::value_type value_type;
                 types::list<value_type> tmp(s);
-                std::vector<size_t> indices(tmp.size());
+                size_t n = tmp.size();
+                if(k > n)
+                    throw types::ValueError("sample larger than population");
+                // partial Fisher-Yates: only the first k draws are needed
+                std::vector<size_t> indices(n);
                 std::iota(indices.begin(), indices.end(), 0);
-                std::random_shuffle(indices.begin(), indices.end());
+                utils::philox4x32& engine = utils::random_engine();
                 types::list<value_type> out(k);
-                for(size_t i=0; i<k; i++)
+                for(size_t i=0; i<k; i++) {
+                    std::swap(indices[i], indices[i + engine.below(n - i)]);
                     out[i] = tmp[ indices[i] ];
+                }
                 return out;
             }
         PROXY(pythonic::random, sample);
@@ -10,8 +10,8 @@
 namespace pythonic {
 
     namespace random {
-        types::none_type seed(long s) { __random_generator.seed(s); return __builtin__::None; }
-        types::none_type seed() { __random_generator.seed(time(nullptr)); return __builtin__::None; }
+        types::none_type seed(long s) { utils::seed_random(s); return __builtin__::None; }
+        types::none_type seed() { utils::seed_random(time(nullptr)); return __builtin__::None; }
 
         PROXY(pythonic::random, seed);
 
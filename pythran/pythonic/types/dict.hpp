@@ -9,6 +9,7 @@
 #include "pythonic/utils/shared_ref.hpp"
 #include "pythonic/utils/iterator.hpp"
 #include "pythonic/utils/reserve.hpp"
+#include "pythonic/utils/flat_hash.hpp"
 
 #include "pythonic/__builtin__/None.hpp"
 
@@ -18,7 +19,9 @@
 #include <limits>
 #include <algorithm>
 #include <iterator>
+#ifdef PYTHRAN_DICT_UNORDERED_MAP
 #include <boost/unordered_map.hpp>
+#endif
 
 
 namespace  pythonic {
@@ -93,7 +96,11 @@ namespace  pythonic {
                 // data holder
                 typedef  typename std::remove_cv< typename std::remove_reference<K>::type>::type  _key_type;
                 typedef  typename std::remove_cv< typename std::remove_reference<V>::type>::type  _value_type;
+#ifdef PYTHRAN_DICT_UNORDERED_MAP
                 typedef boost::unordered_map< _key_type, _value_type > container_type;
+#else
+                typedef utils::flat_map< _key_type, _value_type > container_type;
+#endif
                 utils::shared_ref<container_type> data; 
 
 
@@ -154,6 +161,9 @@ namespace  pythonic {
 
                 void clear() { return data->clear(); }
 
+                // make room for n items without rehashing
+                void reserve(size_t n) { data->reserve(n); }
+
                 dict<K,V> copy() const{
                     return dict<K,V>(this->item_begin(), this->item_end());
                 }
@@ -279,6 +289,16 @@ namespace  pythonic {
             };
     }
 
+    namespace utils {
+
+        template <class K, class V, class From>
+            void reserve(types::dict<K,V> & d, From const &f, typename From::const_iterator p=typename From::const_iterator())
+            {
+                d.reserve(len(f));
+            }
+
+    }
+
     template<class K,class V>
         struct assignable<types::dict<K,V> >{
             typedef types::dict<typename assignable<K>::type,typename assignable<V>::type > type;
@@ -500,18 +520,12 @@ namespace pythonic {
                 void* storage=((boost::python::converter::rvalue_from_python_storage<types::dict<K,V> >*)(data))->storage.bytes;
                 new (storage) types::dict<K,V>(types::empty_dict());
                 types::dict<K,V>& v=*(types::dict<K,V>*)(storage);
+                v.reserve(PyDict_Size(obj_ptr));
 
                 PyObject *key, *value;
                 Py_ssize_t pos = 0;
-                /* first round use boost version that performs a lot of check
-                 * then we rely on faster but less secure version
-                 */
-                if(PyDict_Next(obj_ptr, &pos, &key, &value)) {
-                    v[boost::python::extract<K>(key)] = boost::python::extract<V>(value);
-                    while(PyDict_Next(obj_ptr, &pos, &key, &value)) {
-                        v[extract<K>(key)] = extract<V>(value);
-                    }
-                }
+                while(PyDict_Next(obj_ptr, &pos, &key, &value))
+                    v[extract<K>(key)] = extract<V>(value);
                 data->convertible=storage;
             }
         };
@@ -519,8 +533,13 @@ namespace pythonic {
         struct custom_pythran_dict_to_dict{
             static PyObject* convert(const types::dict<K,V>& v){
                 PyObject* ret = PyDict_New();
-                for(auto kv=v.item_begin(); kv != v.item_end(); ++kv)
-                    PyDict_SetItem(ret, boost::python::incref(boost::python::object(kv->first).ptr()), boost::python::incref(boost::python::object(kv->second).ptr()));
+                for(auto kv=v.item_begin(); kv != v.item_end(); ++kv) {
+                    PyObject* key = to_python<K>(kv->first);
+                    PyObject* value = to_python<V>(kv->second);
+                    PyDict_SetItem(ret, key, value); // does not steal references
+                    Py_DECREF(key);
+                    Py_DECREF(value);
+                }
                 return ret;
             }
         };
@@ -12,12 +12,18 @@
 #include "pythonic/__builtin__/RuntimeError.hpp"
 #include "pythonic/__builtin__/StopIteration.hpp"
 
+#include <algorithm>
 #include <fstream>
 #include <iterator>
+#include <cerrno>
 #include <cstring>
 #include <string>
 #include <cstdio>
 #include <unistd.h>
+#include <sys/stat.h>
+#ifdef PYTHRAN_FILE_PREFETCH
+#include <future>
+#endif
 
 namespace pythonic {
 
@@ -25,12 +31,15 @@ namespace pythonic {
         class file;
 
 
-        struct file_iterator : std::iterator< std::forward_iterator_tag, types::str, ptrdiff_t, types::str*, types::str /* no ref */ >
+        /* Lines are borrowed views of the read buffer of the file, valid
+         * until the iterator moves: loops bind them by reference, and a line
+         * that outlives its iteration is copied on the way out.
+         */
+        struct file_iterator : std::iterator< std::forward_iterator_tag, types::str, ptrdiff_t, types::str const*, types::str const& >
         {
             private:
-                file & f;
+                file * f; // null at end of file
                 types::str curr;
-                int position;
 
             public:
                 typedef types::str value_type;
@@ -45,14 +54,171 @@ namespace pythonic {
                 types::str const& operator*() const;
         };
 
+#ifndef PYTHRAN_FILE_BUFFER_SIZE
+#define PYTHRAN_FILE_BUFFER_SIZE (1 << 17)
+#endif
+
+        /* Stdio stream and line reader
+         *
+         * Lines are read by blocks into a buffer and handed out as views of
+         * it, or as inline strings when short enough, so that reading a line
+         * does not allocate. The buffer is refilled in place once no line
+         * refers to it anymore, otherwise a new one is allocated. Reads and
+         * tell start from the bytes read ahead; before other operations on the
+         * stream, these bytes are given back to it by seeking backward, which
+         * fails on pipes. With PYTHRAN_FILE_PREFETCH, the next block is read by
+         * another thread while the current one is consumed.
+         */
         struct _file{
+            typedef std::string buffer_type;
+            static const size_t block_size = PYTHRAN_FILE_BUFFER_SIZE;
+
             FILE* f;
-            char* _buffer; // Buffer used by file.readline()
-            size_t _buffer_size;
-            _file() : f(nullptr), _buffer(nullptr), _buffer_size(0){}
-            _file(types::str const& filename, types::str const& strmode = "r") : f(fopen(filename.c_str(), strmode.c_str())), _buffer(nullptr), _buffer_size(0){}
+            utils::shared_ref<buffer_type> buffer;
+            size_t begin, end; // bytes of buffer not consumed yet
+#ifdef PYTHRAN_FILE_PREFETCH
+            buffer_type next_block;
+            std::future<size_t> prefetched;
+#endif
+
+            _file() : f(nullptr), buffer(utils::no_memory()), begin(0), end(0) {}
+            _file(types::str const& filename, types::str const& strmode = "r") : f(fopen(filename.c_str(), strmode.c_str())), buffer(utils::no_memory()), begin(0), end(0) {}
             FILE* operator*() const {return f;}
-            ~_file() {if(f) fclose(f); if (_buffer) free(_buffer);}
+            ~_file() {
+                if(f) close();
+            }
+
+            // drops the bytes read ahead, that are not needed anymore
+            void close() {
+#ifdef PYTHRAN_FILE_PREFETCH
+                if(prefetched.valid())
+                    prefetched.wait();
+#endif
+                begin = end = 0;
+                fclose(f);
+                f = nullptr;
+            }
+
+            // reads the next block after the n bytes at the start of buffer
+            size_t read_block(size_t n) {
+#ifdef PYTHRAN_FILE_PREFETCH
+                if(not prefetched.valid())
+                    prefetch();
+                size_t m = prefetched.get();
+                std::memcpy(&(*buffer)[n], next_block.data(), m);
+                if(m)
+                    prefetch();
+                return m;
+#else
+                return fread(&(*buffer)[n], 1, block_size, f);
+#endif
+            }
+
+#ifdef PYTHRAN_FILE_PREFETCH
+            void prefetch() {
+                next_block.resize(block_size);
+                prefetched = std::async(std::launch::async, [this]() { return fread(&next_block[0], 1, block_size, f); });
+            }
+#endif
+
+            // moves the unconsumed bytes to the start of a buffer and reads a block after them
+            bool fill() {
+                size_t pending = end - begin;
+                if(buffer and buffer.unique() and buffer->size() >= pending + block_size)
+                    std::memmove(&(*buffer)[0], buffer->data() + begin, pending);
+                else {
+                    buffer_type fresh(std::max(2 * block_size, pending + block_size), '\0');
+                    if(pending)
+                        std::memcpy(&fresh[0], buffer->data() + begin, pending);
+                    buffer = utils::shared_ref<buffer_type>(std::move(fresh));
+                }
+                begin = 0;
+                end = pending;
+                size_t n = read_block(pending);
+                end += n;
+                return n;
+            }
+
+            /* Next line, newline included, limited to size characters
+             *
+             * Returns false at end of file. Long lines share the buffer, as
+             * borrowed views if so requested.
+             */
+            bool next_line(types::str& out, size_t size, bool borrowed) {
+                size_t scanned = 0, n;
+                while(true) {
+                    size_t available = std::min(end - begin, size);
+                    if(available > scanned) {
+                        char const* first = buffer->data() + begin;
+                        if(void const* eol = std::memchr(first + scanned, '\n', available - scanned)) {
+                            n = static_cast<char const*>(eol) + 1 - first;
+                            break;
+                        }
+                    }
+                    if(available == size) {
+                        n = size;
+                        break;
+                    }
+                    // the pending bytes hold no newline, no need to scan them again
+                    scanned = available;
+                    if(not fill()) {
+                        if(begin == end) {
+                            out = types::str();
+                            return false;
+                        }
+                        n = end - begin;
+                        break;
+                    }
+                }
+                out.view(buffer, begin, n, borrowed);
+                begin += n;
+                return true;
+            }
+
+            // puts the block being prefetched after the bytes read ahead
+            void settle() {
+#ifdef PYTHRAN_FILE_PREFETCH
+                if(not prefetched.valid())
+                    return;
+                if(size_t m = prefetched.get()) {
+                    size_t pending = end - begin;
+                    buffer_type fresh(pending + m, '\0');
+                    if(pending)
+                        std::memcpy(&fresh[0], buffer->data() + begin, pending);
+                    std::memcpy(&fresh[pending], next_block.data(), m);
+                    buffer = utils::shared_ref<buffer_type>(std::move(fresh));
+                    begin = 0;
+                    end = pending + m;
+                }
+#endif
+            }
+
+            // reads up to n bytes, starting with those read ahead
+            size_t read(char* out, size_t n) {
+                settle();
+                size_t ahead = std::min(end - begin, n);
+                if(ahead) {
+                    std::memcpy(out, buffer->data() + begin, ahead);
+                    begin += ahead;
+                }
+                return ahead + fread(out + ahead, 1, n - ahead, f);
+            }
+
+            // position of the next byte to consume, -1 if the stream has none
+            off_t tell() {
+                settle();
+                off_t position = ftello(f);
+                return position == -1 ? -1 : position - off_t(end - begin);
+            }
+
+            // gives the bytes read ahead back to the stream
+            void sync() {
+                settle();
+                off_t ahead = end - begin;
+                if(ahead and fseeko(f, -ahead, SEEK_CUR) == -1)
+                    throw ValueError("Mixing iteration and read methods would lose data");
+                begin = end = 0;
+            }
         };
 
         class file {
@@ -80,7 +246,8 @@ namespace pythonic {
 
             // Modifiers
             void open(types::str const& filename, types::str const& strmode) {
-                const char *smode = strmode.c_str();
+                types::str::c_string const mode = strmode.c_str();
+                const char *smode = mode;
                 // Python enforces that the mode, after stripping 'U', begins with 'r', 'w' or 'a'.
                 if(*smode=='U') {++smode;}// Not implemented yet
 
@@ -91,8 +258,7 @@ namespace pythonic {
             }
 
             void close() {
-                fclose(**data);
-                data->f = nullptr;
+                data->close();
                 is_open = false;
             }
 
@@ -114,6 +280,9 @@ namespace pythonic {
             }
 
             bool eof() {
+                data->settle();
+                if(data->begin != data->end)
+                    return false;
                 return ::feof(**data);
             }
 
@@ -133,68 +302,78 @@ namespace pythonic {
             }
 
             types::str next() {
-                if(not is_open) throw ValueError("I/O operation on closed file");
-                if (feof(**data) && mode.find_first_of("ra") == std::string::npos) {
-                    // If we are at eof on reading mode throw exception
+                types::str line = readline();
+                if(not line)
                     throw StopIteration("file.next() : EOF reached.");
-                }
-                return readline();
+                return line;
             }
 
             types::str read(int size = -1) {
                 if(not is_open) throw ValueError("I/O operation on closed file");
                 if (mode.find_first_of("r+") == std::string::npos)
                     throw IOError("File not open for reading");
-                if (size == 0 or (feof(**data) && mode.find_first_of("ra") == std::string::npos) ) return types::str();
-                int curr_pos = tell();
-                seek(0, SEEK_END);
-                size = size < 0 ? tell() - curr_pos : size;
-                seek(curr_pos);
-                char *content = new char[size+1];
-                // This part needs a new implementation of types::str(char*) to avoid unnecessary copy.
-                types::str res(content, fread(content, sizeof(char), size, **data));
-                delete[] content;
-                return res;
+                std::string content;
+                if(size >= 0) {
+                    content.resize(size);
+                    content.resize(data->read(&content[0], size));
+                }
+                else {
+                    // up to the end of the file, which may have no size
+                    size_t n = 0;
+                    do {
+                        content.resize(n + _file::block_size);
+                        n += data->read(&content[n], _file::block_size);
+                    } while(n == content.size());
+                    content.resize(n);
+                }
+                return types::str(std::move(content));
             }
 
             types::str readline(ssize_t size=std::numeric_limits<ssize_t>::max()) {
                 if(not is_open) throw ValueError("I/O operation on closed file");
                 if (mode.find_first_of("r+") == std::string::npos)
                     throw IOError("File not open for reading");
-                if(size == 0) return types::str();
-                // if(size < 0) return readline(); // Already checked in module/file.h
-                // Getline will always realloc content to store full string.
-                // => Emulating expected behaviour
-                ssize_t real_size = getline(&data->_buffer, &data->_buffer_size, **data);
-                if (real_size > size){
-                    fseek(**data, -(long)(real_size - size), SEEK_CUR);
-                }
-                // This part needs a new implementation of types::str(char*, size_t) to avoid unnecessary copy.
-                if(real_size>0) return types::str(data->_buffer, std::min(real_size, size));
-                else return types::str();
+                types::str line;
+                if(size > 0)
+                    data->next_line(line, size, true);
+                // long lines are copied out of the buffer
+                return types::str(line);
             }
 
             types::list<types::str> readlines(int sizehint = -1) {
                 // Official python doc specifies that sizehint is used as a max of chars
                 // But it has not been implemented in the standard python interpreter...
-                types::str str;
+                if(not is_open) throw ValueError("I/O operation on closed file");
+                if (mode.find_first_of("r+") == std::string::npos)
+                    throw IOError("File not open for reading");
+                // lines keep the buffers they come from, which they fill
+                types::str line;
                 types::list<types::str> lst(0);
-                while((str=readline())){
-                    lst.push_back(str);
-                }
+                while(data->next_line(line, types::str::npos, false))
+                    lst.push_back(line);
                 return lst;
             }
 
+            // next line as a borrowed view, see file_iterator
+            bool next_line(types::str& line) {
+                if(not is_open) throw ValueError("I/O operation on closed file");
+                if (mode.find_first_of("r+") == std::string::npos)
+                    throw IOError("File not open for reading");
+                line = types::str();
+                return data->next_line(line, types::str::npos, true);
+            }
+
             void seek(int offset, int whence = SEEK_SET) {
                 if(not is_open) throw ValueError("I/O operation on closed file");
                 if(whence != SEEK_SET && whence != SEEK_CUR && whence != SEEK_END)
                     throw IOError("file.seek() :  Invalid argument.");
+                data->sync();
                 fseek(**data, offset, whence);
             }
 
             int tell() const {
                 if(not is_open) throw ValueError("I/O operation on closed file");
-                return ftell(**data);
+                return data->tell();
             }
 
             void truncate(int size = -1){
@@ -211,7 +390,39 @@ namespace pythonic {
                 if(not is_open) throw ValueError("I/O operation on closed file");
                 if (mode.find_first_of("wa+") == std::string::npos) 
                     throw IOError("file.write() :  File not opened for writing.");
-                fwrite(str.c_str(), sizeof(char), str.size(), **data);
+                data->sync();
+                fwrite(str.data(), sizeof(char), str.size(), **data);
+            }
+
+            /* Raw reads and writes, for binary array I/O
+             *
+             * They go through the stdio buffer, so that they can be mixed with
+             * the other methods, and use 64 bit offsets for large files.
+             */
+            size_t read_bytes(void* out, size_t n) {
+                if(not is_open) throw ValueError("I/O operation on closed file");
+                if (mode.find_first_of("r+") == std::string::npos)
+                    throw IOError("File not open for reading");
+                return data->read(static_cast<char*>(out), n);
+            }
+
+            void write_bytes(void const* in, size_t n) {
+                if(not is_open) throw ValueError("I/O operation on closed file");
+                if (mode.find_first_of("wa+") == std::string::npos)
+                    throw IOError("file.write() :  File not opened for writing.");
+                data->sync();
+                if(fwrite(in, 1, n, **data) != n)
+                    throw IOError(strerror(errno));
+            }
+
+            // number of bytes between the current position and the end of the file
+            size_t remaining() const {
+                if(not is_open) throw ValueError("I/O operation on closed file");
+                struct stat st;
+                off_t position = data->tell();
+                if(fstat(fileno(), &st) == -1 or position == -1)
+                    throw IOError(strerror(errno));
+                return st.st_size > position ? st.st_size - position : 0;
             }
 
             template<class T>
@@ -223,24 +434,25 @@ namespace pythonic {
         };
 
         // file_iterator implementation
-        file_iterator::file_iterator(file & ref) : f(ref), curr(ref.readline()), position(ref.tell()) {};
-        file_iterator::file_iterator(file & ref, npos) : f(ref), curr(), position(-1) {};
+        file_iterator::file_iterator(file & ref) : f(&ref), curr() {
+            if(not ref.next_line(curr))
+                f = nullptr;
+        }
+        file_iterator::file_iterator(file & ref, npos) : f(nullptr), curr() {}
         bool file_iterator::operator==(file_iterator const& f2) const{
-            return position == f2.position;
+            return f == f2.f;
         }
         bool file_iterator::operator!=(file_iterator const& f2) const{
-            return position != f2.position;
+            return f != f2.f;
         }
         bool file_iterator::operator<(file_iterator const& f2) const{
             // Not really elegant...
             // Equivalent to 'return *this != f2;'
-            return  position != f2.position;
+            return f != f2.f;
         }
         file_iterator& file_iterator::operator++(){
-            // Check if ftell == -1 when fgetpos(FILE *stream, fpos_t eof) == 0
-            if(f.eof()) return *this; 
-            curr = f.readline();
-            position = f.eof() ? -1 : f.tell();
+            if(f and not f->next_line(curr))
+                f = nullptr;
             return *this;
         }
         types::str const &file_iterator::operator*() const{
@@ -547,29 +547,7 @@ namespace pythonic {
                 Py_ssize_t n = v.size();
                 PyObject* ret = PyList_New(n);
                 for(Py_ssize_t i=0;i<n;i++)
-                    PyList_SET_ITEM(ret, i, boost::python::incref(boost::python::object(v[i]).ptr()));
-                return ret;
-            }
-        };
-
-  /*
-   This specialization is a workaround for a boost::python bug triggered when
-   using std::vector<bool> and libc++.
-   Indeed v[i] returns a wrapper class to keep a reference to the bit in the 
-   bitset. The issue is that operator& is overloaded and prevent taking the
-   address of the wrapper class.
-   This is a copy paste of the generic case, plus a cast to (bool) to get rid
-   of the wrapper.
-   The cast can't be added to the generic version because casting may trigger
-   an extra copy that is not what we want for heavy objects
-   */
-    template<>
-        struct custom_pythran_list_to_list<bool> {
-            static PyObject* convert(const types::list<bool>& v){
-                Py_ssize_t n = v.size();
-                PyObject* ret = PyList_New(n);
-                for(Py_ssize_t i=0;i<n;i++)
-                    PyList_SET_ITEM(ret, i, boost::python::incref(boost::python::object((bool)v[i]).ptr()));
+                    PyList_SET_ITEM(ret, i, to_python<T>(v[i]));
                 return ret;
             }
         };
@@ -599,19 +577,24 @@ namespace pythonic {
             }
             static void construct(PyObject* obj_ptr, boost::python::converter::rvalue_from_python_stage1_data* data){
                 void* storage=((boost::python::converter::rvalue_from_python_storage<types::list<T> >*)(data))->storage.bytes;
-                Py_ssize_t l = PySequence_Fast_GET_SIZE(obj_ptr);
+                // lists and tuples are read in place, other sequences are turned into one first
+                PyObject* seq = PySequence_Fast(obj_ptr, "expected a sequence");
+                if(not seq)
+                    boost::python::throw_error_already_set();
+                Py_ssize_t l = PySequence_Fast_GET_SIZE(seq);
                 types::list<T>& v = *(new (storage) types::list<T>(l));
-                PyObject** core = PySequence_Fast_ITEMS(obj_ptr);
-                /* Perform extraction using boost version first, has it does more checks
-                 * then go wild and use our custom & faster extractor
-                 */
-                auto iter = v.begin(), end = v.end();
-                if(iter != end) {
-                    *iter = boost::python::extract<T>(*core++);
-                    while(++iter != end) {
+                PyObject** core = PySequence_Fast_ITEMS(seq);
+                try {
+                    for(auto iter = v.begin(), end = v.end(); iter != end; ++iter)
                         *iter = extract<T>(*core++);
-                    }
                 }
+                catch(...) {
+                    // boost only destroys the storage of successful conversions
+                    v.~list();
+                    Py_DECREF(seq);
+                    throw;
+                }
+                Py_DECREF(seq);
                 data->convertible = storage;
             }
         };
@@ -16,7 +16,9 @@
 #include "pythonic/types/list.hpp"
 #include "pythonic/types/raw_array.hpp"
 
+#include "pythonic/types/traits.hpp"
 #include "pythonic/types/vectorizable_type.hpp"
+#include "pythonic/types/op_cost.hpp"
 #include "pythonic/types/numexpr_to_ndarray.hpp"
 #include "pythonic/types/numpy_fexpr.hpp"
 #include "pythonic/types/numpy_expr.hpp"
@@ -33,6 +35,7 @@
 #include <array>
 #include <initializer_list>
 #include <numeric>
+#include <cstdlib>
 
 #ifdef ENABLE_PYTHON_MODULE
 #define NPY_NO_DEPRECATED_API NPY_1_7_API_VERSION
@@ -47,6 +50,8 @@
 #include <boost/simd/sdk/simd/native.hpp>
 #include <boost/simd/include/functions/load.hpp>
 #include <boost/simd/include/functions/store.hpp>
+#include <boost/simd/include/functions/aligned_load.hpp>
+#include <boost/simd/include/functions/aligned_store.hpp>
 #endif
 
 namespace pythonic {
@@ -65,7 +70,10 @@ namespace pythonic {
          */
         template<class T>
             struct broadcasted {
-                static const bool is_vectorizable = false;
+                // each row is the broadcast value itself, which gets loaded in vector form
+                static const bool is_vectorizable = T::is_vectorizable;
+                static const bool is_aligned = false;
+                static const long cost = T::cost;
                 typedef typename T::dtype dtype;
                 typedef typename T::value_type value_type;
                 static constexpr size_t value = T::value + 1;
@@ -81,7 +89,7 @@ namespace pythonic {
                 T const & operator[](long i) const { return ref;}
                 T const & fast(long i) const { return ref;}
 #ifdef USE_BOOST_SIMD
-                template<class I> // template to prevent automatic instantiation, but the declaration is still needed
+                template<class I> // rows are loaded through fast(), never the broadcasted value as a whole
                 void load(I) const {
                   typedef typename T::this_should_never_happen omg;
                 }
@@ -96,17 +104,26 @@ namespace pythonic {
          * Have them behave like infinite arrays of that value
          *
          * B is the original type of the broadcast value, and T is the type of the expression it is combined with
-         * if both B and T are integer types, we choose T instead of B to prevent automatic conversion into larger types
+         * if B is not of a higher kind than T (integer < floating point < complex), we choose T instead of B to
+         * prevent automatic conversion into larger types
          *
-         * That way, np.ones(10, dtype=np.uint8) + 1 yields an array of np.uint8, although 1 is of type long
+         * That way, np.ones(10, dtype=np.uint8) + 1 yields an array of np.uint8, although 1 is of type long, and
+         * np.ones(10, dtype=np.float32) * 2. yields an array of np.float32 that is evaluated in vector form
          */
+        template<class T>
+            struct dtype_kind {
+                static const int value = is_complex<T>::value ? 2 : (std::is_floating_point<T>::value ? 1 : 0);
+            };
+
         template<class T, class B>
             struct broadcast {
                 // Perform the type conversion here if it seems valid (although it is not always)
-                typedef typename std::conditional<std::numeric_limits<T>::is_integer and std::numeric_limits<B>::is_integer,
+                typedef typename std::conditional<(dtype_kind<B>::value <= dtype_kind<T>::value),
                                           T,
                                           typename __combined<T, B>::type>::type dtype;
                 static const bool is_vectorizable = types::is_vectorizable<dtype>::value;
+                static const bool is_aligned = true;
+                static const long cost = 0;
                 typedef dtype value_type;
                 static constexpr size_t value = 0;
                 dtype _value;
@@ -130,7 +147,10 @@ namespace pythonic {
 #ifdef USE_BOOST_SIMD
                 template<class I>
                 auto load(I) const -> decltype(this -> _splated) { return _splated; }
+                template<class I>
+                auto aligned_load(I) const -> decltype(this -> _splated) { return _splated; }
 #endif
+                bool aligned() const { return true; }
                 long size() const { return 0; }
             };
 
@@ -276,6 +296,8 @@ namespace pythonic {
         template<class T, size_t N>
             struct ndarray {
                 static const bool is_vectorizable = types::is_vectorizable<T>::value;
+                static const bool is_aligned = true; // if allocated by pythran, see aligned()
+                static const long cost = 1;
 
                 /* types */
                 static constexpr size_t value = N;
@@ -385,7 +407,7 @@ namespace pythonic {
                         buffer(mem->data),
                         shape(expr.shape)
                 {
-                    initialize_from_expr(expr);
+                    expr.transpose_into(buffer);
                 }
 
                 template<class Op, class Arg>
@@ -517,7 +539,18 @@ namespace pythonic {
                   typedef typename boost::simd::native<T, BOOST_SIMD_DEFAULT_EXTENSION> vT;
                   boost::simd::store<vT>(v, buffer, i);
                 }
+                // only valid if aligned() holds and i is a multiple of the vector size
+                auto aligned_load(long i) const -> decltype(boost::simd::aligned_load<boost::simd::native<T, BOOST_SIMD_DEFAULT_EXTENSION>>(buffer, i)) {
+                    return boost::simd::aligned_load<boost::simd::native<T, BOOST_SIMD_DEFAULT_EXTENSION>>(buffer,i);
+                }
+                template<class V>
+                void aligned_store(V &&v, long i) {
+                  typedef typename boost::simd::native<T, BOOST_SIMD_DEFAULT_EXTENSION> vT;
+                  boost::simd::aligned_store<vT>(v, buffer, i);
+                }
 #endif
+                // true if the buffer is aligned and padded, which is not the case of foreign data
+                bool aligned() const { return mem->padded; }
 
                 /* slice indexing */
                 numpy_gexpr<ndarray const &, slice> operator[](slice const& s) const
@@ -1053,15 +1086,15 @@ namespace pythonic {
                   return 0;
                 if(PyArray_NDIM(arr_ptr) != N)
                     return 0;
+                // strided arrays are accepted by the numpy_gexpr and numpy_texpr
+                // converters, when the export signature allows it
                 long * stride = PyArray_STRIDES(arr_ptr);
                 long * dims = PyArray_DIMS(arr_ptr);
                 long current_stride = PyArray_ITEMSIZE(arr_ptr);
                 for(long i=N-1; i>=0; i--)
                 {
-                    if(stride[i] != current_stride) {
-                        std::cerr << "Not implemented : sliced array as input" << std::endl;
+                    if(stride[i] != current_stride)
                         return 0;
-                    }
                     current_stride *= dims[i];
                 }
                 return obj_ptr;
@@ -1076,6 +1109,146 @@ namespace pythonic {
             }
         };
 
+    /* Describes the memory of a strided array as a slice of a contiguous array
+     * sharing the same memory: fills the shape of that array, then the lower
+     * bound and step of the slice along each dimension.
+     * Returns the address of the first element of the contiguous array, or
+     * nullptr when the strides do not fit, that is when a stride is not a
+     * multiple of the span of the inner dimensions, as in Fortran ordered arrays.
+     */
+    template<class T, size_t N>
+        T* strided_base(PyArrayObject* arr_ptr, long* base_shape, long* lower, long* step)
+        {
+            long const* strides = PyArray_STRIDES(arr_ptr);
+            long const* dims = PyArray_DIMS(arr_ptr);
+            T* data = reinterpret_cast<T*>(PyArray_BYTES(arr_ptr));
+            if(not PyArray_ISALIGNED(arr_ptr))
+                return nullptr;
+            std::fill(lower, lower + N, 0L);
+            std::fill(step, step + N, 1L);
+            std::copy(dims, dims + N, base_shape);
+            if(std::find(dims, dims + N, 0L) != dims + N)
+                return data;
+
+            long inner = 1;             // elements spanned by the inner dimensions of the base
+            long* pending = nullptr;    // base shape of the previous dimension, bounded by this one
+            long pending_inner = 1, pending_span = 1;
+            for(long i = N - 1; i >= 0; --i) {
+                if(dims[i] == 1)
+                    continue;
+                if(strides[i] % long(sizeof(T)))
+                    return nullptr;
+                long const s = strides[i] / long(sizeof(T));
+                long const abs_s = std::abs(s);
+                if(pending) {
+                    if(abs_s % pending_inner or abs_s / pending_inner < pending_span)
+                        return nullptr;
+                    *pending = abs_s / pending_inner;
+                    inner = abs_s;
+                }
+                if(abs_s == 0 or abs_s % inner)
+                    return nullptr;
+                step[i] = abs_s / inner;
+                long const span = (dims[i] - 1) * step[i] + 1;
+                if(s < 0) {
+                    // walk the base backward, from its last element along this dimension
+                    lower[i] = span - 1;
+                    step[i] = -step[i];
+                    data += (dims[i] - 1) * s;
+                }
+                pending = base_shape + i;
+                pending_inner = inner;
+                pending_span = span;
+            }
+            if(pending)
+                *pending = pending_span;
+            return data;
+        }
+
+    template<typename T, size_t N, class... S>
+        struct python_to_pythran< types::numpy_gexpr<types::ndarray<T, N>, S...> >{
+            static_assert(sizeof...(S) == N, "strided arrays are converted to a slice along each dimension");
+            typedef types::numpy_gexpr<types::ndarray<T, N>, S...> gexpr_type;
+            python_to_pythran(){
+                static bool registered=false;
+                python_to_pythran<T>();
+                if(not registered) {
+                    registered=true;
+                    boost::python::converter::registry::push_back(&convertible,&construct,boost::python::type_id< gexpr_type >());
+                }
+            }
+            static void* convertible(PyObject* obj_ptr){
+                if(!PyArray_Check(obj_ptr))
+                    return 0;
+                PyArrayObject* arr_ptr = reinterpret_cast<PyArrayObject*>(obj_ptr);
+                if(PyArray_TYPE(arr_ptr) != c_type_to_numpy_type<T>::value)
+                    return 0;
+                if(PyArray_NDIM(arr_ptr) != N)
+                    return 0;
+                return obj_ptr;
+            }
+
+            static void construct(PyObject* obj_ptr, boost::python::converter::rvalue_from_python_stage1_data* data){
+                void* storage=((boost::python::converter::rvalue_from_python_storage<gexpr_type>*)(data))->storage.bytes;
+                PyArrayObject* arr_ptr = reinterpret_cast<PyArrayObject*>(obj_ptr);
+                long base_shape[N];
+                gexpr_type* view = new (storage) gexpr_type();
+                if(T* base = strided_base<T, N>(arr_ptr, base_shape, view->lower.data(), view->step.data())) {
+                    view->arg = types::ndarray<T, N>(base, base_shape, obj_ptr);
+                    Py_INCREF(obj_ptr);
+                }
+                else {
+                    // other layouts, such as Fortran ordered arrays, are copied to a C ordered array
+                    std::fill(view->lower.begin(), view->lower.end(), 0L);
+                    std::fill(view->step.begin(), view->step.end(), 1L);
+                    PyObject* copy = PyArray_NewCopy(arr_ptr, NPY_CORDER);
+                    if(not copy)
+                        boost::python::throw_error_already_set();
+                    view->arg = types::ndarray<T, N>((T*)PyArray_BYTES(reinterpret_cast<PyArrayObject*>(copy)), PyArray_DIMS(arr_ptr), copy);
+                }
+                view->buffer = view->arg.buffer;
+                std::copy(PyArray_DIMS(arr_ptr), PyArray_DIMS(arr_ptr) + N, view->shape.begin());
+                data->convertible=storage;
+            }
+        };
+
+    /* Fortran ordered matrices are the transposition of a C ordered matrix */
+    template<typename T>
+        struct python_to_pythran< types::numpy_texpr<types::ndarray<T, 2>> >{
+            typedef types::numpy_texpr<types::ndarray<T, 2>> texpr_type;
+            python_to_pythran(){
+                static bool registered=false;
+                python_to_pythran<T>();
+                if(not registered) {
+                    registered=true;
+                    boost::python::converter::registry::push_back(&convertible,&construct,boost::python::type_id< texpr_type >());
+                }
+            }
+            static void* convertible(PyObject* obj_ptr){
+                if(!PyArray_Check(obj_ptr))
+                    return 0;
+                PyArrayObject* arr_ptr = reinterpret_cast<PyArrayObject*>(obj_ptr);
+                if(PyArray_TYPE(arr_ptr) != c_type_to_numpy_type<T>::value)
+                    return 0;
+                if(PyArray_NDIM(arr_ptr) != 2)
+                    return 0;
+                long * stride = PyArray_STRIDES(arr_ptr);
+                long * dims = PyArray_DIMS(arr_ptr);
+                if(stride[0] != PyArray_ITEMSIZE(arr_ptr) or stride[1] != dims[0] * stride[0])
+                    return 0;
+                return obj_ptr;
+            }
+
+            static void construct(PyObject* obj_ptr, boost::python::converter::rvalue_from_python_stage1_data* data){
+                void* storage=((boost::python::converter::rvalue_from_python_storage<texpr_type>*)(data))->storage.bytes;
+                PyArrayObject* arr_ptr = reinterpret_cast<PyArrayObject*>(obj_ptr);
+                long shape[] = {PyArray_DIMS(arr_ptr)[1], PyArray_DIMS(arr_ptr)[0]};
+                new (storage) texpr_type(types::ndarray< T, 2>((T*)PyArray_BYTES(arr_ptr), shape, obj_ptr));
+                Py_INCREF(obj_ptr);
+                data->convertible=storage;
+            }
+        };
+
     template <typename T>
         struct custom_boost_simd_logical {
             static PyObject* convert( boost::simd::logical<T> const& n) {
@@ -1087,6 +1260,12 @@ namespace pythonic {
             pythran_to_python() { register_once< boost::simd::logical<T>, custom_boost_simd_logical<T> >(); }
         };
 
+    // destructor of the capsule holding a reference to a pythran array memory
+    template<class T>
+        void release_raw_array_capsule(PyObject* capsule) {
+            delete static_cast<utils::shared_ref<types::raw_array<T>>*>(PyCapsule_GetPointer(capsule, nullptr));
+        }
+
     template<class T, size_t N>
         struct custom_array_to_ndarray {
             static PyObject* convert( types::ndarray<T,N> n) {
@@ -1111,6 +1290,15 @@ namespace pythonic {
                                 PyArray_DATA(arr),
                                 PyArray_FLAGS(arr) & ~NPY_ARRAY_OWNDATA, p);
                     }
+                } else if(n.mem->inlined or n.mem->mapping) {
+                    // the buffer is not a malloc-ed block numpy could free,
+                    // so the array keeps the pythran memory alive through a capsule
+                    PyObject* result = PyArray_SimpleNewFromData(N, n.shape.data(), c_type_to_numpy_type<T>::value, n.buffer);
+                    if (!result)
+                        return nullptr;
+                    PyObject* base = PyCapsule_New(new utils::shared_ref<types::raw_array<T>>(n.mem), nullptr, &release_raw_array_capsule<T>);
+                    PyArray_SetBaseObject(reinterpret_cast<PyArrayObject*>(result), base);
+                    return result;
                 } else {
                     PyObject* result = PyArray_SimpleNewFromData(N, n.shape.data(), c_type_to_numpy_type<T>::value, n.buffer);
                     n.mem.external(result);
@@ -1150,6 +1338,12 @@ namespace pythonic {
                 register_once< types::numpy_gexpr<Arg, S...>, custom_expr_to_ndarray<types::numpy_gexpr<Arg, S...>> >();
             }
         };
+    template<class Arg>
+        struct pythran_to_python< types::numpy_texpr<Arg> > {
+            pythran_to_python() {
+                register_once< types::numpy_texpr<Arg>, custom_expr_to_ndarray<types::numpy_texpr<Arg>> >();
+            }
+        };
 }
 
 #endif
@@ -26,21 +26,36 @@ namespace pythonic {
             array<long, 0> select_shape(U const& u, V const&, utils::int_<0> ) {
                 return array<long, 0>();
             }
+        // a broadcasted value only has one row, the other operand gives the actual shape
+        template<class T>
+            struct broadcasted;
+        template<class T, class V, size_t N>
+            typename std::enable_if<V::value == N, array<long, N>>::type select_shape(broadcasted<T> const& , V const& v, utils::int_<N> ) {
+                return v.shape;
+            }
 
         /* Expression template for numpy expressions - binary operators
          */
         template<class Op, class Arg0, class Arg1>
             struct numpy_expr {
-                static const bool is_vectorizable = std::remove_reference<Arg0>::type::is_vectorizable and std::remove_reference<Arg1>::type::is_vectorizable
-                  and std::is_same<typename std::remove_cv<typename std::remove_reference<Arg0>::type>::type::dtype,
-                                   typename std::remove_cv<typename std::remove_reference<Arg1>::type>::type::dtype
-                                  >::value
-                  and types::is_vector_op<Op>::value;
+                static const long cost = std::remove_reference<Arg0>::type::cost + std::remove_reference<Arg1>::type::cost + types::op_cost<Op>::value;
                 typedef const_nditerator<numpy_expr<Op, Arg0, Arg1>> iterator;
                 static constexpr size_t value = std::remove_reference<Arg0>::type::value>std::remove_reference<Arg1>::type::value?std::remove_reference<Arg0>::type::value: std::remove_reference<Arg1>::type::value;
                 typedef decltype(Op()(std::declval<typename std::remove_reference<Arg0>::type::value_type>(), std::declval<typename std::remove_reference<Arg1>::type::value_type>())) value_type;
                 typedef decltype(Op()(std::declval<typename std::remove_reference<Arg0>::type::dtype>(), std::declval<typename std::remove_reference<Arg1>::type::dtype>())) dtype;
 
+                // operands of different dtypes are converted to the dtype of the expression when loaded
+                static const bool is_mixed = not std::is_same<typename std::remove_reference<Arg0>::type::dtype,
+                                                              typename std::remove_reference<Arg1>::type::dtype
+                                                             >::value;
+                static const bool is_vectorizable = std::remove_reference<Arg0>::type::is_vectorizable and std::remove_reference<Arg1>::type::is_vectorizable
+                  and (not is_mixed or (types::is_vector_cast<typename std::remove_reference<Arg0>::type::dtype, dtype>::value and
+                                        types::is_vector_cast<typename std::remove_reference<Arg1>::type::dtype, dtype>::value))
+                  and types::is_vector_op<Op, dtype>::value;
+                typedef typename std::conditional<is_mixed, dtype, typename std::remove_reference<Arg0>::type::dtype>::type vdtype0;
+                typedef typename std::conditional<is_mixed, dtype, typename std::remove_reference<Arg1>::type::dtype>::type vdtype1;
+                static const bool is_aligned = std::remove_reference<Arg0>::type::is_aligned and std::remove_reference<Arg1>::type::is_aligned;
+
                 typename std::remove_reference<Arg0>::type arg0;
                 typename std::remove_reference<Arg1>::type arg1;
                 array<long, value> shape;
@@ -64,10 +79,15 @@ namespace pythonic {
                 }
 #ifdef USE_BOOST_SIMD
                 template<class I> // template to prevent automatic instantiation when the type is not vectorizable
-                auto load(I i) const -> decltype(Op()(arg0.load(i), arg1.load(i))) {
-                  return Op()(arg0.load(i), arg1.load(i));
+                auto load(I i) const -> decltype(Op()(vload<vdtype0>(arg0, i, std::false_type()), vload<vdtype1>(arg1, i, std::false_type()))) {
+                  return Op()(vload<vdtype0>(arg0, i, std::false_type()), vload<vdtype1>(arg1, i, std::false_type()));
+                }
+                template<class I>
+                auto aligned_load(I i) const -> decltype(Op()(vload<vdtype0>(arg0, i, std::true_type()), vload<vdtype1>(arg1, i, std::true_type()))) {
+                  return Op()(vload<vdtype0>(arg0, i, std::true_type()), vload<vdtype1>(arg1, i, std::true_type()));
                 }
 #endif
+                bool aligned() const { return arg0.aligned() and arg1.aligned(); }
 
                 template<class... S>
                 numpy_expr<Op, numpy_gexpr<Arg0, contiguous_slice, S...>, numpy_gexpr<Arg1, contiguous_slice, S...>>
@@ -14,7 +14,10 @@ namespace pythonic {
             // where filters information is True so that we can jump to the correct value 
             // in the ndarray buffer in O(1)
             struct numpy_fexpr {
-                static const bool is_vectorizable = false;
+                // loads gather the selected elements through the index buffer
+                static const bool is_vectorizable = types::is_vectorizable<typename std::remove_reference<Arg>::type::dtype>::value;
+                static const bool is_aligned = false;
+                static const long cost = 2;
                 //TODO accept multidimensionnal filtered expression
                 //>>> a = numpy.arange(2*3*4).reshape(2,3,4)
                 //array([[[ 0,  1,  2,  3],
@@ -128,8 +131,8 @@ namespace pythonic {
                 }
 #ifdef USE_BOOST_SIMD
                 template<class I> // template to prevent automatic instantiation when the type is not vectorizable
-                void load(I) const {
-                  typedef typename I::this_should_never_happen omg;
+                auto load(I i) const -> decltype(vgather(&*this->arg.fbegin(), this->buffer)) {
+                  return vgather(&*arg.fbegin(), buffer + i);
                 }
 #endif
                 auto operator[](long i) const -> decltype(this->fast(i))
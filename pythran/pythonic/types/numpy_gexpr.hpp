@@ -53,6 +53,16 @@ namespace pythonic {
                 static const bool value = true;
             };
 
+        /* helper that yields true if a pack selects a column: a slice, then an integer
+         */
+        template<class... S>
+            struct is_column_index {
+                static const bool value = false;
+            };
+        template<class S0>
+            struct is_column_index<S0, long> {
+                static const bool value = count_long<S0>::value == 0;
+            };
 
         template <class Arg, class... S>
             struct numpy_gexpr_helper;
@@ -73,14 +83,23 @@ namespace pythonic {
                 // It is not possible to vectorize everything. We only vectorize if the last dimension is contiguous, which happens if
                 // 1. Arg is an ndarray (this is too strict)
                 // 2. the size of the gexpr is lower than the dim of arg, or it's the same, but the last slice is contiguous
+                // 3. or it is a column of a matrix, as found in transposed views, which is loaded through a strided gather
+                static const bool is_column =
+                  std::is_same<ndarray<dtype, 2>,
+                               typename std::remove_cv<typename std::remove_reference<Arg>::type>::type
+                              >::value and
+                  is_column_index<S...>::value;
                 static const bool is_vectorizable =
                   std::is_same<ndarray<typename std::remove_reference<Arg>::type::dtype, std::remove_reference<Arg>::type::value>,
                                typename std::remove_cv<typename std::remove_reference<Arg>::type>::type
                               >::value and
                   (
                     sizeof...(S) < std::remove_reference<Arg>::type::value or
-                    std::is_same<contiguous_slice, typename std::tuple_element<sizeof...(S) - 1, std::tuple<S...>>::type>::value
-                  );
+                    std::is_same<contiguous_slice, typename std::tuple_element<sizeof...(S) - 1, std::tuple<S...>>::type>::value or
+                    is_column
+                  ) and types::is_vectorizable<dtype>::value;
+                static const bool is_aligned = false;
+                static const long cost = is_column ? 2 : 1;
 
                 typedef typename std::remove_reference<decltype(numpy_gexpr_helper<Arg, S...>::get(std::declval<numpy_gexpr>(), 0L))>::type value_type;
 
@@ -252,11 +271,20 @@ namespace pythonic {
                 template<class I>
                 auto load(I i) const
                 -> decltype(boost::simd::load<boost::simd::native<dtype, BOOST_SIMD_DEFAULT_EXTENSION>>(this->buffer, i))
+                {
+                  return _load(i, std::integral_constant<bool, is_column>());
+                }
+                boost::simd::native<dtype, BOOST_SIMD_DEFAULT_EXTENSION> _load(long i, std::false_type) const
                 {
                   typedef dtype T;
                   typedef typename boost::simd::native<T, BOOST_SIMD_DEFAULT_EXTENSION> vT;
                   return boost::simd::load<vT>(buffer, lower[0] + i);
                 }
+                boost::simd::native<dtype, BOOST_SIMD_DEFAULT_EXTENSION> _load(long i, std::true_type) const
+                {
+                  long const stride = arg.shape[1] * (is_contiguous<S...>::value ? 1 : step[0]);
+                  return vgather(buffer + (lower[0] + (is_contiguous<S...>::value ? i : step[0] * i)) * arg.shape[1] + indices[0], stride);
+                }
 
 #endif
 
@@ -30,6 +30,8 @@ namespace pythonic {
                 // wrapper around another numpy expression to skip first dimension using a given value.
                 static constexpr size_t value = std::remove_reference<Arg>::type::value - 1;
                 static const bool is_vectorizable = std::remove_reference<Arg>::type::is_vectorizable;
+                static const long cost = std::remove_reference<Arg>::type::cost;
+                static const bool is_aligned = false; // rows do not start on an aligned boundary
                 typedef typename std::remove_reference<Arg>::type::dtype dtype;
                 typedef typename std::remove_reference<decltype(numpy_iexpr_helper<numpy_iexpr, value>::get(std::declval<numpy_iexpr>(), 0L))>::type value_type;
 
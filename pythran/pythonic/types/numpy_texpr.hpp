@@ -21,7 +21,10 @@ namespace pythonic {
             //
             // for N = 2
             struct numpy_texpr<ndarray<T, 2>> {
-                static const bool is_vectorizable = false;
+                // rows are columns of arg, loaded through strided gathers
+                static const bool is_vectorizable = types::is_vectorizable<T>::value;
+                static const bool is_aligned = false;
+                static const long cost = 2;
                 typedef ndarray<T, 2> Arg;
 
                 typedef nditerator<numpy_texpr<Arg>> iterator;
@@ -59,12 +62,33 @@ namespace pythonic {
                     return arg(contiguous_slice(pythonic::__builtin__::None,pythonic::__builtin__::None), i);
                 }
 #ifdef USE_BOOST_SIMD
-                template<class I>
+                template<class I> // rows are loaded through fast(), never the matrix as a whole
                 void load(I) const {
                   typedef typename T::this_should_never_happen omg;
                 }
 #endif
 
+                /* write the transposed matrix into the row-major buffer out
+                 *
+                 * the matrix is walked tile by tile so that both the rows read
+                 * and the rows written by a tile stay in cache
+                 */
+                void transpose_into(T* out) const {
+                    static const long tile = 32;
+                    long const n = arg.shape[0], m = arg.shape[1];
+                    T const* in = arg.buffer;
+#ifdef _OPENMP
+                    #pragma omp parallel for if(utils::omp_worth((m + tile - 1) / tile, tile * n))
+#endif
+                    for(long jj = 0; jj < m; jj += tile)
+                        for(long ii = 0; ii < n; ii += tile) {
+                            long const jend = std::min(m, jj + tile), iend = std::min(n, ii + tile);
+                            for(long j = jj; j < jend; ++j)
+                                for(long i = ii; i < iend; ++i)
+                                    out[j * n + i] = in[i * m + j];
+                        }
+                }
+
                 auto operator[](long i) const -> decltype(this->fast(i)) {
                     if(i<0) i += shape[0];
                     return fast(i);
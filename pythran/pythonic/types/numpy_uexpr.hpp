@@ -9,7 +9,9 @@ namespace pythonic {
         template<class Op, class Arg>
             struct numpy_uexpr {
                 static const bool is_vectorizable = std::remove_reference<Arg>::type::is_vectorizable
-                                                    and types::is_vector_op<Op>::value;
+                                                    and types::is_vector_op<Op, typename std::remove_reference<Arg>::type::dtype>::value;
+                static const bool is_aligned = std::remove_reference<Arg>::type::is_aligned;
+                static const long cost = std::remove_reference<Arg>::type::cost + types::op_cost<Op>::value;
                 typedef const_nditerator<numpy_uexpr<Op, Arg>> iterator;
                 static constexpr size_t value = std::remove_reference<Arg>::type::value;
                 typedef decltype(Op()(std::declval<typename std::remove_reference<Arg>::type::value_type>())) value_type;
@@ -35,7 +37,12 @@ namespace pythonic {
                 auto load(I i) const -> decltype(Op()(arg.load(i))) {
                   return Op()(arg.load(i));
                 }
+                template<class I>
+                auto aligned_load(I i) const -> decltype(Op()(arg.aligned_load(i))) {
+                  return Op()(arg.aligned_load(i));
+                }
 #endif
+                bool aligned() const { return arg.aligned(); }
                 auto operator[](long i) const -> decltype(this->fast(i)) {
                     if(i<0) i += shape[0];
                     return fast(i);
@@ -0,0 +1,87 @@
+#ifndef PYTHONIC_TYPES_OP_COST_HPP
+#define PYTHONIC_TYPES_OP_COST_HPP
+
+namespace pythonic {
+
+namespace operator_ {
+namespace proxy {
+struct div;
+struct mod;
+}
+}
+
+namespace numpy {
+namespace proxy {
+struct divide; struct true_divide; struct floor_divide; struct mod; struct remainder; struct fmod;
+struct reciprocal; struct sqrt;
+struct exp; struct expm1; struct log; struct log2; struct log10; struct log1p;
+struct logaddexp; struct logaddexp2;
+struct sin; struct cos; struct tan; struct arcsin; struct arccos; struct arctan; struct arctan2;
+struct sinh; struct cosh; struct tanh; struct arcsinh; struct arccosh; struct arctanh;
+struct hypot; struct power;
+}
+}
+
+namespace types {
+
+/* Estimated cost of an operator, for one element, in units of an element copy
+ *
+ * Expressions sum the cost of their operators and operands into a static
+ * ``cost'', used by the OpenMP cost model to decide whether a loop is worth
+ * running in parallel
+ */
+template<class O>
+  struct op_cost {
+    static const long value = 1;
+  };
+
+#define PYTHRAN_OP_COST(OP, COST) template<> struct op_cost<OP> { static const long value = COST; }
+PYTHRAN_OP_COST(operator_::proxy::div, 4);
+PYTHRAN_OP_COST(operator_::proxy::mod, 8);
+PYTHRAN_OP_COST(numpy::proxy::divide, 4);
+PYTHRAN_OP_COST(numpy::proxy::true_divide, 4);
+PYTHRAN_OP_COST(numpy::proxy::floor_divide, 8);
+PYTHRAN_OP_COST(numpy::proxy::mod, 8);
+PYTHRAN_OP_COST(numpy::proxy::remainder, 8);
+PYTHRAN_OP_COST(numpy::proxy::fmod, 8);
+PYTHRAN_OP_COST(numpy::proxy::reciprocal, 4);
+PYTHRAN_OP_COST(numpy::proxy::sqrt, 4);
+PYTHRAN_OP_COST(numpy::proxy::exp, 20);
+PYTHRAN_OP_COST(numpy::proxy::expm1, 20);
+PYTHRAN_OP_COST(numpy::proxy::log, 20);
+PYTHRAN_OP_COST(numpy::proxy::log2, 20);
+PYTHRAN_OP_COST(numpy::proxy::log10, 20);
+PYTHRAN_OP_COST(numpy::proxy::log1p, 20);
+PYTHRAN_OP_COST(numpy::proxy::logaddexp, 40);
+PYTHRAN_OP_COST(numpy::proxy::logaddexp2, 40);
+PYTHRAN_OP_COST(numpy::proxy::sin, 20);
+PYTHRAN_OP_COST(numpy::proxy::cos, 20);
+PYTHRAN_OP_COST(numpy::proxy::tan, 30);
+PYTHRAN_OP_COST(numpy::proxy::arcsin, 30);
+PYTHRAN_OP_COST(numpy::proxy::arccos, 30);
+PYTHRAN_OP_COST(numpy::proxy::arctan, 30);
+PYTHRAN_OP_COST(numpy::proxy::arctan2, 40);
+PYTHRAN_OP_COST(numpy::proxy::sinh, 30);
+PYTHRAN_OP_COST(numpy::proxy::cosh, 30);
+PYTHRAN_OP_COST(numpy::proxy::tanh, 30);
+PYTHRAN_OP_COST(numpy::proxy::arcsinh, 30);
+PYTHRAN_OP_COST(numpy::proxy::arccosh, 30);
+PYTHRAN_OP_COST(numpy::proxy::arctanh, 30);
+PYTHRAN_OP_COST(numpy::proxy::hypot, 20);
+PYTHRAN_OP_COST(numpy::proxy::power, 40);
+#undef PYTHRAN_OP_COST
+
+// static ``cost'' of an expression, one for other iterables
+template<class E>
+  struct expr_cost {
+    template<class F>
+      static constexpr long get(decltype(F::cost)*) { return F::cost; }
+    template<class F>
+      static constexpr long get(...) { return 1; }
+    static const long value = get<E>(nullptr);
+  };
+
+}
+
+}
+#endif
@@ -1,12 +1,27 @@
 #ifndef PYTHONIC_TYPES_RAW_ARRAY_HPP
 #define PYTHONIC_TYPES_RAW_ARRAY_HPP
 
+#include "pythonic/utils/shared_ref.hpp"
+
+#include <cstdlib>
+#include <sys/mman.h>
+
 namespace pythonic {
 
     namespace types {
         /* Wrapper class to store an array pointer
          *
          * for internal use only, meant to be stored in a shared_ptr
+         *
+         * When the allocation policy permits it, utils::shared_ref stores the
+         * data right after the reference counter, in which case the data is not
+         * owned by the raw_array (see utils/allocate.hpp)
+         *
+         * Data allocated here are aligned on PYTHRAN_ARRAY_ALIGNMENT bytes and
+         * padded to a multiple of it. Vectorized copies stop at the last full
+         * SIMD register and never evaluate expressions on the padding.
+         *
+         * Memory mapped data is unmapped instead of freed, see numpy.memmap.
          */
         template<class T>
             class raw_array {
@@ -16,15 +31,27 @@ namespace pythonic {
                 typedef T* pointer_type;
 
                 T* data;
-                raw_array() : data(nullptr) {}
-                raw_array(size_t n) : data((T*)malloc(sizeof(T) * n)) {}
-                raw_array(T* d) : data(d) {}
-                raw_array(raw_array<T>&& d) : data(d.data) { d.data = nullptr; }
+                bool inlined; // data lives in the same block as the reference counter
+                bool padded;  // data is aligned and padded, as opposed to foreign data
+                void* mapping;  // mmap-ed region holding data, if any
+                size_t mapping_size;
+
+                raw_array() : data(nullptr), inlined(false), padded(false), mapping(nullptr), mapping_size(0) {}
+                raw_array(size_t n) : data((T*)utils::aligned_malloc(utils::padded_size(sizeof(T) * n))), inlined(false), padded(true), mapping(nullptr), mapping_size(0) {}
+                raw_array(utils::inline_storage storage, size_t n) : data(static_cast<T*>(storage.ptr)), inlined(true), padded(true), mapping(nullptr), mapping_size(0) {}
+                raw_array(T* d) : data(d), inlined(false), padded(false), mapping(nullptr), mapping_size(0) {}
+                raw_array(T* d, void* mapping, size_t mapping_size) : data(d), inlined(false), padded(false), mapping(mapping), mapping_size(mapping_size) {}
+                raw_array(raw_array<T>&& d) : data(d.data), inlined(d.inlined), padded(d.padded), mapping(d.mapping), mapping_size(d.mapping_size) { d.data = nullptr; d.mapping = nullptr; }
 
                 ~raw_array() {
-                    if(data)
+                    if(mapping)
+                        munmap(mapping, mapping_size);
+                    else if(data and not inlined)
                         free(data);
                 }
+
+                // size of the inline storage needed for n elements
+                static size_t inline_size(size_t n) { return utils::padded_size(sizeof(T) * n); }
             };
 
     }
@@ -7,10 +7,10 @@
 
 #include "pythonic/utils/shared_ref.hpp"
 #include "pythonic/utils/iterator.hpp"
+#include "pythonic/utils/flat_hash.hpp"
 
 #include "pythonic/__builtin__/in.hpp"
 
-#include <set>
 #include <memory>
 #include <utility>
 #include <limits>
@@ -107,7 +107,7 @@ namespace pythonic {
 
                 // data holder
                 typedef  typename std::remove_cv< typename std::remove_reference<T>::type>::type  _type;
-                typedef std::set< _type > container_type;
+                typedef utils::flat_set< _type > container_type;
                 utils::shared_ref<container_type> data;
 
                 public:
@@ -139,7 +139,7 @@ namespace pythonic {
                 set(set<T> const & other) : data(other.data) {}
                 template<class F>
                     set(set<F> const & other) :  data(){
-                        std::copy(other.begin(), other.end(), std::inserter(*data, data->begin()));
+                        data->insert(other.begin(), other.end());
                     }
 
                 // iterators
@@ -184,6 +184,8 @@ namespace pythonic {
 
                 long size() const { return data->size(); }
 
+                void reserve(size_t n) { data->reserve(n); }
+
                 // Misc
 
                 set<T> copy() const{
@@ -240,12 +242,13 @@ namespace pythonic {
                 template<typename U, typename... Types>
                     typename __combined<set<T>, U, Types...>::type intersection(U const& other, Types const&... others) const{
                         //Return a new set with elements common to the set and all others.
-                        typename __combined<set<T>, U, Types...>::type tmp = intersection(others...);
-                        for(auto it=tmp.begin(); it!=tmp.end();++it){
-                            if(not in(other, *it))
-                                tmp.discard(*it); //faster than remove() but not direct interaction with data
-                        }
-                        return tmp;
+                        typedef typename __combined<set<T>, U, Types...>::type result_type;
+                        result_type tmp = intersection(others...);
+                        result_type out = empty_set();
+                        for(auto const& elem : tmp)
+                            if(in(other, elem))
+                                out.add(elem);
+                        return out;
                     }
 
 
@@ -262,12 +265,6 @@ namespace pythonic {
                     set<T> difference(U const& other, Types const&... others) const{
                         //Return a new set with elements in the set that are not in the others.
                         set<T> tmp = difference(others...);
-                        /*
-                           for(iterator it=tmp.begin(); it!=tmp.end();++it){
-                           if(other.get_data().find(*it)!=other.end())
-                           tmp.discard(*it);
-                           }
-                           *///This algo will do several times the same find(), because std::set::erase() calls find. Lame!
                         for(typename U::const_iterator it=other.begin(); it!=other.end();++it){
                             tmp.discard(*it);
                         }
@@ -455,19 +452,11 @@ namespace pythonic {
                 void* storage=((boost::python::converter::rvalue_from_python_storage<types::set<T> >*)(data))->storage.bytes;
                 new (storage) types::set<T>(types::empty_set());
                 types::set<T>& v=*(types::set<T>*)(storage);
-                // may be useful to reserve more space ?
+                v.reserve(PySet_Size(obj_ptr));
                 PyObject *iterator = PyObject_GetIter(obj_ptr);
-
-                /* first round use boost extractor that performs a lot of checks
-                 * next we use our cutom one that goes faster
-                 */
-                if(PyObject *item = PyIter_Next(iterator)) {
-                    v.add(boost::python::extract<T>(item));
+                while(PyObject *item = PyIter_Next(iterator)) {
+                    v.add(extract<T>(item));
                     Py_DECREF(item);
-                    while((item = PyIter_Next(iterator))) {
-                        v.add(extract<T>(item));
-                        Py_DECREF(item);
-                    }
                 }
                 Py_DECREF(iterator);
                 data->convertible=storage;
@@ -477,8 +466,11 @@ namespace pythonic {
         struct custom_pythran_set_to_set{
             static PyObject* convert(const types::set<T>& v){
                 PyObject* obj = PySet_New(nullptr);
-                for(const T& e:v)
-                    PySet_Add(obj, boost::python::incref(boost::python::object(e).ptr()));
+                for(const T& e:v) {
+                    PyObject* item = to_python<T>(e);
+                    PySet_Add(obj, item); // does not steal the reference
+                    Py_DECREF(item);
+                }
                 return obj;
             }
         };
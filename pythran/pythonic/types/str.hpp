@@ -8,9 +8,14 @@
 #include "pythonic/utils/shared_ref.hpp"
 #include "pythonic/utils/proxy.hpp"
 #include "pythonic/utils/int_.hpp"
+#include "pythonic/utils/str_search.hpp"
 
 #include <boost/format.hpp>
+#include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <cstdint>
+#include <iterator>
 #include <string>
 #include <cstring>
 #include <sstream>
@@ -22,6 +27,9 @@ namespace pythonic {
 
         class str;
 
+        template<class S=slice>
+        class sliced_str;
+
         struct const_sliced_str_iterator : std::iterator< std::random_access_iterator_tag, char, ptrdiff_t, char*, char >
         {
             const char * data;
@@ -37,106 +45,221 @@ namespace pythonic {
             long operator-(const_sliced_str_iterator const & other) const { return (data - other.data)/step; }
         };
 
-        template<class S=slice>
-        class sliced_str {
+        /* Immutable string, as seen from Python
+         *
+         * Strings of at most small_capacity characters are stored inline and
+         * never allocate. Longer ones view a range of a reference counted
+         * buffer, so that copies and substrings share it; a view is copied to
+         * its own buffer before being modified. The hash is computed on first
+         * use and kept in the value, so that dict lookups do not rehash their
+         * keys; threads sharing a str may all store it, as the same value.
+         *
+         * A borrowed view refers to a buffer that its creator wants back, such
+         * as the read buffer of a file: copies of a borrowed view, and strings
+         * moved from it, get their own buffer, so that a borrowed view never
+         * leaves the object it was made for.
+         */
+        class str {
+            template<class S> friend class sliced_str;
             typedef std::string container_type;
-            utils::shared_ref<container_type> data;
 
-            typename S::normalized_type slicing;
-
-            public:
-            //  types
-            typedef container_type::reference reference;
-            typedef container_type::const_reference const_reference;
-            typedef const_sliced_str_iterator iterator;
-            typedef const_sliced_str_iterator const_iterator;
-            typedef container_type::size_type size_type;
-            typedef container_type::difference_type difference_type;
-            typedef container_type::value_type value_type;
-            typedef container_type::allocator_type allocator_type;
-            typedef container_type::pointer pointer;
-            typedef container_type::const_pointer const_pointer;
+            enum : char {
+                small_capacity = 15
+            };
+
+            struct view_type {
+                size_t offset : 63;
+                size_t borrowed : 1;
+                size_t size;
+            };
+
+            // null for inline strings
+            utils::shared_ref<container_type> buffer_;
+            // zero until computed: threads can only store the same value, so
+            // relaxed accesses are enough
+            mutable std::atomic<size_t> hash_;
+            union {
+                // inline characters, followed by the count of unused ones so
+                // that a full buffer is still null terminated
+                char small_[small_capacity + 1];
+                view_type view_;
+            };
+
+            bool is_small() const { return not buffer_; }
+
+            size_t cached_hash() const { return hash_.load(std::memory_order_relaxed); }
+            void cache_hash(size_t h) const { hash_.store(h, std::memory_order_relaxed); }
+
+            // the whole buffer belongs to this string
+            bool owned() const {
+                return buffer_.unique() and view_.offset == 0 and view_.size == buffer_->size();
+            }
 
-            // constructor
-            sliced_str(): data(utils::no_memory()) {}
-            sliced_str(sliced_str const & s): data(s.data), slicing(s.slicing) {}
+            // fills the whole union, so that copying it never reads uninitialized bytes
+            void set_small(char const* s, size_t n) {
+                std::memmove(small_, s, n);
+                std::memset(small_ + n, 0, small_capacity - n);
+                small_[small_capacity] = small_capacity - n;
+            }
 
-            sliced_str(sliced_str const & s, typename S::normalized_type const& sl): data(s.data), slicing(s.slicing * sl) {}
-            sliced_str(types::str const & other, typename S::normalized_type const & s);
+            void install(container_type && s) {
+                buffer_ = utils::shared_ref<container_type>(std::move(s));
+                view_.offset = 0;
+                view_.borrowed = false;
+                view_.size = buffer_->size();
+            }
 
-            // const getter
-            container_type const & get_data() const { return *data; }
-            typename S::normalized_type const & get_slice() const { return slicing; }
+            void copy(str const& other) {
+                cache_hash(other.cached_hash());
+                if(other.is_small() or not other.view_.borrowed) {
+                    buffer_ = other.buffer_;
+                    std::memcpy(small_, other.small_, sizeof(small_));
+                }
+                else
+                    install(container_type(other.data(), other.size()));
+            }
 
-            // assignment
-            sliced_str& operator=(str const & );
-            sliced_str& operator=(sliced_str const & );
-            str operator+(sliced_str const & );
+            void take(str&& other) {
+                if(not other.is_small() and other.view_.borrowed)
+                    return copy(other);
+                cache_hash(other.cached_hash());
+                buffer_ = std::move(other.buffer_);
+                std::memcpy(small_, other.small_, sizeof(small_));
+                other.cache_hash(0);
+                other.set_small("", 0);
+            }
 
-            // iterators
-            const_iterator begin() const { return const_iterator(data->c_str() + slicing.lower, slicing.step); }
-            const_iterator end() const { return const_iterator(data->c_str() + slicing.upper, slicing.step); }
+            void assign(char const* s, size_t n) {
+                if(n <= size_t(small_capacity))
+                    set_small(s, n);
+                else
+                    install(container_type(s, n));
+            }
 
-            // size
-            size_type size() const { return slicing.size(); }
+            // moves the content to a new buffer, able to hold capacity characters
+            void detach(size_t capacity) {
+                container_type tmp;
+                tmp.reserve(capacity);
+                tmp.assign(data(), size());
+                install(std::move(tmp));
+            }
 
-            // accessor
-            char const & operator[](long i) const { return (*data)[slicing.get(i)];}
-            char & operator[](long i) { return (*data)[slicing.get(i)];}
-            sliced_str<slice> operator[](slice const& s) const { return sliced_str<slice>(*this, s.normalize(size())); }
-            sliced_str<contiguous_slice> operator[](contiguous_slice const& s) const { return sliced_str<contiguous_slice>(*this, s.normalize(size())); }
+            static str concat(char const* s0, size_t n0, char const* s1, size_t n1) {
+                str out;
+                out.reserve(n0 + n1);
+                out.append(s0, n0);
+                out.append(s1, n1);
+                return out;
+            }
 
-            // conversion
-            operator long();
-            explicit operator bool() const {return size() > 0;}
-            bool operator!() const { return not bool();}
+            void append(char const* s, size_t n) {
+                size_t m = size();
+                cache_hash(0);
+                if(is_small() and m + n <= size_t(small_capacity)) {
+                    std::memmove(small_ + m, s, n);
+                    small_[m + n] = 0;
+                    small_[small_capacity] = small_capacity - m - n;
+                }
+                else if(not is_small() and owned()) {
+                    buffer_->append(s, n);
+                    view_.size = m + n;
+                }
+                else {
+                    // s may point into the current storage
+                    container_type tmp;
+                    tmp.reserve(std::max(m + n, 2 * m));
+                    tmp.append(data(), m);
+                    tmp.append(s, n);
+                    install(std::move(tmp));
+                }
+            }
 
-            // io
-            friend  std::ostream& operator<<(std::ostream& os, types::sliced_str<S> const & v) {
-                for(auto b = v.begin(); b != v.end(); ++b)
-                    os << *b;
-                return os;
+            // 64 bit multiply and shift mixing, one word at a time
+            static size_t hash_bytes(char const* s, size_t n) {
+                uint64_t h = n * 0x9E3779B97F4A7C15ULL;
+                for(; n >= sizeof(uint64_t); n -= sizeof(uint64_t), s += sizeof(uint64_t)) {
+                    uint64_t w;
+                    std::memcpy(&w, s, sizeof(w));
+                    h = (h ^ w) * 0xFF51AFD7ED558CCDULL;
+                    h ^= h >> 32;
+                }
+                uint64_t w = 0;
+                std::memcpy(&w, s, n);
+                h = (h ^ w) * 0xC4CEB9FE1A85EC53ULL;
+                h ^= h >> 29;
+                return h ? h : 1;
             }
-        };
 
-        class str {
-            template<class S> friend class sliced_str;
-            typedef std::string container_type;
-            utils::shared_ref<container_type> data;
+            int compare(str const& other) const {
+                size_t n = size(), m = other.size();
+                int r = std::memcmp(data(), other.data(), std::min(n, m));
+                return r ? r : (n < m ? -1 : int(n > m));
+            }
 
             public:
 
             static const size_t npos = std::string::npos;
 
+            /* Null terminated characters of a str, for C functions
+             *
+             * Inline strings and views that reach the end of their buffer
+             * already are null terminated, other views are copied here: the
+             * str itself is never modified, so that threads may share it.
+             */
+            class c_string {
+                container_type copy_;
+                char const* ptr_; // null if copied
+
+                public:
+
+                c_string(char const* ptr) : ptr_(ptr) {}
+                c_string(char const* s, size_t n) : copy_(s, n), ptr_(nullptr) {}
+                operator char const*() const { return ptr_ ? ptr_ : copy_.c_str(); }
+            };
+
             typedef types::str value_type;
-            typedef container_type::iterator iterator;
-            typedef container_type::reverse_iterator reverse_iterator;
-            typedef container_type::const_reverse_iterator const_reverse_iterator;
-
-            str() : data() {}
-            str(std::string const & s) : data(s) {}
-            str(std::string && s) : data(std::move(s)) {}
-            str(const char*s) : data(s) {}
-            str(const char*s, size_t n) : data(s,n) {}
-            str(char c) : data(1,c) {}
+            typedef char const* iterator;
+            typedef char const* const_iterator;
+            typedef std::reverse_iterator<const_iterator> reverse_iterator;
+            typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+
+            str() : buffer_(utils::no_memory()), hash_(0) { set_small("", 0); }
+            str(str const& other) : buffer_(utils::no_memory()) { copy(other); }
+            str(str&& other) : buffer_(utils::no_memory()) { take(std::move(other)); }
+            str(std::string const & s) : buffer_(utils::no_memory()), hash_(0) { assign(s.data(), s.size()); }
+            str(std::string && s) : buffer_(utils::no_memory()), hash_(0) {
+                if(s.size() <= size_t(small_capacity))
+                    set_small(s.data(), s.size());
+                else
+                    install(std::move(s));
+            }
+            str(const char*s) : buffer_(utils::no_memory()), hash_(0) { assign(s, strlen(s)); }
+            str(const char*s, size_t n) : buffer_(utils::no_memory()), hash_(0) { assign(s, n); }
+            str(char c) : buffer_(utils::no_memory()), hash_(0) { assign(&c, 1); }
             template<class S>
-            str(sliced_str<S> const & other) : data( other.begin(), other.end()) {}
+            str(sliced_str<S> const & other) : str() {
+                if(other.get_slice().step == 1)
+                    *this = other.get_data().substr(other.get_slice().lower, other.size());
+                else
+                    *this = str(other.begin(), other.end());
+            }
             template<class T>
-                str(T const& begin, T const& end) : data( begin, end) {}
+                str(T const& begin, T const& end) : str(container_type(begin, end)) {}
 
             explicit operator char() const {
                 assert(size() == 1);
-                return (*data)[0];
+                return data()[0];
             }
 
             operator long int() const { // Allows implicit conversion without loosing bool conversion
                 char *endptr;
-                auto dat = data->data();
+                c_string const cstr = c_str();
+                char const* dat = cstr;
                 long res = strtol(dat, &endptr,10);
                 if(endptr == dat) {
                     std::ostringstream err;
                     err << "invalid literal for long() with base 10:"
-                        "'" << c_str() << '\'';
+                        "'" << dat << '\'';
                     throw std::runtime_error(err.str());
                 }
                 return res;
@@ -144,15 +267,16 @@ namespace pythonic {
 
             operator pythran_long_t() const {
 #ifdef USE_GMP
-                return pythran_long_t(*data);
+                return pythran_long_t(static_cast<char const*>(c_str()));
 #else
                 char *endptr;
-                auto dat = data->data();
+                c_string const cstr = c_str();
+                char const* dat = cstr;
                 pythran_long_t res = strtoll(dat, &endptr,10);
                 if(endptr == dat) {
                     std::ostringstream err;
                     err << "invalid literal for long() with base 10:"
-                        "'" << c_str() << '\'';
+                        "'" << dat << '\'';
                     throw std::runtime_error(err.str());
                 }
                 return res;
@@ -161,73 +285,192 @@ namespace pythonic {
 
             explicit operator double() const {
                 char *endptr;
-                auto dat = data->data();
+                c_string const cstr = c_str();
+                char const* dat = cstr;
                 double res = strtod(dat, &endptr);
                 if(endptr == dat) {
                     std::ostringstream err;
                     err << "invalid literal for double():"
-                        << "'" << c_str() << "'";
+                        << "'" << dat << "'";
                     throw std::runtime_error(err.str());
                 }
                 return res;
             }
+            str& operator=(str const& other) {
+                if(this != &other)
+                    copy(other);
+                return *this;
+            }
+            str& operator=(str&& other) {
+                if(this != &other)
+                    take(std::move(other));
+                return *this;
+            }
             template<class S>
             str& operator=(sliced_str<S> const & other) {
-                if(other.get_data() == *data ) {
-                    auto it = std::copy(other.begin(), other.end(), begin());
-                    resize(it - this->begin());
-                }
-                else {
-                    *this=other.get_data();
-                }
-                return *this;
+                return *this = str(other);
             }
 
             types::str& operator+=(types::str const& s) {
-                *data += *s.data;
+                append(s.data(), s.size());
                 return *this;
             }
 
-            container_type const & get_data() const { return *data; }
-
-            size_t size() const { return data->size(); }
-            auto begin() const -> decltype(data->begin()) { return data->begin(); }
-            auto begin() -> decltype(data->begin()) { return data->begin(); }
-            auto rbegin() const -> decltype(data->rbegin()) { return data->rbegin(); }
-            auto rbegin() -> decltype(data->rbegin()) { return data->rbegin(); }
-            auto end() const -> decltype(data->end()) { return data->end(); }
-            auto end() -> decltype(data->end()) { return data->end(); }
-            auto rend() const -> decltype(data->rend()) { return data->rend(); }
-            auto rend() -> decltype(data->rend()) { return data->rend(); }
-            auto c_str() const -> decltype(data->c_str()) { return data->c_str(); }
-            auto resize(long n) -> decltype(data->resize(n)) { return data->resize(n); }
+            // makes this string a view of n characters of buffer, from offset
+            void view(utils::shared_ref<container_type> const& buffer, size_t offset, size_t n, bool borrowed) {
+                cache_hash(0);
+                if(n <= size_t(small_capacity)) {
+                    buffer_ = utils::shared_ref<container_type>(utils::no_memory());
+                    set_small(buffer->data() + offset, n);
+                }
+                else {
+                    buffer_ = buffer;
+                    view_.offset = offset;
+                    view_.borrowed = borrowed;
+                    view_.size = n;
+                }
+            }
+            size_t size() const { return is_small() ? small_capacity - small_[small_capacity] : view_.size; }
+            const_iterator begin() const { return data(); }
+            const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+            const_iterator end() const { return data() + size(); }
+            const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+            // characters, not null terminated
+            char const* data() const { return is_small() ? small_ : buffer_->data() + view_.offset; }
+            // the result must not outlive the full expression, unless stored in a c_string
+            c_string c_str() const {
+                if(is_small())
+                    return small_;
+                if(view_.offset + view_.size != buffer_->size())
+                    return c_string(data(), size());
+                return buffer_->c_str() + view_.offset;
+            }
+            void resize(long n) {
+                size_t m = size();
+                cache_hash(0);
+                if(is_small() and size_t(n) <= size_t(small_capacity)) {
+                    if(size_t(n) > m)
+                        std::memset(small_ + m, 0, n - m);
+                    small_[n] = 0;
+                    small_[small_capacity] = small_capacity - n;
+                }
+                else {
+                    if(is_small() or not owned())
+                        detach(std::max<size_t>(n, m));
+                    buffer_->resize(n);
+                    view_.size = n;
+                }
+            }
+            size_t hash() const {
+                size_t h = cached_hash();
+                if(not h) {
+                    h = hash_bytes(data(), size());
+                    cache_hash(h);
+                }
+                return h;
+            }
             size_t find(str const &s, size_t pos = 0) const {
-                const char * res =  strstr(c_str() + pos, s.c_str());
-                return res ? res - c_str() : npos;
+                if(pos > size())
+                    return npos;
+                char const* found = utils::find_substr(begin() + pos, end(), s.data(), s.size());
+                return found ? found - begin() : npos;
+            }
+            size_t rfind(str const &s, size_t pos = npos) const {
+                size_t n = size(), m = s.size();
+                if(m > n)
+                    return npos;
+                if(m == 0)
+                    return std::min(pos, n);
+                for(size_t i = std::min(pos, n - m) + 1; i-- > 0;)
+                    if(data()[i] == s.data()[0] and std::memcmp(data() + i, s.data(), m) == 0)
+                        return i;
+                return npos;
             }
             bool contains(str const& v) const { return find(v) != npos; }
-            size_t find_first_of(str const &s, size_t pos = 0) const { return data-> find_first_of(*s.data, pos); }
-            size_t find_first_of(const char* s, size_t pos = 0) const { return data-> find_first_of(s, pos); }
-            size_t find_first_not_of(str const &s, size_t pos = 0) const { return data->find_first_not_of(*s.data, pos); }
-            size_t find_last_not_of(str const &s, size_t pos = npos) const { return data-> find_last_not_of(*s.data, pos); }
-            str substr(size_t pos = 0, size_t len = npos) const { return data->substr(pos, len); }
-            bool empty() const { return data->empty(); }
-            int compare(size_t pos, size_t len, str const & str) const { return data->compare(pos, len, *str.data); }
-            void reserve(size_t n) { data->reserve(n); }
-            str& replace(size_t pos,  size_t len,  str const & str) { data->replace(pos, len, *str.data); return *this; }
+            size_t find_first_of(str const &s, size_t pos = 0) const {
+                if(pos >= size())
+                    return npos;
+                char const* found = utils::find_any(begin() + pos, end(), s.data(), s.size());
+                return found ? found - begin() : npos;
+            }
+            size_t find_first_of(const char* s, size_t pos = 0) const { return find_first_of(str(s), pos); }
+            size_t find_first_not_of(str const &s, size_t pos = 0) const {
+                for(size_t i = pos, n = size(); i < n; ++i)
+                    if(not std::memchr(s.data(), data()[i], s.size()))
+                        return i;
+                return npos;
+            }
+            size_t find_last_not_of(str const &s, size_t pos = npos) const {
+                for(size_t i = std::min(pos, size() - 1) + 1; i-- > 0;)
+                    if(not std::memchr(s.data(), data()[i], s.size()))
+                        return i;
+                return npos;
+            }
+            /* Bounds of the start:end range of a Python str method
+             *
+             * Negative bounds count from the end and end is clamped to the
+             * size, as in Python: start may still be past end, in which case
+             * the range is empty.
+             */
+            void adjust_indices(long& start, long& end) const {
+                long n = size();
+                if(end > n)
+                    end = n;
+                else if(end < 0)
+                    end = std::max(end + n, 0L);
+                if(start < 0)
+                    start = std::max(start + n, 0L);
+            }
+            // long substrings share the buffer of this string
+            str substr(size_t pos = 0, size_t len = npos) const {
+                if(pos > size())
+                    throw std::out_of_range("str::substr");
+                size_t n = std::min(len, size() - pos);
+                if(n <= size_t(small_capacity) or (not is_small() and view_.borrowed))
+                    return str(data() + pos, n);
+                str out(*this);
+                out.cache_hash(0);
+                out.view_.offset += pos;
+                out.view_.size = n;
+                return out;
+            }
+            bool empty() const { return size() == 0; }
+            int compare(size_t pos, size_t len, str const & other) const {
+                return substr(pos, len).compare(other);
+            }
+            void reserve(size_t n) {
+                if(n <= size() or (is_small() and n <= size_t(small_capacity)))
+                    return;
+                if(not is_small() and owned())
+                    buffer_->reserve(n);
+                else
+                    detach(n);
+            }
+            str& replace(size_t pos,  size_t len,  str const & other) {
+                str tail = substr(pos);
+                tail = tail.substr(std::min(len, tail.size()));
+                resize(pos);
+                *this += other;
+                return *this += tail;
+            }
 
             template<class S>
             str& operator+=(sliced_str<S> const & other) {
-                resize(size() + other.get_data().size());
-                std::copy(other.begin(), other.end(), begin());
-                return *this;
+                return *this += str(other);
+            }
+            bool operator==(str const& other) const {
+                size_t n = size();
+                size_t h = cached_hash(), oh = other.cached_hash();
+                if(n != other.size() or (h and oh and h != oh))
+                    return false;
+                // interned or shared strings point to the same buffer
+                return data() == other.data() or std::memcmp(data(), other.data(), n) == 0;
             }
-            bool operator==(str const& other) const { return *data == *other.data; }
-            bool operator!=(str const& other) const { return *data != *other.data; }
-            bool operator<=(str const& other) const { return *data <= *other.data; }
-            bool operator<(str const& other) const { return *data < *other.data; }
-            bool operator>=(str const& other) const { return *data >= *other.data; }
-            bool operator>(str const& other) const { return *data > *other.data; }
+            bool operator!=(str const& other) const { return not (*this == other); }
+            bool operator<=(str const& other) const { return compare(other) <= 0; }
+            bool operator<(str const& other) const { return compare(other) < 0; }
+            bool operator>=(str const& other) const { return compare(other) >= 0; }
+            bool operator>(str const& other) const { return compare(other) > 0; }
             template<class S>
             bool operator==(sliced_str<S> const & other) const {
                 if(size() != other.size())
@@ -239,51 +482,38 @@ namespace pythonic {
                         return false;
                 return true;
             }
-            sliced_str<slice> operator()( slice const &s) const {
-                return operator[](s);
-            }
-            sliced_str<contiguous_slice> operator()( contiguous_slice const &s) const {
-                return operator[](s);
-            }
+            sliced_str<slice> operator()( slice const &s) const;
+            sliced_str<contiguous_slice> operator()( contiguous_slice const &s) const;
 
             char operator[]( long i) const {
                 if(i<0) i+= size();
-                return (*data)[i];
+                return data()[i];
             }
 
-            char& operator[]( long i) {
-                if(i<0) i+= size();
-                return (*data)[i];
-            }
-            sliced_str<slice> operator[]( slice const &s ) const {
-                return sliced_str<slice>(*this, s.normalize(size()));
-            }
-            sliced_str<contiguous_slice> operator[]( contiguous_slice const &s ) const {
-                return sliced_str<contiguous_slice>(*this, s.normalize(size()));
-            }
+            sliced_str<slice> operator[]( slice const &s ) const;
+            sliced_str<contiguous_slice> operator[]( contiguous_slice const &s ) const;
 #ifdef USE_GMP
             char operator[](pythran_long_t const &m) const { return (*this)[m.get_si()];}
-            char & operator[](pythran_long_t const& m) { return (*this)[m.get_si()];}
 #endif
 
 
             explicit operator bool() const{
-                return not data->empty();
+                return not empty();
             }
             template<class A>
                 types::str operator%(A const & a) const {
-                    const boost::format fmter(*data);
+                    const boost::format fmter(container_type(data(), size()));
                     return (boost::format(fmter) % a ).str();
                 }
             template<class ...A>
                 types::str operator%(std::tuple<A...> const & a) const {
-                    boost::format fmter(*data);
+                    boost::format fmter(container_type(data(), size()));
                     (fmt(fmter, a, utils::int_<sizeof...(A)>() ));
                     return fmter.str();
                 }
             template<size_t N, class T>
                 types::str operator%(types::array<T, N> const & a) const {
-                    boost::format fmter(*data);
+                    boost::format fmter(container_type(data(), size()));
                     (fmt(fmter, a, utils::int_<N>() ));
                     return fmter.str();
                 }
@@ -299,6 +529,10 @@ namespace pythonic {
                 return counter;
             }
 
+            friend str operator+(str const& self, str const& other);
+            friend str operator+(str const& self, char const *s);
+            friend str operator+(char const *s, str const& other);
+
             private:
             template<class Tuple, size_t I>
                 void fmt(boost::format & f, Tuple const & a, utils::int_<I>) const {
@@ -311,23 +545,97 @@ namespace pythonic {
 
         };
 
+        template<class S>
+        class sliced_str {
+            typedef std::string container_type;
+            str data;
+
+            typename S::normalized_type slicing;
+
+            public:
+            //  types
+            typedef container_type::reference reference;
+            typedef container_type::const_reference const_reference;
+            typedef const_sliced_str_iterator iterator;
+            typedef const_sliced_str_iterator const_iterator;
+            typedef container_type::size_type size_type;
+            typedef container_type::difference_type difference_type;
+            typedef container_type::value_type value_type;
+            typedef container_type::allocator_type allocator_type;
+            typedef container_type::pointer pointer;
+            typedef container_type::const_pointer const_pointer;
+
+            // constructor
+            sliced_str() {}
+            sliced_str(sliced_str const & s): data(s.data), slicing(s.slicing) {}
+
+            sliced_str(sliced_str const & s, typename S::normalized_type const& sl): data(s.data), slicing(s.slicing * sl) {}
+            sliced_str(types::str const & other, typename S::normalized_type const & s);
+
+            // const getter
+            str const & get_data() const { return data; }
+            typename S::normalized_type const & get_slice() const { return slicing; }
+
+            // assignment
+            sliced_str& operator=(str const & );
+            sliced_str& operator=(sliced_str const & );
+            str operator+(sliced_str const & );
+
+            // iterators
+            const_iterator begin() const { return const_iterator(data.data() + slicing.lower, slicing.step); }
+            const_iterator end() const { return const_iterator(data.data() + slicing.upper, slicing.step); }
+
+            // size
+            size_type size() const { return slicing.size(); }
+
+            // accessor
+            char operator[](long i) const { return data[slicing.get(i)];}
+            sliced_str<slice> operator[](slice const& s) const { return sliced_str<slice>(*this, s.normalize(size())); }
+            sliced_str<contiguous_slice> operator[](contiguous_slice const& s) const { return sliced_str<contiguous_slice>(*this, s.normalize(size())); }
+
+            // conversion
+            operator long();
+            explicit operator bool() const {return size() > 0;}
+            bool operator!() const { return not bool();}
+
+            // io
+            friend  std::ostream& operator<<(std::ostream& os, types::sliced_str<S> const & v) {
+                for(auto b = v.begin(); b != v.end(); ++b)
+                    os << *b;
+                return os;
+            }
+        };
+
+        sliced_str<slice> str::operator()( slice const &s) const {
+            return operator[](s);
+        }
+        sliced_str<contiguous_slice> str::operator()( contiguous_slice const &s) const {
+            return operator[](s);
+        }
+
+        sliced_str<slice> str::operator[]( slice const &s ) const {
+            return sliced_str<slice>(*this, s.normalize(size()));
+        }
+        sliced_str<contiguous_slice> str::operator[]( contiguous_slice const &s ) const {
+            return sliced_str<contiguous_slice>(*this, s.normalize(size()));
+        }
+
         template<class S>
         str sliced_str<S>::operator+(sliced_str<S> const & s) {
-            str out(*data);
-            std::copy(s.begin(), s.end(), std::copy(begin(), end(), out.begin()));
-            return out;
+            str out(*this);
+            return out += s;
         }
 
         str operator+(str const& self, str const& other) {
-            return str(self.get_data() + other.get_data());
+            return str::concat(self.data(), self.size(), other.data(), other.size());
         }
 
         str operator+(str const& self, char const *s) {
-            return str(self.get_data() + s);
+            return str::concat(self.data(), self.size(), s, strlen(s));
         }
 
         str operator+(char const *s, str const& other) {
-            return str(s + other.get_data());
+            return str::concat(s, strlen(s), other.data(), other.size());
         }
         bool operator==(char c, str const& s) {
             return s.size() == 1 and s[0] == c;
@@ -342,7 +650,7 @@ namespace pythonic {
             return s.size() != 1 or s[0] != c;
         }
         std::ostream& operator<<(std::ostream& os, str const & s) {
-            return os << s.c_str();
+            return os.write(s.data(), s.size());
         }
 
     }
@@ -351,13 +659,12 @@ namespace pythonic {
 }
 
 pythonic::types::str operator*(pythonic::types::str const & s, long n) {
-    if(n<0)
-        return pythonic::types::str();
     pythonic::types::str other;
-    other.resize(s.size()*n);
-    auto where = other.begin();
-    for(long i=0;i<n; i++, where+=s.size())
-        std::copy(s.begin(), s.end(), where);
+    if(n<=0)
+        return other;
+    other.reserve(s.size()*n);
+    for(long i=0;i<n; i++)
+        other += s;
     return other;
 }
 
@@ -375,8 +682,10 @@ pythonic::types::sliced_str<S>& pythonic::types::sliced_str<S>::operator=(python
 template<class S>
 pythonic::types::sliced_str<S>& pythonic::types::sliced_str<S>::operator=(pythonic::types::str const & s) {
     if( slicing.step == 1) {
-        data->erase(slicing.lower, slicing.upper);
-        data->insert(slicing.lower, s.get_data());
+        pythonic::types::str out = data.substr(0, slicing.lower);
+        out += s;
+        out += data.substr(slicing.upper);
+        data = out;
     }
     else {
         assert("not implemented yet");
@@ -385,13 +694,12 @@ pythonic::types::sliced_str<S>& pythonic::types::sliced_str<S>::operator=(python
 }
 
 template<class S>
-pythonic::types::sliced_str<S>::sliced_str(pythonic::types::str const& other, typename S::normalized_type const & s) : data(other.data), slicing(s){}
-
+pythonic::types::sliced_str<S>::sliced_str(pythonic::types::str const& other, typename S::normalized_type const & s) : data(other), slicing(s){}
 
 template<class S>
 pythonic::types::sliced_str<S>::operator long() {
     long out;
-    std::istringstream iss(pythonic::types::str(*this).get_data());
+    std::istringstream iss(std::string(begin(), end()));
     iss >> out;
     return out;
 }
@@ -401,7 +709,7 @@ namespace std {
     {
         size_t operator()(const pythonic::types::str & x) const
         {
-            return hash<std::string>()(x.get_data());
+            return x.hash();
         }
     };
 }
@@ -433,8 +741,26 @@ namespace std {
 #ifdef ENABLE_PYTHON_MODULE
 
 #include "pythonic/python/register_once.hpp"
+#include "pythonic/python/extract.hpp"
 
 namespace pythonic {
+    template<>
+        struct _extract<types::str> {
+            types::str operator()(PyObject* obj) {
+                if(PyString_CheckExact(obj))
+                    return types::str(PyString_AS_STRING(obj), PyString_GET_SIZE(obj));
+                else
+                    return boost::python::extract<types::str>(obj);
+            }
+        };
+
+    template<>
+        struct _to_python<types::str> {
+            PyObject* operator()(types::str const& v) {
+                return PyString_FromStringAndSize(v.data(), v.size());
+            }
+        };
+
     template<>
         struct python_to_pythran< types::str >{
             python_to_pythran(){
@@ -457,7 +783,7 @@ namespace pythonic {
         };
     struct custom_pythran_string_to_str{
         static PyObject* convert(const types::str& v){
-            return PyString_FromStringAndSize(v.c_str(), v.size());
+            return PyString_FromStringAndSize(v.data(), v.size());
         }
     };
 
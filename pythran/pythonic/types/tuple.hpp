@@ -507,6 +507,7 @@ namespace pythonic {
 #ifdef ENABLE_PYTHON_MODULE
 
 #include "pythonic/python/register_once.hpp"
+#include "pythonic/python/extract.hpp"
 #include "pythonic/utils/seq.hpp"
 #include "pythonic/utils/fwd.hpp"
 
@@ -530,7 +531,7 @@ namespace pythonic {
             template<int ...S>
                 static void do_construct(PyObject* obj_ptr, boost::python::converter::rvalue_from_python_stage1_data* data, utils::seq<S...>){
                     void* storage=((boost::python::converter::rvalue_from_python_storage<std::tuple<Types...>>*)(data))->storage.bytes;
-                    new (storage) std::tuple<Types...>( boost::python::extract< typename std::tuple_element<S-1, std::tuple<Types...> >::type >(PyTuple_GetItem(obj_ptr,S-1))...);
+                    new (storage) std::tuple<Types...>( extract< typename std::tuple_element<S-1, std::tuple<Types...> >::type >(PyTuple_GET_ITEM(obj_ptr,S-1))...);
                     data->convertible=storage;
                 }
 
@@ -557,7 +558,7 @@ namespace pythonic {
             template<int ...S>
                 static void do_construct(PyObject* obj_ptr, boost::python::converter::rvalue_from_python_stage1_data* data, utils::seq<S...>){
                     void* storage=((boost::python::converter::rvalue_from_python_storage<types::array<T,N>>*)(data))->storage.bytes;
-                    new (storage) types::array<T,N>{{boost::python::extract<T>(PyTuple_GetItem(obj_ptr,S - 1))...}};
+                    new (storage) types::array<T,N>{{extract<T>(PyTuple_GET_ITEM(obj_ptr,S - 1))...}};
                     data->convertible=storage;
                 }
 
@@ -568,9 +569,10 @@ namespace pythonic {
     template<typename K, typename V>
         struct custom_pair_to_tuple {
             static PyObject* convert(std::pair<K,V> const & t) {
-                return PyTuple_Pack(2,
-                        boost::python::incref(boost::python::object(t.first).ptr()),
-                        boost::python::incref(boost::python::object(t.second).ptr()));
+                PyObject* obj = PyTuple_New(2);
+                PyTuple_SET_ITEM(obj, 0, to_python<K>(t.first));
+                PyTuple_SET_ITEM(obj, 1, to_python<V>(t.second));
+                return obj;
             }
         };
 
@@ -587,7 +589,9 @@ namespace pythonic {
         struct custom_tuple_to_tuple {
             template<int ...S>
                 static PyObject* do_convert( std::tuple<Types...> const & t, utils::seq<S...>) {
-                    return PyTuple_Pack(sizeof...(Types), boost::python::incref(boost::python::object(std::get<S - 1>(t)).ptr())...);
+                    PyObject* obj = PyTuple_New(sizeof...(Types));
+                    utils::fwd(PyTuple_SET_ITEM(obj, S - 1, to_python<Types>(std::get<S - 1>(t)))...);
+                    return obj;
                 }
             static PyObject* convert(std::tuple<Types...> const & t) {
                 return do_convert(t, typename utils::gens< 1 + sizeof...(Types) >::type());
@@ -608,7 +612,7 @@ namespace pythonic {
                 size_t n = t.size();
                 PyObject* obj = PyTuple_New(n);
                 for(size_t i=0; i<n; ++i)
-                    PyTuple_SET_ITEM(obj, i, boost::python::incref(boost::python::object(t[i]).ptr()));
+                    PyTuple_SET_ITEM(obj, i, to_python<T>(t[i]));
                 return obj;
             }
         };
@@ -1,5 +1,21 @@
 #ifndef PYTHONIC_TYPES_VECTORIZABLE_TYPE_HPP
 #define PYTHONIC_TYPES_VECTORIZABLE_TYPE_HPP
+
+#include <cstdint>
+#include <type_traits>
+
+#ifdef USE_BOOST_SIMD
+#include <boost/simd/sdk/simd/native.hpp>
+#include <boost/simd/include/functions/aligned_load.hpp>
+#include <boost/simd/include/functions/bitwise_cast.hpp>
+#include <boost/simd/include/functions/group.hpp>
+#include <boost/simd/include/functions/split_high.hpp>
+#include <boost/simd/include/functions/split_low.hpp>
+#include <boost/simd/include/functions/tofloat.hpp>
+#include <boost/simd/include/functions/toint.hpp>
+#include <boost/simd/include/functions/touint.hpp>
+#endif
+
 namespace pythonic {
 
 namespace operator_ {
@@ -11,27 +27,230 @@ struct mod;
 namespace numpy {
 namespace proxy {
 struct mod;
-struct logaddexp2;
 }
 }
 
 namespace types {
 
+template<class Op, class Arg0, class Arg1>
+  struct numpy_expr;
+template<class Op, class Arg>
+  struct numpy_uexpr;
+
 template<class T>
   struct is_vectorizable {
     static const bool value = std::is_fundamental<T>::value and not std::is_same<T, bool>::value;
   };
 
-template<class O>
+/* Operands of dtype S can be converted to dtype T on vector registers
+ *
+ * Elements of the same width are converted in place. Widening a register
+ * splits it into two registers of twice wider elements, narrowing groups two
+ * registers into one. Wider gaps, such as int8 to float64, run in scalar form.
+ */
+template<class S, class T>
+  struct is_vector_cast {
+    static const bool value = is_vectorizable<S>::value and is_vectorizable<T>::value and
+                              sizeof(S) <= 8 and sizeof(T) <= 8 and
+                              (sizeof(S) == sizeof(T) or 2 * sizeof(S) == sizeof(T) or sizeof(S) == 2 * sizeof(T));
+  };
+
+/* Operators that cannot be evaluated on vector registers of dtype T
+ * specialize this trait to false, so that expressions using them run in
+ * scalar form
+ */
+template<class O, class T>
   struct is_vector_op {
+    static const bool value = true;
+  };
+
+// there is no vector integer division, integer modulo stays scalar
+template<class T>
+  struct is_vector_op<operator_::proxy::mod, T> {
+    static const bool value = not std::is_integral<T>::value;
+  };
+template<class T>
+  struct is_vector_op<numpy::proxy::mod, T> {
+    static const bool value = not std::is_integral<T>::value;
+  };
+
+#ifdef USE_BOOST_SIMD
+/* Conversions between vector registers of the same width
+ *
+ * Integers and floating point values of the same size are converted with the
+ * Boost.SIMD conversion functions, integers of the same size are merely
+ * reinterpreted, as a static_cast would do.
+ */
+template<class T, class S, class X>
+  typename std::enable_if<std::is_integral<S>::value and std::is_floating_point<T>::value,
+                          boost::simd::native<T, X>>::type
+  vconvert(boost::simd::native<S, X> const& v) {
+    return boost::simd::tofloat(v);
+  }
+
+template<class T, class S, class X>
+  typename std::enable_if<std::is_floating_point<S>::value and std::is_signed<T>::value and std::is_integral<T>::value,
+                          boost::simd::native<T, X>>::type
+  vconvert(boost::simd::native<S, X> const& v) {
+    return boost::simd::toint(v);
+  }
+
+template<class T, class S, class X>
+  typename std::enable_if<std::is_floating_point<S>::value and std::is_unsigned<T>::value,
+                          boost::simd::native<T, X>>::type
+  vconvert(boost::simd::native<S, X> const& v) {
+    return boost::simd::touint(v);
+  }
+
+template<class T, class S, class X>
+  typename std::enable_if<std::is_integral<S>::value and std::is_integral<T>::value,
+                          boost::simd::native<T, X>>::type
+  vconvert(boost::simd::native<S, X> const& v) {
+    return boost::simd::bitwise_cast<boost::simd::native<T, X>>(v);
+  }
+
+// same as vconvert, but also accepts registers that already have dtype T
+template<class T, class X>
+  boost::simd::native<T, X> vrecast(boost::simd::native<T, X> const& v) {
+    return v;
+  }
+
+template<class T, class S, class X>
+  typename std::enable_if<not std::is_same<S, T>::value, boost::simd::native<T, X>>::type
+  vrecast(boost::simd::native<S, X> const& v) {
+    return vconvert<T>(v);
+  }
+
+// dtype of N bytes of the same kind as T, floating point or integer
+template<size_t N> struct vsized_int;
+template<> struct vsized_int<1> { typedef int8_t type; };
+template<> struct vsized_int<2> { typedef int16_t type; };
+template<> struct vsized_int<4> { typedef int32_t type; };
+template<> struct vsized_int<8> { typedef int64_t type; };
 
-    // vectorize everything but these ops. They require special handling for
-    // vectorization, and SG did not invest enough time in those
-    static const bool value = not std::is_same<O, numpy::proxy::mod>::value and
-                              not std::is_same<O, operator_::proxy::mod>::value and
-                              not std::is_same<O, numpy::proxy::logaddexp2>::value;
+template<class T, size_t N>
+  struct vsized {
+    typedef typename std::conditional<std::is_floating_point<T>::value,
+                                      typename std::conditional<N == sizeof(float), float, double>::type,
+                                      typename vsized_int<N>::type
+                                     >::type type;
   };
 
+/* Vector load of an operand, converted to the dtype T of the enclosing expression
+ *
+ * Operands that already have the right dtype are loaded directly. The others
+ * are loaded in their own dtype then converted on registers, see
+ * is_vector_cast. A register of a narrower operand holds twice as many
+ * elements as needed: aligned loads, whose index is a multiple of the
+ * register of T, take the half of the enclosing register that holds them;
+ * unaligned ones load the register starting at i and take its lower half.
+ * Loops over such expressions stop vector_step elements before the end.
+ */
+template<class T, bool aligned>
+  struct vcast {
+    template<class E>
+      auto operator()(E const& e, long i) const -> decltype(e.load(i)) {
+        return e.load(i);
+      }
+  };
+
+template<class T>
+  struct vcast<T, true> {
+    template<class E>
+      auto operator()(E const& e, long i) const -> decltype(e.aligned_load(i)) {
+        return e.aligned_load(i);
+      }
+  };
+
+template<class T, class E, bool aligned>
+  typename std::enable_if<std::is_same<T, typename E::dtype>::value,
+                          decltype(vcast<T, aligned>()(std::declval<E const&>(), 0L))>::type
+  vload(E const& e, long i, std::integral_constant<bool, aligned>) {
+    return vcast<T, aligned>()(e, i);
+  }
+
+template<class T, class E, bool aligned>
+  typename std::enable_if<not std::is_same<T, typename E::dtype>::value and sizeof(T) == sizeof(typename E::dtype),
+                          boost::simd::native<T, BOOST_SIMD_DEFAULT_EXTENSION>>::type
+  vload(E const& e, long i, std::integral_constant<bool, aligned>) {
+    return vconvert<T>(vcast<typename E::dtype, aligned>()(e, i));
+  }
+
+template<class T, class E, bool aligned>
+  typename std::enable_if<sizeof(T) == 2 * sizeof(typename E::dtype),
+                          boost::simd::native<T, BOOST_SIMD_DEFAULT_EXTENSION>>::type
+  vload(E const& e, long i, std::integral_constant<bool, aligned>) {
+    typedef typename E::dtype S;
+    static const long vN = boost::simd::meta::cardinal_of<boost::simd::native<S, BOOST_SIMD_DEFAULT_EXTENSION>>::value;
+    long const j = aligned ? i / vN * vN : i;
+    auto const v = vcast<S, aligned>()(e, j);
+    return vrecast<T>(i == j ? boost::simd::split_low(v) : boost::simd::split_high(v));
+  }
+
+template<class T, class E, bool aligned>
+  typename std::enable_if<2 * sizeof(T) == sizeof(typename E::dtype),
+                          boost::simd::native<T, BOOST_SIMD_DEFAULT_EXTENSION>>::type
+  vload(E const& e, long i, std::integral_constant<bool, aligned>) {
+    typedef typename E::dtype S;
+    typedef typename vsized<T, sizeof(S)>::type W;
+    static const long vN = boost::simd::meta::cardinal_of<boost::simd::native<S, BOOST_SIMD_DEFAULT_EXTENSION>>::value;
+    return vrecast<T>(boost::simd::group(vrecast<W>(vcast<S, aligned>()(e, i)),
+                                         vrecast<W>(vcast<S, aligned>()(e, i + vN))));
+  }
+
+/* Number of elements a vector loop over E needs before it can load a register
+ *
+ * This is the number of elements of a register of E's dtype, unless an
+ * operand of E has a narrower dtype: loading it reads a whole register of
+ * that dtype, see vload.
+ */
+template<class E>
+  struct vector_step {
+    static const long value = boost::simd::meta::cardinal_of<boost::simd::native<typename E::dtype, BOOST_SIMD_DEFAULT_EXTENSION>>::value;
+  };
+
+template<class Op, class Arg0, class Arg1>
+  struct vector_step<numpy_expr<Op, Arg0, Arg1>> {
+    static const long self = boost::simd::meta::cardinal_of<boost::simd::native<typename numpy_expr<Op, Arg0, Arg1>::dtype, BOOST_SIMD_DEFAULT_EXTENSION>>::value;
+    static const long step0 = vector_step<typename std::remove_cv<typename std::remove_reference<Arg0>::type>::type>::value;
+    static const long step1 = vector_step<typename std::remove_cv<typename std::remove_reference<Arg1>::type>::type>::value;
+    static const long args = step0 > step1 ? step0 : step1;
+    static const long value = self > args ? self : args;
+  };
+
+template<class Op, class Arg>
+  struct vector_step<numpy_uexpr<Op, Arg>> {
+    static const long self = boost::simd::meta::cardinal_of<boost::simd::native<typename numpy_uexpr<Op, Arg>::dtype, BOOST_SIMD_DEFAULT_EXTENSION>>::value;
+    static const long arg = vector_step<typename std::remove_cv<typename std::remove_reference<Arg>::type>::type>::value;
+    static const long value = self > arg ? self : arg;
+  };
+
+/* Gather loads, used by views whose elements are not contiguous in memory
+ *
+ * The elements are collected into an aligned buffer then loaded as a whole,
+ * which the compiler turns into a hardware gather when the target has one.
+ */
+template<class T>
+  boost::simd::native<T, BOOST_SIMD_DEFAULT_EXTENSION> vgather(T const* base, long const* indices) {
+    typedef boost::simd::native<T, BOOST_SIMD_DEFAULT_EXTENSION> vT;
+    static const long vN = boost::simd::meta::cardinal_of<vT>::value;
+    alignas(sizeof(vT)) T tmp[vN];
+    for(long k = 0; k < vN; ++k)
+      tmp[k] = base[indices[k]];
+    return boost::simd::aligned_load<vT>(tmp, 0);
+  }
+
+template<class T>
+  boost::simd::native<T, BOOST_SIMD_DEFAULT_EXTENSION> vgather(T const* base, long stride) {
+    typedef boost::simd::native<T, BOOST_SIMD_DEFAULT_EXTENSION> vT;
+    static const long vN = boost::simd::meta::cardinal_of<vT>::value;
+    alignas(sizeof(vT)) T tmp[vN];
+    for(long k = 0; k < vN; ++k)
+      tmp[k] = base[k * stride];
+    return boost::simd::aligned_load<vT>(tmp, 0);
+  }
+#endif
+
 }
 
 }
@@ -0,0 +1,319 @@
+#ifndef PYTHONIC_UTILS_ALLOCATE_HPP
+#define PYTHONIC_UTILS_ALLOCATE_HPP
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstddef>
+#include <new>
+#include <atomic>
+
+#ifdef PYTHRAN_ALLOCATOR_STATS
+#include <iostream>
+#endif
+
+/* Allocation policies for array storage
+ *
+ * The policy is selected at compile time, through a macro (or the
+ * ``allocator'' option from the ``pythran'' section of pythran.cfg):
+ *
+ * - by default, plain malloc / free are used;
+ * - PYTHRAN_ALLOCATOR_POOL rounds requests up to a power of two and keeps
+ *   freed blocks in per-thread free lists, one per size class;
+ * - PYTHRAN_ALLOCATOR_ARENA bump-allocates from per-thread chunks, a chunk
+ *   being reused as soon as all the blocks it holds are dead, which happens
+ *   at the end of each call for temporaries.
+ *
+ * With a non-default policy, the buffer of an array is stored in the same
+ * block as its reference counter, see ``utils::shared_ref''.
+ *
+ * Defining PYTHRAN_ALLOCATOR_STATS dumps the allocation counters on exit.
+ */
+
+// alignment of array buffers, in bytes. Buffers are also padded to a multiple
+// of this value, so that it must be at least the width of a SIMD register
+#ifndef PYTHRAN_ARRAY_ALIGNMENT
+#define PYTHRAN_ARRAY_ALIGNMENT 64
+#endif
+
+// upper bound of the memory kept in the per-thread free lists of the pool
+#ifndef PYTHRAN_ALLOCATOR_POOL_LIMIT
+#define PYTHRAN_ALLOCATOR_POOL_LIMIT (64UL << 20)
+#endif
+
+// size of the chunks the arena allocates from
+#ifndef PYTHRAN_ALLOCATOR_ARENA_CHUNK
+#define PYTHRAN_ALLOCATOR_ARENA_CHUNK (8UL << 20)
+#endif
+
+namespace pythonic {
+
+    namespace utils {
+
+        // size of a buffer of n bytes, once padded
+        inline size_t padded_size(size_t n) {
+            return (n + PYTHRAN_ARRAY_ALIGNMENT - 1) / PYTHRAN_ARRAY_ALIGNMENT * PYTHRAN_ARRAY_ALIGNMENT;
+        }
+
+        // malloc counterpart returning PYTHRAN_ARRAY_ALIGNMENT-aligned memory, to be released with free
+        inline void* aligned_malloc(size_t n) {
+            void * p;
+            if(posix_memalign(&p, PYTHRAN_ARRAY_ALIGNMENT, n))
+                return nullptr;
+            return p;
+        }
+
+        /* Allocation counters
+         *
+         * ``requests'' counts every allocation, ``hits'' the ones served
+         * without calling the system allocator
+         */
+        struct allocation_stats {
+            std::atomic<size_t> requests;
+            std::atomic<size_t> hits;
+
+            allocation_stats() : requests(0), hits(0) {}
+
+            double hit_rate() const {
+                return requests ? double(hits) / double(requests) : 0.;
+            }
+
+#ifdef PYTHRAN_ALLOCATOR_STATS
+            ~allocation_stats() {
+                std::cerr << "pythran allocator: " << requests << " requests, "
+                          << hits << " hits (" << 100 * hit_rate() << "%)" << std::endl;
+            }
+#endif
+        };
+
+        inline allocation_stats& allocator_stats() {
+            static allocation_stats stats;
+            return stats;
+        }
+
+#ifdef PYTHRAN_ALLOCATOR_STATS
+        inline void count_request(bool hit) {
+            allocation_stats & stats = allocator_stats();
+            stats.requests.fetch_add(1, std::memory_order_relaxed);
+            if(hit)
+                stats.hits.fetch_add(1, std::memory_order_relaxed);
+        }
+#else
+        inline void count_request(bool) {}
+#endif
+
+        /* Plain system allocator, the default */
+        struct malloc_allocator {
+            // whether array buffers are stored next to their reference counter
+            static const bool coallocate = false;
+            static const size_t alignment = 16;
+
+            static void* allocate(size_t n) {
+                count_request(false);
+                void * p = malloc(n);
+                if(not p) throw std::bad_alloc();
+                return p;
+            }
+            static void deallocate(void* p) {
+                free(p);
+            }
+        };
+
+        /* Every block handed out by the pool and the arena is preceded by this
+         * header, so that deallocation does not need the block size.
+         */
+        union block_header {
+            struct {
+                void* owner;  // chunk for the arena, nullptr for large blocks
+                size_t klass; // size class for the pool
+            } info;
+            char padding[PYTHRAN_ARRAY_ALIGNMENT]; // keep the payload aligned
+        };
+
+        /* Size-class pool
+         *
+         * class k holds blocks of 2^k bytes, header included. Blocks larger
+         * than the largest class go straight to the system allocator.
+         */
+        struct pool_allocator {
+            static const bool coallocate = true;
+            static const size_t alignment = sizeof(block_header);
+
+            static const size_t min_class = 7;   // 128 bytes
+            static const size_t max_class = 26;  // 64 Mbytes
+            static const size_t large = max_class + 1;
+
+            struct free_lists {
+                void* heads[max_class + 1];
+                size_t cached;  // bytes kept in the lists
+
+                free_lists() : cached(0) { std::fill(heads, heads + max_class + 1, nullptr); }
+                ~free_lists() {
+                    for(void*& head : heads)
+                        while(head) {
+                            void* next = *static_cast<void**>(head);
+                            free(static_cast<block_header*>(head) - 1);
+                            head = next;
+                        }
+                    gone() = true;
+                }
+            };
+
+            static free_lists& lists() {
+                thread_local static free_lists self;
+                return self;
+            }
+
+            /* Set once the lists of the thread are destroyed
+             *
+             * Blocks are still allocated and released after that, e.g. by static
+             * arrays at exit: they then go to the system. A trivially destructible
+             * flag stays readable when the lists are not.
+             */
+            static bool& gone() {
+                thread_local static bool self = false;
+                return self;
+            }
+
+            static size_t size_class(size_t n) {
+                size_t k = min_class;
+                while(k <= max_class and (size_t(1) << k) < n)
+                    ++k;
+                return k;
+            }
+
+            static void* allocate(size_t n) {
+                size_t klass = size_class(n + sizeof(block_header));
+                block_header * h;
+                if(klass != large) {
+                    if(not gone()) {
+                        free_lists & fl = lists();
+                        if(void* head = fl.heads[klass]) {
+                            fl.heads[klass] = *static_cast<void**>(head);
+                            fl.cached -= size_t(1) << klass;
+                            count_request(true);
+                            return head;
+                        }
+                    }
+                    h = static_cast<block_header*>(aligned_malloc(size_t(1) << klass));
+                }
+                else
+                    h = static_cast<block_header*>(aligned_malloc(n + sizeof(block_header)));
+                count_request(false);
+                if(not h) throw std::bad_alloc();
+                h->info.owner = nullptr;
+                h->info.klass = klass;
+                return h + 1;
+            }
+
+            static void deallocate(void* p) {
+                block_header * h = static_cast<block_header*>(p) - 1;
+                size_t klass = h->info.klass;
+                if(klass != large and not gone()) {
+                    free_lists & fl = lists();
+                    if(fl.cached + (size_t(1) << klass) <= PYTHRAN_ALLOCATOR_POOL_LIMIT) {
+                        *static_cast<void**>(p) = fl.heads[klass];
+                        fl.heads[klass] = p;
+                        fl.cached += size_t(1) << klass;
+                        return;
+                    }
+                }
+                free(h);
+            }
+        };
+
+        /* Per-thread arena
+         *
+         * A chunk holds one reference for its owning thread plus one per live
+         * block. The owner rewinds the chunk when it holds the only reference,
+         * and releases its reference when it moves to a new chunk; the last
+         * block freed then releases the chunk, whatever the thread.
+         */
+        struct arena_allocator {
+            static const bool coallocate = true;
+            static const size_t alignment = sizeof(block_header);
+
+            struct chunk {
+                std::atomic<long> refcount;
+                size_t offset;
+                size_t capacity;
+
+                static const size_t header = (sizeof(std::atomic<long>) + 2 * sizeof(size_t) + alignment - 1) / alignment * alignment;
+                char* data() { return reinterpret_cast<char*>(this) + header; }
+            };
+
+            struct current_chunk {
+                chunk * self;
+                current_chunk() : self(nullptr) {}
+                ~current_chunk() { release(self); self = nullptr; gone() = true; }
+            };
+
+            static current_chunk& current() {
+                thread_local static current_chunk self;
+                return self;
+            }
+
+            // set once the chunk of the thread is released, see pool_allocator::gone
+            static bool& gone() {
+                thread_local static bool self = false;
+                return self;
+            }
+
+            static void release(chunk* c) {
+                if(c and c->refcount.fetch_sub(1) == 1)
+                    free(c);
+            }
+
+            static void* allocate(size_t n) {
+                size_t bytes = (n + sizeof(block_header) + alignment - 1) / alignment * alignment;
+                block_header * h;
+                if(bytes > PYTHRAN_ALLOCATOR_ARENA_CHUNK / 4 or gone()) {
+                    count_request(false);
+                    h = static_cast<block_header*>(aligned_malloc(bytes));
+                    if(not h) throw std::bad_alloc();
+                    h->info.owner = nullptr;
+                    return h + 1;
+                }
+                chunk *& c = current().self;
+                if(c and c->refcount.load() == 1) // every block from the chunk is dead
+                    c->offset = 0;
+                if(c and c->offset + bytes <= c->capacity)
+                    count_request(true);
+                else {
+                    count_request(false);
+                    release(c);
+                    void * raw = aligned_malloc(chunk::header + PYTHRAN_ALLOCATOR_ARENA_CHUNK);
+                    if(not raw) throw std::bad_alloc();
+                    c = new (raw) chunk();
+                    c->refcount.store(1);
+                    c->offset = 0;
+                    c->capacity = PYTHRAN_ALLOCATOR_ARENA_CHUNK;
+                }
+                h = reinterpret_cast<block_header*>(c->data() + c->offset);
+                c->offset += bytes;
+                c->refcount.fetch_add(1);
+                h->info.owner = c;
+                return h + 1;
+            }
+
+            static void deallocate(void* p) {
+                block_header * h = static_cast<block_header*>(p) - 1;
+                if(h->info.owner)
+                    release(static_cast<chunk*>(h->info.owner));
+                else
+                    free(h);
+            }
+        };
+
+#if defined(PYTHRAN_ALLOCATOR_POOL)
+        typedef pool_allocator allocator;
+#elif defined(PYTHRAN_ALLOCATOR_ARENA)
+        typedef arena_allocator allocator;
+#else
+        typedef malloc_allocator allocator;
+#endif
+
+    }
+
+}
+
+#endif
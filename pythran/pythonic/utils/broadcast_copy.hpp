@@ -6,14 +6,15 @@
 #include <boost/simd/sdk/simd/native.hpp>
 #endif
 
-#ifdef _OPENMP
-#include <omp.h>
+#include "pythonic/types/op_cost.hpp"
+#include "pythonic/types/vectorizable_type.hpp"
+#include "pythonic/utils/omp_cost.hpp"
 
-// as a macro so that an enlightened user can modify this non-documented variable :-)
-#ifndef PYTHRAN_OPENMP_MIN_ITERATION_COUNT
-#define PYTHRAN_OPENMP_MIN_ITERATION_COUNT 1000
-#endif
+#include <algorithm>
+#include <numeric>
 
+#ifdef _OPENMP
+#include <omp.h>
 #endif
 
 namespace pythonic {
@@ -41,6 +42,12 @@ namespace pythonic {
         SPECIALIZE_DIM_OF(std::complex<double>);
 #undef SPECIALIZE_DIM_OF
 
+      /* number of elements in a row of e, one for one-dimensional expressions */
+      template <class E>
+      long _row_size(E const& e) {
+        return std::accumulate(e.shape.begin() + 1, e.shape.end(), 1L, std::multiplies<long>());
+      }
+
       /* helper for specialization of the broadcasting, vectorizing copy operator
        * due to expression templates, this may also triggers a lot of computations!
        *
@@ -69,10 +76,12 @@ namespace pythonic {
                other_size = std::distance(other.begin(), other.end());
           if (other_size > 0) { // empty array sometimes happen when filtering
 #ifdef _OPENMP
-            if (other_size >= PYTHRAN_OPENMP_MIN_ITERATION_COUNT)
-              #pragma omp parallel for
+            if (utils::omp_worth(other_size, types::expr_cost<F>::value * _row_size(other))) {
+              long const chunk = utils::omp_chunk(other_size, types::expr_cost<F>::value * _row_size(other));
+              #pragma omp parallel for schedule(dynamic, chunk)
               for(long i = 0; i < other_size; ++i)
                 self.fast(i) = other.fast(i);
+            }
             else
 #endif
               for(long i = 0; i < other_size; ++i)
@@ -82,10 +91,12 @@ namespace pythonic {
             // eventually repeat the pattern
             size_t n = self_size / other_size;
 #ifdef _OPENMP
-            if (n >= PYTHRAN_OPENMP_MIN_ITERATION_COUNT)
-              #pragma omp parallel for
+            if (utils::omp_worth(n, other_size * _row_size(self))) {
+              long const chunk = utils::omp_chunk(n, other_size * _row_size(self));
+              #pragma omp parallel for schedule(dynamic, chunk)
               for (size_t i = 1; i < n; ++i)
                 std::copy_n(self.begin(), other_size, self.begin() + i * other_size);
+            }
             else
 #endif
               for (size_t i = 1; i < n; ++i)
@@ -99,10 +110,12 @@ namespace pythonic {
           self.fast(0) = other;
           long n = self.shape[0];
 #ifdef _OPENMP
-            if (n >= PYTHRAN_OPENMP_MIN_ITERATION_COUNT)
-              #pragma omp parallel for
+            if (utils::omp_worth(n, _row_size(self))) {
+              long const chunk = utils::omp_chunk(n, _row_size(self));
+              #pragma omp parallel for schedule(dynamic, chunk)
               for(long i = 1; i < n; ++i)
                 self.fast(i) = self.fast(0);
+            }
             else
 #endif
               for(long i = 1; i < n; ++i)
@@ -111,6 +124,46 @@ namespace pythonic {
       };
 
 #ifdef USE_BOOST_SIMD
+      /* runtime check of the alignment of an expression, guarded by the
+       * ``is_aligned'' trait so that only expressions that may be aligned are
+       * queried
+       */
+      template <class E>
+      typename std::enable_if<std::remove_reference<E>::type::is_aligned, bool>::type
+      _is_aligned(E const& e) { return e.aligned(); }
+      template <class E>
+      typename std::enable_if<not std::remove_reference<E>::type::is_aligned, bool>::type
+      _is_aligned(E const&) { return false; }
+
+      /* copy using aligned accesses, only instantiated when both expressions
+       * may be aligned. The elements past the last full register are copied
+       * in scalar form: evaluating the expression on the padding would read
+       * uninitialized values, and may divide by zero or produce denormals.
+       * Operands of a narrower dtype are read by whole registers, see vload.
+       */
+      template <class vT, class E, class F>
+      void _aligned_copy(E &&self, F const &other, long other_size, std::true_type) {
+        static const long vN = boost::simd::meta::cardinal_of<vT>::value;
+        static const long vS = types::vector_step<F>::value;
+        const long bound = other_size / vS * vS;
+        long i;
+#ifdef _OPENMP
+        if (utils::omp_worth(bound / vN, vN * types::expr_cost<F>::value)) {
+          long const chunk = utils::omp_chunk(bound / vN, vN * types::expr_cost<F>::value);
+          #pragma omp parallel for schedule(dynamic, chunk)
+          for (i = 0; i < bound; i += vN)
+            self.aligned_store(other.aligned_load(i), i);
+        }
+        else
+#endif
+          for (i = 0; i < bound; i += vN)
+            self.aligned_store(other.aligned_load(i), i);
+        for (i = bound; i < other_size; ++i)
+          self.fast(i) = other.fast(i);
+      }
+      template <class vT, class E, class F>
+      void _aligned_copy(E &&, F const &, long, std::false_type) {}
+
       // specialize for SIMD only if available
       // otherwise use the std::copy fallback
       template <> struct _broadcast_copy<true> {
@@ -123,27 +176,40 @@ namespace pythonic {
 
           if (other_size > 0) { // empty array sometimes happen when filtering
             static const std::size_t vN = boost::simd::meta::cardinal_of<vT>::value;
-            const long bound = other_size / vN * vN;
 
             long i;
+            if(_is_aligned(self) and _is_aligned(other)) {
+              // buffers are aligned
+              _aligned_copy<vT>(self, other, other_size,
+                                std::integral_constant<bool, std::remove_reference<E>::type::is_aligned and F::is_aligned>());
+            }
+            else {
+              // the last load reads vector_step elements
+              static const long vS = types::vector_step<F>::value;
+              const long bound = std::max(0L, other_size - vS + long(vN)) / long(vN) * long(vN);
 #ifdef _OPENMP
-            if (bound >= PYTHRAN_OPENMP_MIN_ITERATION_COUNT)
-              #pragma omp parallel for
-              for (i = 0; i < bound; i += vN)
-                self.store(other.load(i), i);
-            else
+              if (utils::omp_worth(bound / vN, vN * types::expr_cost<F>::value)) {
+                long const chunk = utils::omp_chunk(bound / vN, vN * types::expr_cost<F>::value);
+                #pragma omp parallel for schedule(dynamic, chunk)
+                for (i = 0; i < bound; i += vN)
+                  self.store(other.load(i), i);
+              }
+              else
 #endif
-              for (i = 0; i < bound; i += vN)
-                self.store(other.load(i), i);
-            for (; i < other_size; ++i)
-              self.fast(i) = other.fast(i);
+                for (i = 0; i < bound; i += vN)
+                  self.store(other.load(i), i);
+              for (i = bound; i < other_size; ++i)
+                self.fast(i) = other.fast(i);
+            }
 
             size_t n = self_size / other_size;
 #ifdef _OPENMP
-            if (n >= PYTHRAN_OPENMP_MIN_ITERATION_COUNT)
-              #pragma omp parallel for
+            if (utils::omp_worth(n, other_size * _row_size(self))) {
+              long const chunk = utils::omp_chunk(n, other_size * _row_size(self));
+              #pragma omp parallel for schedule(dynamic, chunk)
               for (size_t i = 1; i < n; ++i)
                 std::copy_n(self.begin(), other_size, self.begin() + i * other_size);
+            }
             else
 #endif
               for (size_t i = 1; i < n; ++i)
@@ -157,10 +223,12 @@ namespace pythonic {
                other_size = std::distance(other.begin(), other.end());
           if (other_size > 0) { // empty array sometimes happen when filtering
 #ifdef _OPENMP
-            if (other_size >= PYTHRAN_OPENMP_MIN_ITERATION_COUNT)
-              #pragma omp parallel for
+            if (utils::omp_worth(other_size, types::expr_cost<F>::value * _row_size(other))) {
+              long const chunk = utils::omp_chunk(other_size, types::expr_cost<F>::value * _row_size(other));
+              #pragma omp parallel for schedule(dynamic, chunk)
               for(long i = 0; i < other_size; ++i)
                 (*this)(self.fast(i), other.fast(i), utils::int_<N - 1>(), utils::int_<0>());
+            }
             else
 #endif
               for(long i = 0; i < other_size; ++i)
@@ -169,10 +237,12 @@ namespace pythonic {
             // eventually repeat the pattern
             size_t n = self_size / other_size;
 #ifdef _OPENMP
-            if (n >= PYTHRAN_OPENMP_MIN_ITERATION_COUNT)
-              #pragma omp parallel for
+            if (utils::omp_worth(n, other_size * _row_size(self))) {
+              long const chunk = utils::omp_chunk(n, other_size * _row_size(self));
+              #pragma omp parallel for schedule(dynamic, chunk)
               for (size_t i = 1; i < n; ++i)
                 std::copy_n(self.begin(), other_size, self.begin() + i * other_size);
+            }
             else
 #endif
               for (size_t i = 1; i < n; ++i)
@@ -186,10 +256,12 @@ namespace pythonic {
           (*this)(self.fast(0), other, utils::int_<N - 1>(), utils::int_<D - 1>());
           long n = self.shape[0];
 #ifdef _OPENMP
-            if (n >= PYTHRAN_OPENMP_MIN_ITERATION_COUNT)
-              #pragma omp parallel for
+            if (utils::omp_worth(n, _row_size(self))) {
+              long const chunk = utils::omp_chunk(n, _row_size(self));
+              #pragma omp parallel for schedule(dynamic, chunk)
               for(long i = 1; i < n; ++i)
                 self.fast(i) = self.fast(0);
+            }
             else
 #endif
               for(long i = 1; i < n; ++i)
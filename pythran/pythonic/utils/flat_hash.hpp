@@ -0,0 +1,385 @@
+#ifndef PYTHONIC_UTILS_FLAT_HASH_HPP
+#define PYTHONIC_UTILS_FLAT_HASH_HPP
+
+#include <boost/functional/hash.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+/* Open addressing hash tables
+ *
+ * Entries are stored densely in a deque, so that references to them survive
+ * insertions, in insertion order until an erasure moves the last entry into
+ * the freed place. They are indexed by a table of slots: an array of control
+ * bytes, that tell whether a slot is empty, deleted or holds an entry whose
+ * hash ends with these 7 bits, and an array of entry indices. Slots are probed
+ * linearly from the top bits of the hash, sixteen control bytes at a time,
+ * with SSE2 when available, so that most mismatching slots are skipped without
+ * looking at their entry. The table is kept at most 3/4 full.
+ */
+namespace pythonic {
+
+    namespace utils {
+
+        template<class Entry, class Key, class KeyOf, class Hash, class Eq>
+            class flat_table {
+
+                protected:
+
+                enum : signed char {
+                    empty_slot = -128,
+                    deleted_slot = -2 // full slots are >= 0
+                };
+
+                static const size_t group_size = 16;
+
+                // bit i of each mask is set if the control byte at p[i] matches
+                struct group {
+#ifdef __SSE2__
+                    __m128i bytes;
+                    explicit group(signed char const* p) : bytes(_mm_loadu_si128(reinterpret_cast<__m128i const*>(p))) {}
+                    unsigned match(signed char t) const {
+                        return _mm_movemask_epi8(_mm_cmpeq_epi8(bytes, _mm_set1_epi8(t)));
+                    }
+                    unsigned match_free() const { // empty or deleted slots have their sign bit set
+                        return _mm_movemask_epi8(bytes);
+                    }
+#else
+                    signed char const* p;
+                    explicit group(signed char const* p) : p(p) {}
+                    unsigned match(signed char t) const {
+                        unsigned m = 0;
+                        for(size_t i = 0; i < group_size; ++i)
+                            m |= unsigned(p[i] == t) << i;
+                        return m;
+                    }
+                    unsigned match_free() const {
+                        unsigned m = 0;
+                        for(size_t i = 0; i < group_size; ++i)
+                            m |= unsigned(p[i] < 0) << i;
+                        return m;
+                    }
+#endif
+                    unsigned match_empty() const { return match(empty_slot); }
+                };
+
+                std::deque<Entry> entries_;
+                // the first group_size control bytes are repeated at the end,
+                // so that a group can be read from any slot
+                std::vector<signed char> ctrl_;
+                std::vector<uint32_t> index_;
+                size_t tombstones_;
+                int shift_; // the first slot probed is hash >> shift_
+                Hash hash_;
+                Eq eq_;
+
+                uint64_t hash(Key const& k) const {
+                    // spread the bits of weak hashes, such as the identity on integers
+                    return uint64_t(hash_(k)) * 0x9E3779B97F4A7C15ULL;
+                }
+                static signed char tag(uint64_t h) { return h & 0x7F; }
+                size_t capacity() const { return index_.size(); }
+                size_t mask() const { return capacity() - 1; }
+                void set_ctrl(size_t s, signed char c) {
+                    ctrl_[s] = c;
+                    if(s < group_size)
+                        ctrl_[capacity() + s] = c;
+                }
+                size_t first_empty(uint64_t h) const {
+                    for(size_t s = h >> shift_; ; s = (s + group_size) & mask())
+                        if(unsigned empties = group(&ctrl_[s]).match_empty())
+                            return (s + __builtin_ctz(empties)) & mask();
+                }
+                // slot indexing entry i
+                size_t slot_of(size_t i) const {
+                    uint64_t const h = hash(KeyOf()(entries_[i]));
+                    for(size_t s = h >> shift_; ; s = (s + group_size) & mask())
+                        for(unsigned m = group(&ctrl_[s]).match(tag(h)); m; m &= m - 1) {
+                            size_t const slot = (s + __builtin_ctz(m)) & mask();
+                            if(index_[slot] == i)
+                                return slot;
+                        }
+                }
+
+                static size_t capacity_for(size_t n) {
+                    size_t capacity = group_size;
+                    while(capacity * 3 < n * 4)
+                        capacity *= 2;
+                    return capacity;
+                }
+                void rehash(size_t capacity) {
+                    ctrl_.assign(capacity + group_size, empty_slot);
+                    index_.assign(capacity, 0);
+                    shift_ = 64;
+                    for(size_t c = capacity; c > 1; c /= 2)
+                        --shift_;
+                    tombstones_ = 0;
+                    for(size_t i = 0; i < entries_.size(); ++i) {
+                        uint64_t const h = hash(KeyOf()(entries_[i]));
+                        size_t const s = first_empty(h);
+                        set_ctrl(s, tag(h));
+                        index_[s] = i;
+                    }
+                }
+
+                public:
+
+                flat_table() : tombstones_(0), shift_(64) {}
+
+                size_t size() const { return entries_.size(); }
+                bool empty() const { return entries_.empty(); }
+
+                void clear() {
+                    entries_.clear();
+                    ctrl_.clear();
+                    index_.clear();
+                    tombstones_ = 0;
+                }
+
+                // make room for n entries without rehashing
+                void reserve(size_t n) {
+                    if(capacity_for(n) > capacity())
+                        rehash(capacity_for(n));
+                }
+
+                // index of the entry with key k, size() if there is none
+                size_t find_index(Key const& k) const {
+                    if(index_.empty())
+                        return size();
+                    uint64_t const h = hash(k);
+                    for(size_t s = h >> shift_; ; s = (s + group_size) & mask()) {
+                        group const g(&ctrl_[s]);
+                        unsigned const empties = g.match_empty();
+                        unsigned m = g.match(tag(h));
+                        if(empties) // slots after the first empty one are not probed
+                            m &= (empties & -empties) - 1;
+                        for(; m; m &= m - 1) {
+                            size_t const i = index_[(s + __builtin_ctz(m)) & mask()];
+                            if(eq_(KeyOf()(entries_[i]), k))
+                                return i;
+                        }
+                        if(empties)
+                            return size();
+                    }
+                }
+
+                // index of the entry with key k, appending make() if there is
+                // none, and whether it was appended
+                template<class Make>
+                    std::pair<size_t, bool> insert_index(Key const& k, Make const& make) {
+                        uint64_t const h = hash(k);
+                        size_t target = capacity();
+                        if(not index_.empty()) {
+                            for(size_t s = h >> shift_; ; s = (s + group_size) & mask()) {
+                                group const g(&ctrl_[s]);
+                                unsigned const empties = g.match_empty();
+                                unsigned m = g.match(tag(h));
+                                if(empties)
+                                    m &= (empties & -empties) - 1;
+                                for(; m; m &= m - 1) {
+                                    size_t const i = index_[(s + __builtin_ctz(m)) & mask()];
+                                    if(eq_(KeyOf()(entries_[i]), k))
+                                        return std::make_pair(i, false);
+                                }
+                                unsigned const frees = g.match_free();
+                                if(target == capacity() and frees)
+                                    target = (s + __builtin_ctz(frees)) & mask();
+                                if(empties)
+                                    break;
+                            }
+                        }
+                        // a tombstone is reused as is, an empty slot may be the one too many
+                        if(target != capacity() and ctrl_[target] == deleted_slot)
+                            --tombstones_;
+                        else if((size() + tombstones_ + 1) * 4 > capacity() * 3) {
+                            rehash(std::max(capacity(), capacity_for(size() + 1)));
+                            target = first_empty(h);
+                        }
+                        entries_.push_back(make());
+                        set_ctrl(target, tag(h));
+                        index_[target] = size() - 1;
+                        return std::make_pair(size() - 1, true);
+                    }
+
+                void erase_index(size_t i) {
+                    size_t const s = slot_of(i);
+                    // probes stop on the next slot anyway if it is empty
+                    if(ctrl_[(s + 1) & mask()] == empty_slot)
+                        set_ctrl(s, empty_slot);
+                    else {
+                        set_ctrl(s, deleted_slot);
+                        ++tombstones_;
+                    }
+                    size_t const last = size() - 1;
+                    if(i != last) {
+                        index_[slot_of(last)] = i;
+                        entries_[i] = std::move(entries_[last]);
+                    }
+                    entries_.pop_back();
+                }
+            };
+
+        struct _first {
+            template<class P>
+                typename P::first_type const& operator()(P const& p) const { return p.first; }
+        };
+
+        /* map with the subset of the interface of std::unordered_map used by
+         * types::dict */
+        template<class K, class V, class Hash=boost::hash<K>, class Eq=std::equal_to<K>>
+            class flat_map : public flat_table<std::pair<K, V>, K, _first, Hash, Eq> {
+
+                typedef flat_table<std::pair<K, V>, K, _first, Hash, Eq> table;
+
+                public:
+
+                typedef K key_type;
+                typedef V mapped_type;
+                typedef std::pair<K, V> value_type;
+                typedef value_type& reference;
+                typedef value_type const& const_reference;
+                typedef value_type* pointer;
+                typedef value_type const* const_pointer;
+                typedef typename std::deque<value_type>::iterator iterator;
+                typedef typename std::deque<value_type>::const_iterator const_iterator;
+                typedef size_t size_type;
+                typedef std::ptrdiff_t difference_type;
+                typedef std::allocator<value_type> allocator_type;
+
+                flat_map() {}
+                explicit flat_map(size_t n) { this->reserve(n); }
+                template<class B, class E>
+                    flat_map(B begin, E end) {
+                        for(; begin != end; ++begin)
+                            insert(*begin);
+                    }
+                flat_map(std::initializer_list<value_type> l) : flat_map(l.begin(), l.end()) {}
+
+                iterator begin() { return this->entries_.begin(); }
+                const_iterator begin() const { return this->entries_.begin(); }
+                iterator end() { return this->entries_.end(); }
+                const_iterator end() const { return this->entries_.end(); }
+
+                iterator find(K const& k) { return begin() + this->find_index(k); }
+                const_iterator find(K const& k) const { return begin() + this->find_index(k); }
+                size_t count(K const& k) const { return this->find_index(k) != this->size(); }
+
+                V& operator[](K const& k) {
+                    size_t const i = this->insert_index(k, [&k]() { return value_type(k, V()); }).first;
+                    return this->entries_[i].second;
+                }
+
+                template<class P>
+                    std::pair<iterator, bool> insert(P const& p) {
+                        auto const r = this->insert_index(p.first, [&p]() { return value_type(p.first, p.second); });
+                        return std::make_pair(begin() + r.first, r.second);
+                    }
+
+                // the erased entry is replaced by the last one, which is the next to visit
+                iterator erase(const_iterator pos) {
+                    size_t const i = pos - begin();
+                    this->erase_index(i);
+                    return begin() + i;
+                }
+                size_t erase(K const& k) {
+                    size_t const i = this->find_index(k);
+                    if(i == this->size())
+                        return 0;
+                    this->erase_index(i);
+                    return 1;
+                }
+            };
+
+        struct _identity {
+            template<class T>
+                T const& operator()(T const& v) const { return v; }
+        };
+
+        /* set with the subset of the interface of std::set used by
+         * types::set. Elements are visited in insertion order, not sorted */
+        template<class T, class Hash=boost::hash<T>, class Eq=std::equal_to<T>>
+            class flat_set : public flat_table<T, T, _identity, Hash, Eq> {
+
+                public:
+
+                typedef T key_type;
+                typedef T value_type;
+                typedef value_type& reference;
+                typedef value_type const& const_reference;
+                typedef value_type* pointer;
+                typedef value_type const* const_pointer;
+                // elements are their own keys, they cannot be modified in place
+                typedef typename std::deque<value_type>::const_iterator iterator;
+                typedef typename std::deque<value_type>::const_iterator const_iterator;
+                typedef typename std::deque<value_type>::const_reverse_iterator reverse_iterator;
+                typedef typename std::deque<value_type>::const_reverse_iterator const_reverse_iterator;
+                typedef size_t size_type;
+                typedef std::ptrdiff_t difference_type;
+                typedef std::allocator<value_type> allocator_type;
+
+                flat_set() {}
+                explicit flat_set(size_t n) { this->reserve(n); }
+                template<class B, class E>
+                    flat_set(B begin, E end) {
+                        insert(begin, end);
+                    }
+                flat_set(std::initializer_list<value_type> l) : flat_set(l.begin(), l.end()) {}
+
+                const_iterator begin() const { return this->entries_.begin(); }
+                const_iterator end() const { return this->entries_.end(); }
+                const_reverse_iterator rbegin() const { return this->entries_.rbegin(); }
+                const_reverse_iterator rend() const { return this->entries_.rend(); }
+
+                const_iterator find(T const& v) const { return begin() + this->find_index(v); }
+                size_t count(T const& v) const { return this->find_index(v) != this->size(); }
+
+                std::pair<iterator, bool> insert(T const& v) {
+                    auto const r = this->insert_index(v, [&v]() { return v; });
+                    return std::make_pair(begin() + r.first, r.second);
+                }
+                template<class B, class E>
+                    void insert(B begin, E end) {
+                        for(; begin != end; ++begin)
+                            insert(*begin);
+                    }
+
+                // the erased element is replaced by the last one, which is the next to visit
+                iterator erase(const_iterator pos) {
+                    size_t const i = pos - begin();
+                    this->erase_index(i);
+                    return begin() + i;
+                }
+                size_t erase(T const& v) {
+                    size_t const i = this->find_index(v);
+                    if(i == this->size())
+                        return 0;
+                    this->erase_index(i);
+                    return 1;
+                }
+
+                template<class U, class H, class E>
+                    bool operator==(flat_set<U, H, E> const& other) const {
+                        if(this->size() != other.size())
+                            return false;
+                        for(auto const& v : other)
+                            if(not count(v))
+                                return false;
+                        return true;
+                    }
+            };
+    }
+
+}
+
+#endif
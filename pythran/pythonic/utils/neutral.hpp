@@ -0,0 +1,58 @@
+#ifndef PYTHONIC_UTILS_NEUTRAL_HPP
+#define PYTHONIC_UTILS_NEUTRAL_HPP
+
+#include <limits>
+
+namespace pythonic {
+
+namespace numpy {
+namespace proxy {
+struct add;
+struct multiply;
+struct maximum;
+struct minimum;
+struct logical_or;
+struct logical_and;
+}
+}
+
+namespace utils {
+
+  /* neutral element of a reduction operator, used to initialize accumulators */
+  template<class Op, class T>
+    struct neutral;
+
+  template<class T>
+    struct neutral<numpy::proxy::add, T> {
+      static T value() { return T(0); }
+    };
+
+  template<class T>
+    struct neutral<numpy::proxy::multiply, T> {
+      static T value() { return T(1); }
+    };
+
+  template<class T>
+    struct neutral<numpy::proxy::maximum, T> {
+      static T value() { return std::numeric_limits<T>::lowest(); }
+    };
+
+  template<class T>
+    struct neutral<numpy::proxy::minimum, T> {
+      static T value() { return std::numeric_limits<T>::max(); }
+    };
+
+  template<class T>
+    struct neutral<numpy::proxy::logical_or, T> {
+      static T value() { return false; }
+    };
+
+  template<class T>
+    struct neutral<numpy::proxy::logical_and, T> {
+      static T value() { return true; }
+    };
+
+}
+
+}
+#endif
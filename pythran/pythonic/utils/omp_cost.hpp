@@ -0,0 +1,113 @@
+#ifndef PYTHONIC_UTILS_OMP_COST_HPP
+#define PYTHONIC_UTILS_OMP_COST_HPP
+
+#ifdef _OPENMP
+#include <omp.h>
+
+#include <algorithm>
+#include <memory>
+
+/* Cost model deciding whether a loop is worth running in parallel
+ *
+ * Each expression carries a static ``cost'': the estimated time needed to
+ * compute one of its elements, in units of a plain element copy (see
+ * types::op_cost). A loop of ``n'' iterations that each cost ``cost'' units is
+ * parallelized when its total cost exceeds PYTHRAN_OPENMP_FORK_RATIO times the
+ * cost of opening a parallel region, measured once at runtime, and it has at
+ * least PYTHRAN_OPENMP_MIN_ITERATION_COUNT iterations. Some loops iterate over
+ * blocks, so that floor defaults to the bare minimum.
+ */
+#ifndef PYTHRAN_OPENMP_FORK_RATIO
+#define PYTHRAN_OPENMP_FORK_RATIO 4
+#endif
+
+#ifndef PYTHRAN_OPENMP_MIN_ITERATION_COUNT
+#define PYTHRAN_OPENMP_MIN_ITERATION_COUNT 2
+#endif
+
+namespace pythonic {
+
+    namespace utils {
+
+        class omp_cost_model {
+
+            double fork_;   // cost of a parallel region, in element copies
+            long threads_;
+
+            omp_cost_model() : fork_(0), threads_(omp_get_max_threads())
+            {
+                if(threads_ == 1)
+                    return;
+
+                // time of a plain copy, best of a few runs
+                long const size = 1 << 14;
+                std::unique_ptr<double[]> src(new double[size]), dst(new double[size]);
+                std::fill(src.get(), src.get() + size, 1.);
+                double copy = 1e9;
+                for(int run = 0; run < 8; ++run) {
+                    double start = omp_get_wtime();
+                    std::copy(src.get(), src.get() + size, dst.get());
+                    copy = std::min(copy, omp_get_wtime() - start);
+                    src[run] = dst[size - 1 - run]; // keep the copies alive
+                }
+                copy = std::max(copy, 1e-9) / size;
+
+                // time of a parallel loop with one iteration per thread, once
+                // the thread pool exists. An empty region is not enough, as
+                // threads that have nothing to do may not even be woken up
+                long const threads = threads_;
+                #pragma omp parallel for
+                for(long t = 0; t < threads; ++t)
+                    dst[t] = t;
+                int const runs = 16;
+                double start = omp_get_wtime();
+                for(int run = 0; run < runs; ++run) {
+                    #pragma omp parallel for
+                    for(long t = 0; t < threads; ++t)
+                        dst[t] += t;
+                }
+                fork_ = (omp_get_wtime() - start) / runs / copy;
+            }
+
+            public:
+
+            /* The model is calibrated on first use, which must happen
+             * outside of any parallel region: nested regions would time a
+             * single thread and underestimate the cost of a fork.
+             */
+            static omp_cost_model const& get() {
+                static omp_cost_model const model; // thread safe initialization
+                return model;
+            }
+
+            // true if n iterations of the given cost should be split among threads
+            bool worth(long n, long cost) const {
+                return threads_ > 1 and n >= PYTHRAN_OPENMP_MIN_ITERATION_COUNT and
+                       double(n) * cost >= PYTHRAN_OPENMP_FORK_RATIO * fork_;
+            }
+
+            // iterations per scheduled chunk: a few chunks per thread for load
+            // balancing, but each chunk must outweigh its dispatch
+            long chunk(long n, long cost) const {
+                long const balanced = (n + 4 * threads_ - 1) / (4 * threads_);
+                long const amortized = long(fork_ / (16 * cost)) + 1;
+                return std::max(1L, std::min(n, std::max(balanced, amortized)));
+            }
+        };
+
+        // loops are never split from inside a parallel region, whose threads are already busy
+        inline bool omp_worth(long n, long cost) {
+            return not omp_in_parallel() and omp_cost_model::get().worth(n, cost);
+        }
+
+        inline long omp_chunk(long n, long cost) {
+            return omp_cost_model::get().chunk(n, cost);
+        }
+
+    }
+
+}
+
+#endif
+
+#endif
@@ -0,0 +1,262 @@
+#ifndef PYTHONIC_UTILS_PARSE_HPP
+#define PYTHONIC_UTILS_PARSE_HPP
+
+#include "pythonic/utils/power_of_five.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <type_traits>
+
+/* Locale independent number parsing, for numpy text input
+ *
+ * The parsers work on [first, last) ranges that need not be null terminated.
+ * They skip leading whitespace and return the end of the number, or nullptr
+ * when the range does not start with one. Floats follow Python's float():
+ * decimal and scientific notations, inf, infinity and nan. Most floats are
+ * converted exactly from a 64 bit mantissa, either with a single floating
+ * point operation or with the Eisel-Lemire algorithm, strtod handles the
+ * few remaining ones.
+ */
+namespace pythonic {
+
+    namespace utils {
+
+        inline bool is_space(char c) {
+            return c == ' ' or (c >= '\t' and c <= '\r');
+        }
+
+        inline char const* skip_space(char const* first, char const* last) {
+            while(first != last and is_space(*first))
+                ++first;
+            return first;
+        }
+
+        inline char const* skip_space_backward(char const* first, char const* last) {
+            while(last != first and is_space(last[-1]))
+                --last;
+            return last;
+        }
+
+        inline bool is_digit(char c) {
+            return static_cast<unsigned char>(c - '0') < 10;
+        }
+
+        // case insensitive match of the null terminated, lower case word
+        inline char const* match_word(char const* first, char const* last, char const* word) {
+            for(; *word; ++word, ++first)
+                if(first == last or (*first | 0x20) != *word)
+                    return nullptr;
+            return first;
+        }
+
+        template<class T>
+            typename std::enable_if<std::is_integral<T>::value, char const*>::type parse_number(char const* first, char const* last, T& out) {
+                first = skip_space(first, last);
+                bool negative = false;
+                if(first != last and (*first == '-' or *first == '+'))
+                    negative = *first++ == '-';
+                char const* start = first;
+                uint64_t value = 0;
+                for(; first != last and is_digit(*first); ++first) {
+                    uint64_t digit = *first - '0';
+                    if(value > (std::numeric_limits<uint64_t>::max() - digit) / 10)
+                        return nullptr;
+                    value = value * 10 + digit;
+                }
+                if(first == start)
+                    return nullptr;
+                out = static_cast<T>(negative ? 0 - value : value);
+                return first;
+            }
+
+        /* w * 10^q, correctly rounded, for a non zero w
+         *
+         * Returns false in the rare cases where 128 bits of 5^q are not
+         * enough to decide the rounding, or for overflows.
+         */
+        inline bool eisel_lemire(uint64_t w, int q, bool negative, double& out) {
+            int lz = __builtin_clzll(w);
+            w <<= lz;
+            uint64_t const* power = power_of_five_128() + 2 * (q - power_of_five_min);
+            unsigned __int128 product = static_cast<unsigned __int128>(w) * power[0];
+            uint64_t upper = product >> 64, lower = product;
+            // the 55 upper bits may be off by one, refine them with the low word of 5^q
+            if((upper & 0x1FF) == 0x1FF) {
+                uint64_t second = (static_cast<unsigned __int128>(w) * power[1]) >> 64;
+                lower += second;
+                if(second > lower)
+                    ++upper;
+                if(lower == std::numeric_limits<uint64_t>::max())
+                    return false;
+            }
+            uint64_t upperbit = upper >> 63;
+            uint64_t mantissa = upper >> (upperbit + 9);
+            lz += int(1 ^ upperbit);
+            // floor(log2(10^q)) + the double exponent bias
+            int64_t exponent = ((217706 * int64_t(q)) >> 16) + 1024 + 63 - lz;
+            if(exponent <= 0) {
+                // subnormal
+                if(-exponent + 1 >= 64) {
+                    out = negative ? -0. : 0.;
+                    return true;
+                }
+                mantissa >>= -exponent + 1;
+                mantissa += mantissa & 1;
+                mantissa >>= 1;
+                exponent = mantissa < (uint64_t(1) << 52) ? 0 : 1;
+            }
+            else {
+                // exactly between two doubles, round to even
+                if(lower <= 1 and q >= -4 and q <= 23 and (mantissa & 3) == 1 and
+                   (mantissa << (upperbit + 64 - 52 - 3)) == upper)
+                    mantissa &= ~uint64_t(1);
+                mantissa += mantissa & 1;
+                mantissa >>= 1;
+                if(mantissa >= (uint64_t(1) << 53)) {
+                    mantissa = uint64_t(1) << 52;
+                    ++exponent;
+                }
+                mantissa &= ~(uint64_t(1) << 52);
+                if(exponent > 2046)
+                    return false;
+            }
+            uint64_t bits = mantissa | uint64_t(exponent) << 52 | uint64_t(negative) << 63;
+            std::memcpy(&out, &bits, sizeof(out));
+            return true;
+        }
+
+        inline char const* parse_double(char const* first, char const* last, double& out) {
+            first = skip_space(first, last);
+            char const* start = first;
+            bool negative = false;
+            if(first != last and (*first == '-' or *first == '+'))
+                negative = *first++ == '-';
+
+            if(first != last and not is_digit(*first) and *first != '.') {
+                char const* end;
+                if((end = match_word(first, last, "infinity")) or (end = match_word(first, last, "inf")))
+                    out = negative ? -std::numeric_limits<double>::infinity() : std::numeric_limits<double>::infinity();
+                else if((end = match_word(first, last, "nan")))
+                    out = std::numeric_limits<double>::quiet_NaN();
+                return end;
+            }
+
+            // mantissa, up to 19 significant digits
+            uint64_t w = 0;
+            int digits = 0, significant = 0, exponent = 0;
+            bool truncated = false;
+            for(; first != last and is_digit(*first); ++first, ++digits) {
+                if(significant < 19) {
+                    w = w * 10 + (*first - '0');
+                    significant += w != 0;
+                }
+                else {
+                    truncated = true;
+                    ++exponent;
+                }
+            }
+            if(first != last and *first == '.') {
+                ++first;
+                for(; first != last and is_digit(*first); ++first, ++digits) {
+                    if(significant < 19) {
+                        w = w * 10 + (*first - '0');
+                        significant += w != 0;
+                        --exponent;
+                    }
+                    else
+                        truncated = true;
+                }
+            }
+            if(digits == 0)
+                return nullptr;
+            if(first != last and (*first | 0x20) == 'e') {
+                char const* e = first + 1;
+                bool eneg = false;
+                if(e != last and (*e == '-' or *e == '+'))
+                    eneg = *e++ == '-';
+                if(e != last and is_digit(*e)) {
+                    int value = 0;
+                    for(; e != last and is_digit(*e); ++e)
+                        if(value < 100000)
+                            value = value * 10 + (*e - '0');
+                    exponent += eneg ? -value : value;
+                    first = e;
+                }
+            }
+
+            static const double powers[] = {
+                1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+                1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+            };
+            if(not truncated) {
+                if(w == 0) {
+                    out = negative ? -0. : 0.;
+                    return first;
+                }
+                // both operands are exact, so is the rounded result
+                if(w <= (uint64_t(1) << 53) and exponent >= -22 and exponent <= 22) {
+                    double value = double(w);
+                    value = exponent < 0 ? value / powers[-exponent] : value * powers[exponent];
+                    out = negative ? -value : value;
+                    return first;
+                }
+                if(exponent < power_of_five_min) {
+                    out = negative ? -0. : 0.;
+                    return first;
+                }
+                if(exponent > power_of_five_max) {
+                    out = negative ? -std::numeric_limits<double>::infinity() : std::numeric_limits<double>::infinity();
+                    return first;
+                }
+                if(eisel_lemire(w, exponent, negative, out))
+                    return first;
+            }
+
+            // hard cases, the token is known to be well formed
+            char buffer[64];
+            size_t n = first - start;
+            if(n < sizeof(buffer)) {
+                std::memcpy(buffer, start, n);
+                buffer[n] = 0;
+                out = std::strtod(buffer, nullptr);
+            }
+            else
+                out = std::strtod(std::string(start, first).c_str(), nullptr);
+            return first;
+        }
+
+        template<class T>
+            typename std::enable_if<std::is_floating_point<T>::value, char const*>::type parse_number(char const* first, char const* last, T& out) {
+                double value;
+                first = parse_double(first, last, value);
+                out = static_cast<T>(value);
+                return first;
+            }
+
+        // other types, such as complex numbers, go through their stream operator
+        template<class T>
+            typename std::enable_if<not std::is_arithmetic<T>::value, char const*>::type parse_number(char const* first, char const* last, T& out) {
+                std::istringstream iss(std::string(first, last));
+                if(not (iss >> out))
+                    return nullptr;
+                std::streamoff consumed = iss.eof() ? std::streamoff(last - first) : std::streamoff(iss.tellg());
+                return first + consumed;
+            }
+
+        // true if [first, last) holds a number, possibly surrounded by whitespace
+        template<class T>
+            bool parse_field(char const* first, char const* last, T& out) {
+                char const* end = parse_number(first, last, out);
+                return end and skip_space(end, last) == last;
+            }
+
+    }
+
+}
+
+#endif
@@ -0,0 +1,382 @@
+#ifndef PYTHONIC_UTILS_RANDOM_HPP
+#define PYTHONIC_UTILS_RANDOM_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+#ifdef _OPENMP
+#include <omp.h>
+#include "pythonic/utils/omp_cost.hpp"
+#endif
+
+/* Random numbers shared by the random and numpy.random modules
+ *
+ * The generator is Philox4x32-10 (Salmon et al., "Parallel random numbers:
+ * as easy as 1, 2, 3"), a counter based generator: the n-th block of four
+ * 32 bit words of a stream is a bijection of (key, n). The key is the seed
+ * of random.seed, and each thread draws from its own stream, so that
+ * threads do not share any state and a parallel loop with a static
+ * schedule gets the same numbers from one run to another.
+ *
+ * Bulk fills draw from a fresh substream of the calling thread's stream.
+ * Its chunks of random_chunk items start at independent offsets, so they
+ * can be filled by any thread, in any order, with the same result.
+ */
+namespace pythonic {
+
+    namespace utils {
+
+        class philox4x32 {
+            uint32_t key_[2];
+            uint32_t counter_[4];
+            uint32_t block_[4];
+            unsigned index_;
+            // substreams handed out by split()
+            uint32_t splits_;
+
+            static uint32_t mulhilo(uint32_t a, uint32_t b, uint32_t& hi) {
+                uint64_t p = uint64_t(a) * b;
+                hi = p >> 32;
+                return uint32_t(p);
+            }
+
+            // one of the ten Philox rounds
+            static void mix(uint32_t& c0, uint32_t& c1, uint32_t& c2, uint32_t& c3, uint32_t k0, uint32_t k1) {
+                uint32_t hi0, hi1;
+                uint32_t lo0 = mulhilo(0xD2511F53, c0, hi0);
+                uint32_t lo1 = mulhilo(0xCD9E8D57, c2, hi1);
+                c0 = hi1 ^ c1 ^ k0;
+                c1 = lo1;
+                c2 = hi0 ^ c3 ^ k1;
+                c3 = lo0;
+            }
+
+            uint64_t block_index() const {
+                return uint64_t(counter_[1]) << 32 | counter_[0];
+            }
+
+            void generate() {
+                uint32_t c0 = counter_[0], c1 = counter_[1], c2 = counter_[2], c3 = counter_[3];
+                uint32_t k0 = key_[0], k1 = key_[1];
+                for(int r = 0; r < 10; ++r, k0 += 0x9E3779B9, k1 += 0xBB67AE85)
+                    mix(c0, c1, c2, c3, k0, k1);
+                block_[0] = c0; block_[1] = c1; block_[2] = c2; block_[3] = c3;
+                // the low half of the counter indexes blocks, the high half streams
+                if(not ++counter_[0])
+                    ++counter_[1];
+                index_ = 0;
+            }
+
+#ifdef __SSE2__
+            // four Philox rounds at once, one block per 32 bit lane
+            static void mulhilo(__m128i a, __m128i m, __m128i& lo, __m128i& hi) {
+                __m128i const low = _mm_set1_epi64x(0xFFFFFFFF);
+                __m128i even = _mm_mul_epu32(a, m), odd = _mm_mul_epu32(_mm_srli_epi64(a, 32), m);
+                lo = _mm_or_si128(_mm_and_si128(even, low), _mm_slli_epi64(odd, 32));
+                hi = _mm_or_si128(_mm_srli_epi64(even, 32), _mm_andnot_si128(low, odd));
+            }
+
+            static void mix(__m128i& c0, __m128i& c1, __m128i& c2, __m128i& c3, uint32_t k0, uint32_t k1) {
+                __m128i lo0, hi0, lo1, hi1;
+                mulhilo(c0, _mm_set1_epi32(0xD2511F53), lo0, hi0);
+                mulhilo(c2, _mm_set1_epi32(0xCD9E8D57), lo1, hi1);
+                c0 = _mm_xor_si128(_mm_xor_si128(hi1, c1), _mm_set1_epi32(k0));
+                c1 = lo1;
+                c2 = _mm_xor_si128(_mm_xor_si128(hi0, c3), _mm_set1_epi32(k1));
+                c3 = lo0;
+            }
+#endif
+#ifdef __AVX2__
+            static void mulhilo(__m256i a, __m256i m, __m256i& lo, __m256i& hi) {
+                __m256i even = _mm256_mul_epu32(a, m), odd = _mm256_mul_epu32(_mm256_srli_epi64(a, 32), m);
+                lo = _mm256_blend_epi32(even, _mm256_slli_epi64(odd, 32), 0xAA);
+                hi = _mm256_blend_epi32(_mm256_srli_epi64(even, 32), odd, 0xAA);
+            }
+
+            static void mix(__m256i& c0, __m256i& c1, __m256i& c2, __m256i& c3, uint32_t k0, uint32_t k1) {
+                __m256i lo0, hi0, lo1, hi1;
+                mulhilo(c0, _mm256_set1_epi32(0xD2511F53), lo0, hi0);
+                mulhilo(c2, _mm256_set1_epi32(0xCD9E8D57), lo1, hi1);
+                c0 = _mm256_xor_si256(_mm256_xor_si256(hi1, c1), _mm256_set1_epi32(k0));
+                c1 = lo1;
+                c2 = _mm256_xor_si256(_mm256_xor_si256(hi0, c3), _mm256_set1_epi32(k1));
+                c3 = lo0;
+            }
+#endif
+
+            /* lanes consecutive blocks at once, stored one after the other
+             *
+             * The counters are transposed so that each SIMD lane holds a
+             * block, 8 (AVX2) or 4 (SSE2) blocks go through a round at once.
+             */
+            static constexpr unsigned lanes = 16;
+            void generate_lanes(uint32_t* out) {
+                uint32_t c[4][lanes];
+                uint64_t first = block_index();
+                for(unsigned l = 0; l < lanes; ++l) {
+                    c[0][l] = uint32_t(first + l);
+                    c[1][l] = uint32_t((first + l) >> 32);
+                    c[2][l] = counter_[2];
+                    c[3][l] = counter_[3];
+                }
+                uint32_t k0 = key_[0], k1 = key_[1];
+#if defined(__AVX2__)
+                typedef __m256i vector;
+#define PYTHONIC_PHILOX_LOAD(p) _mm256_loadu_si256(reinterpret_cast<__m256i const*>(p))
+#define PYTHONIC_PHILOX_STORE(p, x) _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), x)
+#elif defined(__SSE2__)
+                typedef __m128i vector;
+#define PYTHONIC_PHILOX_LOAD(p) _mm_loadu_si128(reinterpret_cast<__m128i const*>(p))
+#define PYTHONIC_PHILOX_STORE(p, x) _mm_storeu_si128(reinterpret_cast<__m128i*>(p), x)
+#endif
+#if defined(__SSE2__)
+                // independent groups of blocks hide the latency of the multiplications
+                unsigned const width = sizeof(vector) / sizeof(uint32_t), groups = lanes / width;
+                vector v[4][groups];
+#pragma GCC unroll 8
+                for(unsigned g = 0; g < groups; ++g)
+#pragma GCC unroll 4
+                    for(unsigned j = 0; j < 4; ++j)
+                        v[j][g] = PYTHONIC_PHILOX_LOAD(c[j] + g * width);
+                for(int r = 0; r < 10; ++r, k0 += 0x9E3779B9, k1 += 0xBB67AE85)
+#pragma GCC unroll 8
+                    for(unsigned g = 0; g < groups; ++g)
+                        mix(v[0][g], v[1][g], v[2][g], v[3][g], k0, k1);
+#pragma GCC unroll 8
+                for(unsigned g = 0; g < groups; ++g)
+#pragma GCC unroll 4
+                    for(unsigned j = 0; j < 4; ++j)
+                        PYTHONIC_PHILOX_STORE(c[j] + g * width, v[j][g]);
+#undef PYTHONIC_PHILOX_LOAD
+#undef PYTHONIC_PHILOX_STORE
+#else
+                for(int r = 0; r < 10; ++r, k0 += 0x9E3779B9, k1 += 0xBB67AE85)
+                    for(unsigned l = 0; l < lanes; ++l)
+                        mix(c[0][l], c[1][l], c[2][l], c[3][l], k0, k1);
+#endif
+                for(unsigned l = 0; l < lanes; ++l)
+                    for(unsigned j = 0; j < 4; ++j)
+                        out[4 * l + j] = c[j][l];
+                first += lanes;
+                counter_[0] = uint32_t(first);
+                counter_[1] = uint32_t(first >> 32);
+            }
+
+            public:
+            typedef uint32_t result_type;
+
+            static constexpr result_type min() { return 0; }
+            static constexpr result_type max() { return std::numeric_limits<uint32_t>::max(); }
+
+            philox4x32(uint64_t key = 0, uint32_t stream = 0, uint32_t substream = 0) :
+                key_{uint32_t(key), uint32_t(key >> 32)},
+                counter_{0, 0, stream, substream},
+                index_(4), splits_(0)
+            {}
+
+            // a new engine, independent from this one and from its previous splits
+            philox4x32 split() {
+                philox4x32 other(*this);
+                other.counter_[0] = other.counter_[1] = 0;
+                other.counter_[3] = ++splits_;
+                other.index_ = 4;
+                other.splits_ = 0;
+                return other;
+            }
+
+            // next draw starts with the first word of the given block
+            void seek(uint64_t block) {
+                counter_[0] = uint32_t(block);
+                counter_[1] = uint32_t(block >> 32);
+                index_ = 4;
+            }
+
+            result_type operator()() {
+                if(index_ == 4)
+                    generate();
+                return block_[index_++];
+            }
+
+            // same as n successive calls
+            void fill(uint32_t* out, size_t n) {
+                for(; n and index_ < 4; --n)
+                    *out++ = block_[index_++];
+                for(; n >= 4 * lanes; n -= 4 * lanes, out += 4 * lanes)
+                    generate_lanes(out);
+                for(; n; --n)
+                    *out++ = (*this)();
+            }
+
+            uint64_t next64() {
+                uint64_t hi = (*this)();
+                return hi << 32 | (*this)();
+            }
+
+            // uniform in [0, 1), with 53 random bits
+            double uniform() {
+                return (next64() >> 11) * (1. / 9007199254740992.);
+            }
+
+            // uniform in [0, n), without modulo bias
+            uint64_t below(uint64_t n) {
+                uint64_t threshold = -n % n;
+                for(;;) {
+                    uint64_t r = next64();
+                    if(r >= threshold)
+                        return r % n;
+                }
+            }
+
+            // standard normal variate
+            double normal() {
+                return normal(next64());
+            }
+
+            // standard normal variate from the given bits, see ziggurat
+            inline double normal(uint64_t bits);
+
+            // exponential variate of rate 1
+            double exponential() {
+                return -std::log1p(-uniform());
+            }
+        };
+
+        /* Tables of the Ziggurat method for the normal distribution
+         *
+         * Marsaglia and Tsang, "The Ziggurat Method for Generating Random
+         * Variables", with the improvements of Doornik, "An Improved Ziggurat
+         * Method to Generate Normal Random Samples". The density is covered
+         * by 128 layers of equal area v, the base one extending to the tail
+         * beyond r. A draw picks a layer and an abscissa with 64 bits, which
+         * is accepted right away 98.8% of the times.
+         */
+        class ziggurat {
+            static constexpr unsigned layers = 128;
+            static constexpr double r = 3.442619855899, v = 9.91256303526217e-3;
+
+            double x_[layers + 1];
+            // ratio between the widths of a layer and of the one below
+            double ratio_[layers];
+
+            static double density(double x) {
+                return std::exp(-.5 * x * x);
+            }
+
+            ziggurat() {
+                x_[0] = v / density(r);
+                x_[1] = r;
+                for(unsigned i = 2; i < layers; ++i)
+                    x_[i] = std::sqrt(-2. * std::log(v / x_[i - 1] + density(x_[i - 1])));
+                x_[layers] = 0.;
+                for(unsigned i = 0; i < layers; ++i)
+                    ratio_[i] = x_[i + 1] / x_[i];
+            }
+
+            public:
+            static ziggurat const& get() {
+                static ziggurat const tables; // thread safe initialization
+                return tables;
+            }
+
+            double operator()(uint64_t bits, philox4x32& engine) const {
+                for(;;) {
+                    unsigned i = bits & (layers - 1);
+                    // uniform in (-1, 1), from the 53 high bits
+                    double u = 2. * ((bits >> 11) * (1. / 9007199254740992.)) - 1.;
+                    if(std::abs(u) < ratio_[i])
+                        return u * x_[i];
+                    if(i == 0) {
+                        // tail beyond r
+                        double a, b;
+                        do {
+                            a = -std::log(1. - engine.uniform()) / r;
+                            b = -std::log(1. - engine.uniform());
+                        } while(b + b < a * a);
+                        return u < 0 ? -(r + a) : r + a;
+                    }
+                    double x = u * x_[i];
+                    double f0 = density(x_[i]), f1 = density(x_[i + 1]);
+                    if(f1 + engine.uniform() * (f0 - f1) < density(x))
+                        return x;
+                    bits = engine.next64();
+                }
+            }
+        };
+
+        double philox4x32::normal(uint64_t bits) {
+            return ziggurat::get()(bits, *this);
+        }
+
+        struct random_seed {
+            uint64_t value;
+            // bumped by each reseed, so that threads rebuild their stream
+            unsigned generation;
+        };
+
+        inline random_seed& global_random_seed() {
+            static random_seed seed = {0, 0};
+            return seed;
+        }
+
+        inline void seed_random(uint64_t value) {
+            random_seed& seed = global_random_seed();
+            seed.value = value;
+            ++seed.generation;
+        }
+
+        inline double uniform_from_words(uint32_t hi, uint32_t lo) {
+            return ((uint64_t(hi) << 32 | lo) >> 11) * (1. / 9007199254740992.);
+        }
+
+        // stream of the calling thread, numbered from its OpenMP thread id
+        inline philox4x32& random_engine() {
+            thread_local static philox4x32 engine;
+            thread_local static unsigned generation = 0;
+            thread_local static bool initialized = false;
+            random_seed const& seed = global_random_seed();
+            if(not initialized or generation != seed.generation) {
+#ifdef _OPENMP
+                uint32_t stream = omp_get_thread_num();
+#else
+                uint32_t stream = 0;
+#endif
+                engine = philox4x32(seed.value, stream);
+                generation = seed.generation;
+                initialized = true;
+            }
+            return engine;
+        }
+
+        static const long random_chunk = 1024;
+
+        /* fills [out, out + n) by chunks, with draw(engine, first, last)
+         *
+         * cost is the estimated cost of drawing an item, used to decide
+         * whether chunks are spread among threads.
+         */
+        template<class T, class F>
+            void random_fill(T* out, long n, long cost, F const& draw) {
+                philox4x32 const base = random_engine().split();
+                long const nchunks = (n + random_chunk - 1) / random_chunk;
+                #pragma omp parallel for if(utils::omp_worth(nchunks, random_chunk * cost))
+                for(long j = 0; j < nchunks; ++j) {
+                    philox4x32 engine = base;
+                    engine.seek(uint64_t(j) << 32);
+                    draw(engine, out + j * random_chunk, out + std::min(n, (j + 1) * random_chunk));
+                }
+            }
+
+    }
+
+}
+
+#endif
@@ -1,6 +1,8 @@
 #ifndef PYTHONIC_UTILS_SHARED_REF_HPP
 #define PYTHONIC_UTILS_SHARED_REF_HPP
 
+#include "pythonic/utils/allocate.hpp"
+
 #include <memory>
 #include <utility>
 #include <unordered_map>
@@ -30,9 +32,31 @@ namespace pythonic {
         // Force construction of an uninitialized shared_ref
         struct no_memory{};
 
+        // Address of the storage allocated right after the reference counter
+        struct inline_storage {
+            void* ptr;
+        };
+
+        /* Detects types that can be stored in the same block as their payload
+         *
+         * Such types provide a static ``inline_size'' method that, given the
+         * constructor arguments, returns the number of bytes to reserve, and a
+         * constructor taking an ``inline_storage'' first.
+         */
+        template<class T, class... Types>
+            struct has_inline_storage {
+                template<class U>
+                    static std::true_type test(decltype(U::inline_size(std::declval<Types>()...))*);
+                template<class U>
+                    static std::false_type test(...);
+                static const bool value = decltype(test<T>(nullptr))::value;
+            };
+
         /** Light-weight shared_ptr like-class
          *
-         *  Unlike std::shared_ptr, it allocates the memory itself using new.
+         *  Unlike std::shared_ptr, it allocates the memory itself using utils::allocator.
+         *  When the allocation policy permits it, types with inline storage
+         *  get their payload in the same block.
          */
         template <class T>
             class shared_ref
@@ -47,6 +71,40 @@ namespace pythonic {
                                 ptr( std::forward<Types>(args)... ), count(1),
                                 foreign(nullptr)
                             {}
+                        template<class... Types>
+                            memory(inline_storage storage, Types&&... args):
+                                ptr( storage, std::forward<Types>(args)... ), count(1),
+                                foreign(nullptr)
+                            {}
+
+                        template<class... Types>
+                            static memory* make(std::false_type, Types&&... args) {
+                                void * raw = allocator::allocate(sizeof(memory));
+                                try {
+                                    return new (raw) memory(std::forward<Types>(args)...);
+                                }
+                                catch(...) {
+                                    allocator::deallocate(raw);
+                                    throw;
+                                }
+                            }
+                        template<class... Types>
+                            static memory* make(std::true_type, Types&&... args) {
+                                // the inline storage follows the counter, suitably aligned
+                                const size_t offset = (sizeof(memory) + allocator::alignment - 1) / allocator::alignment * allocator::alignment;
+                                char * raw = static_cast<char*>(allocator::allocate(offset + T::inline_size(args...)));
+                                try {
+                                    return new (raw) memory(inline_storage{raw + offset}, std::forward<Types>(args)...);
+                                }
+                                catch(...) {
+                                    allocator::deallocate(raw);
+                                    throw;
+                                }
+                            }
+                        static void release(memory* self) {
+                            self->~memory();
+                            allocator::deallocate(self);
+                        }
                     } *mem;
 
                 public:
@@ -64,7 +122,8 @@ namespace pythonic {
                     // Ctor allocate T and forward all arguments to T ctor
                     template<class... Types>
                         shared_ref(Types&&... args)
-                        : mem( new memory(std::forward<Types>(args)...) )
+                        : mem( memory::make(std::integral_constant<bool, allocator::coallocate and has_inline_storage<T, Types...>::value>(),
+                                            std::forward<Types>(args)...) )
                         {}
 
                     // Move Ctor
@@ -109,6 +168,16 @@ namespace pythonic {
                         return mem != other.mem;
                     }
 
+                    // False for shared_ref built from no_memory
+                    explicit operator bool() const noexcept {
+                        return mem;
+                    }
+
+                    // True if no other shared_ref points to the same memory
+                    bool unique() const noexcept {
+                        return mem->count == 1;
+                    }
+
                     // Save pointer to the external object to decref once we doesn't
                     // use it anymore
                     void external(extern_type obj_ptr) {
@@ -116,7 +185,7 @@ namespace pythonic {
                     }
 
                     // FIXME The interface is screwed, you won't be able to delete
-                    // T since it was a member of the struct allocated with new
+                    // T since it was a member of the struct allocated with utils::allocator
                     T* forget() {
                         T *ptr = &mem->ptr;
                         mem = nullptr;
@@ -137,7 +206,7 @@ namespace pythonic {
                                 Py_DECREF(mem->foreign);
 #endif
                             } else
-                                delete mem;
+                                memory::release(mem);
                             mem = nullptr;
                         }
                     }
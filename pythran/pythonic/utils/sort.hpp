@@ -0,0 +1,368 @@
+#ifndef PYTHONIC_UTILS_SORT_HPP
+#define PYTHONIC_UTILS_SORT_HPP
+
+#include "pythonic/utils/omp_cost.hpp"
+
+#include <algorithm>
+#include <complex>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <numeric>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/* Sorting engine shared by numpy.sort, argsort, sort_complex, lexsort,
+ * sorted and list.sort, and selection used by median, percentile and partition
+ *
+ * A range is sorted as a single run, or split into runs that are sorted in
+ * parallel and then merged in parallel when it is large enough. Integers and
+ * floating point numbers are sorted by a LSD radix sort once a run holds
+ * PYTHRAN_RADIX_SORT_MIN of them, other values by std::sort.
+ * As in numpy, NaN are sorted last.
+ */
+#ifndef PYTHRAN_RADIX_SORT_MIN
+#define PYTHRAN_RADIX_SORT_MIN 512
+#endif
+
+#ifndef PYTHRAN_PARALLEL_SORT_MIN
+#define PYTHRAN_PARALLEL_SORT_MIN 65536
+#endif
+
+namespace pythonic {
+
+    namespace utils {
+
+        /* unsigned integer ordered as the value it is computed from */
+        template<class T, class=void>
+            struct radix_key {
+                static const bool value = false;
+            };
+
+        template<class T>
+            struct radix_key<T, typename std::enable_if<std::is_integral<T>::value and not std::is_same<T, bool>::value>::type> {
+                static const bool value = true;
+                typedef typename std::make_unsigned<T>::type type;
+                static type get(T v) {
+                    // flip the sign bit so that negative values come first
+                    return std::is_signed<T>::value ? type(type(v) ^ (type(1) << (8 * sizeof(T) - 1))) : type(v);
+                }
+            };
+
+        template<class T, class U>
+            struct radix_float_key {
+                static const bool value = true;
+                typedef U type;
+                static type get(T v) {
+                    if(v == T(0))
+                        v = T(0); // -0. and 0. are equal
+                    U bits;
+                    std::memcpy(&bits, &v, sizeof(v));
+                    // negative values are ordered backward, and before positive ones
+                    U const sign = U(1) << (8 * sizeof(U) - 1);
+                    return (bits & sign) ? U(~bits) : U(bits | sign);
+                }
+            };
+
+        template<>
+            struct radix_key<float> : radix_float_key<float, uint32_t> {
+            };
+
+        template<>
+            struct radix_key<double> : radix_float_key<double, uint64_t> {
+            };
+
+        /* operator<, NaN being greater than anything else */
+        template<class T>
+            struct sort_less {
+                bool operator()(T const& a, T const& b) const {
+                    return _less(a, b, std::is_floating_point<T>());
+                }
+                static bool _less(T const& a, T const& b, std::false_type) {
+                    return a < b;
+                }
+                static bool _less(T const& a, T const& b, std::true_type) {
+                    return a < b or (b != b and a == a);
+                }
+            };
+
+        // complex numbers are ordered by real part, then by imaginary part
+        template<class T>
+            struct sort_less<std::complex<T>> {
+                bool operator()(std::complex<T> const& a, std::complex<T> const& b) const {
+                    sort_less<T> less;
+                    return less(a.real(), b.real()) or (not less(b.real(), a.real()) and less(a.imag(), b.imag()));
+                }
+            };
+
+        template<class T>
+            bool is_nan(T const& v, std::true_type) {
+                return v != v;
+            }
+        template<class T>
+            bool is_nan(T const&, std::false_type) {
+                return false;
+            }
+
+        /* one pass of the LSD radix sort, on the digit at shift */
+        template<class I, class O, class Key>
+            void _radix_pass(I src, O dst, long n, long* offsets, int shift, Key key) {
+                for(long i = 0; i < n; ++i, ++src)
+                    dst[offsets[(key(*src) >> shift) & 0xFF]++] = *src;
+            }
+
+        /* stable sort of [first, last) along key(element), an unsigned integer */
+        template<class I, class Key>
+            void radix_sort(I first, I last, Key key) {
+                typedef typename std::iterator_traits<I>::value_type T;
+                typedef decltype(key(*first)) U;
+                static const int passes = sizeof(U);
+                long const n = last - first;
+                long counts[passes][256] = {};
+                for(I iter = first; iter != last; ++iter) {
+                    U const k = key(*iter);
+                    for(int p = 0; p < passes; ++p)
+                        ++counts[p][(k >> (8 * p)) & 0xFF];
+                }
+                std::vector<T> tmp(n);
+                bool in_tmp = false;
+                for(int p = 0; p < passes; ++p) {
+                    long* count = counts[p];
+                    if(std::find(count, count + 256, n) != count + 256)
+                        continue; // every key has the same digit
+                    long offset = 0;
+                    for(int b = 0; b < 256; ++b) {
+                        long const c = count[b];
+                        count[b] = offset;
+                        offset += c;
+                    }
+                    if(in_tmp)
+                        _radix_pass(tmp.begin(), first, n, count, 8 * p, key);
+                    else
+                        _radix_pass(first, tmp.begin(), n, count, 8 * p, key);
+                    in_tmp = not in_tmp;
+                }
+                if(in_tmp)
+                    std::copy(tmp.begin(), tmp.end(), first);
+            }
+
+        /* sorts a run of values */
+        template<class T, bool radix = radix_key<T>::value>
+            struct sort_run {
+                template<class I>
+                    void operator()(I first, I last) const {
+                        std::sort(first, last, sort_less<T>());
+                    }
+            };
+
+        template<class T>
+            struct sort_run<T, true> {
+                static typename radix_key<T>::type key(T v) { return radix_key<T>::get(v); }
+                template<class I>
+                    void operator()(I first, I last) const {
+                        if(last - first < PYTHRAN_RADIX_SORT_MIN)
+                            std::sort(first, last);
+                        else
+                            radix_sort(first, last, &key);
+                    }
+            };
+
+        /* first i such that the first d elements of the stable merge of a[:m]
+         * and b[:n] are a[:i] and b[:d - i] */
+        template<class I, class C>
+            long _co_rank(long d, I a, long m, I b, long n, C cmp) {
+                long lo = std::max(0L, d - n), hi = std::min(d, m);
+                while(lo < hi) {
+                    long const i = (lo + hi) / 2;
+                    if(d - i > 0 and not cmp(b[d - i - 1], a[i]))
+                        lo = i + 1;
+                    else
+                        hi = i;
+                }
+                return lo;
+            }
+
+        /* one round of merges of adjacent pairs of runs from src to dst. Each
+         * merge is split into pieces handled by different threads */
+        template<class I, class O, class C>
+            void _merge_round(I src, O dst, std::vector<long> const& bounds, long width, C cmp) {
+                long const runs = bounds.size() - 1;
+                long const pairs = (runs + 2 * width - 1) / (2 * width);
+                long const pieces = std::max(1L, runs / pairs);
+#ifdef _OPENMP
+                #pragma omp parallel for schedule(static, 1)
+#endif
+                for(long task = 0; task < pairs * pieces; ++task) {
+                    long const pair = task / pieces, piece = task % pieces;
+                    long const lo = bounds[std::min(runs, 2 * width * pair)];
+                    long const mid = bounds[std::min(runs, 2 * width * pair + width)];
+                    long const hi = bounds[std::min(runs, 2 * width * (pair + 1))];
+                    long const m = mid - lo, n = hi - mid;
+                    long const d0 = (m + n) * piece / pieces, d1 = (m + n) * (piece + 1) / pieces;
+                    long const i0 = _co_rank(d0, src + lo, m, src + mid, n, cmp);
+                    long const i1 = _co_rank(d1, src + lo, m, src + mid, n, cmp);
+                    std::merge(src + lo + i0, src + lo + i1,
+                               src + mid + (d0 - i0), src + mid + (d1 - i1),
+                               dst + lo + d0, cmp);
+                }
+            }
+
+        /* sorts [first, last) with run, in parallel when it is worth it. The
+         * result is as stable as run, merges being stable */
+        template<class I, class C, class Run>
+            void parallel_sort(I first, I last, C cmp, Run run) {
+#ifdef _OPENMP
+                long const n = last - first;
+                long const runs = omp_get_max_threads();
+                long log2n = 1;
+                while((1L << log2n) < n)
+                    ++log2n;
+                if(n >= PYTHRAN_PARALLEL_SORT_MIN and utils::omp_worth(runs, n / runs * log2n)) {
+                    std::vector<long> bounds(runs + 1);
+                    for(long r = 0; r <= runs; ++r)
+                        bounds[r] = n * r / runs;
+                    #pragma omp parallel for schedule(static, 1)
+                    for(long r = 0; r < runs; ++r)
+                        run(first + bounds[r], first + bounds[r + 1]);
+
+                    std::vector<typename std::iterator_traits<I>::value_type> buffer(n);
+                    bool in_buffer = false;
+                    for(long width = 1; width < runs; width *= 2) {
+                        if(in_buffer)
+                            _merge_round(buffer.begin(), first, bounds, width, cmp);
+                        else
+                            _merge_round(first, buffer.begin(), bounds, width, cmp);
+                        in_buffer = not in_buffer;
+                    }
+                    if(in_buffer) {
+                        #pragma omp parallel for schedule(static, 1)
+                        for(long r = 0; r < runs; ++r)
+                            std::copy(buffer.begin() + bounds[r], buffer.begin() + bounds[r + 1], first + bounds[r]);
+                    }
+                    return;
+                }
+#else
+                (void)cmp; // only needed to merge the runs sorted by each thread
+#endif
+                run(first, last);
+            }
+
+        /* sorts [first, last) in increasing order, NaN last */
+        template<class I>
+            void sort(I first, I last) {
+                typedef typename std::iterator_traits<I>::value_type T;
+                std::integral_constant<bool, radix_key<T>::value and std::is_floating_point<T>::value> radix_float;
+                // NaN are set apart, radix keys do not order them
+                if(radix_float)
+                    last = std::partition(first, last, [radix_float](T const& v) { return not is_nan(v, radix_float); });
+                parallel_sort(first, last, sort_less<T>(), sort_run<T>());
+            }
+
+        /* sorts [first, last) along cmp */
+        template<class I, class C>
+            void sort(I first, I last, C cmp) {
+                parallel_sort(first, last, cmp,
+                              [cmp](I first, I last) { std::sort(first, last, cmp); });
+            }
+
+        /* sorts [first, last) along cmp, keeping equivalent elements in order */
+        template<class I, class C>
+            void stable_sort(I first, I last, C cmp) {
+                parallel_sort(first, last, cmp,
+                              [cmp](I first, I last) { std::stable_sort(first, last, cmp); });
+            }
+
+        template<class I>
+            void stable_sort(I first, I last) {
+                typedef typename std::iterator_traits<I>::value_type T;
+                stable_sort(first, last, sort_less<T>());
+            }
+
+        /* rearranges [first, last) so that nth holds the value it would hold
+         * if the range was sorted along cmp, with no greater value before it
+         * and no smaller one after it */
+        template<class I, class C>
+            void select(I first, I nth, I last, C cmp) {
+                if(nth != last)
+                    std::nth_element(first, nth, last, cmp);
+            }
+
+        /* same, in increasing order, NaN last */
+        template<class I>
+            void select(I first, I nth, I last) {
+                typedef typename std::iterator_traits<I>::value_type T;
+                select(first, nth, last, sort_less<T>());
+            }
+
+        /* select for each of the sorted positions in [kth_first, kth_last) */
+        template<class I, class K, class C>
+            void multi_select(I first, I last, K kth_first, K kth_last, C cmp) {
+                I lo = first;
+                for(; kth_first != kth_last; ++kth_first) {
+                    I const nth = first + *kth_first;
+                    if(nth < lo)
+                        continue; // duplicated position
+                    select(lo, nth, last, cmp);
+                    lo = nth + 1; // nth and the values before it are in place
+                }
+            }
+
+        template<class U>
+            struct _key_less {
+                bool operator()(std::pair<U, long> const& a, std::pair<U, long> const& b) const {
+                    return a.first < b.first;
+                }
+            };
+
+        template<class U>
+            struct _key_run {
+                static U key(std::pair<U, long> const& p) { return p.first; }
+                template<class I>
+                    void operator()(I first, I last) const {
+                        if(last - first < PYTHRAN_RADIX_SORT_MIN)
+                            std::stable_sort(first, last, _key_less<U>());
+                        else
+                            radix_sort(first, last, &key);
+                    }
+            };
+
+        template<class T>
+            void _argsort(T const* values, long n, long stride, long* out, std::true_type) {
+                typedef typename radix_key<T>::type U;
+                std::vector<std::pair<U, long>> keys;
+                keys.reserve(n);
+                long* nans = out + n;
+                // NaN indices are stored backward from the end of out, then reversed
+                for(long i = 0; i < n; ++i) {
+                    T const v = values[i * stride];
+                    if(is_nan(v, std::is_floating_point<T>()))
+                        *--nans = i;
+                    else
+                        keys.emplace_back(radix_key<T>::get(v), i);
+                }
+                std::reverse(nans, out + n);
+                parallel_sort(keys.begin(), keys.end(), _key_less<U>(), _key_run<U>());
+                for(auto const& key : keys)
+                    *out++ = key.second;
+            }
+
+        template<class T>
+            void _argsort(T const* values, long n, long stride, long* out, std::false_type) {
+                std::iota(out, out + n, 0L);
+                sort_less<T> less;
+                stable_sort(out, out + n,
+                            [values, stride, less](long i, long j) { return less(values[i * stride], values[j * stride]); });
+            }
+
+        /* out[:n] = indices that sort values[0], values[stride], ... values[(n-1)*stride]
+         * in increasing order, NaN last, equal values keeping their order */
+        template<class T>
+            void argsort(T const* values, long n, long stride, long* out) {
+                _argsort(values, n, stride, out, std::integral_constant<bool, radix_key<T>::value>());
+            }
+    }
+
+}
+
+#endif
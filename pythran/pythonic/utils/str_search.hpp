@@ -0,0 +1,190 @@
+#ifndef PYTHONIC_UTILS_STR_SEARCH_HPP
+#define PYTHONIC_UTILS_STR_SEARCH_HPP
+
+#include <cstddef>
+#include <cstring>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+#ifdef __SSE4_2__
+#include <nmmintrin.h>
+#endif
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+/* Byte level kernels behind the str methods
+ *
+ * They work on [first, last) ranges that need not be null terminated, and
+ * searches return nullptr when nothing is found. With SSE2 (AVX2 when
+ * available) blocks of 16 (32) bytes are compared at once, the remaining
+ * bytes are handled one at a time.
+ */
+namespace pythonic {
+
+    namespace utils {
+
+        inline char const* find_char(char const* first, char const* last, char c) {
+            // libc memchr is already vectorized
+            return static_cast<char const*>(std::memchr(first, c, last - first));
+        }
+
+        // first byte of [first, last) that belongs to the m bytes of set
+        inline char const* find_any(char const* first, char const* last, char const* set, size_t m) {
+            if(m == 0)
+                return nullptr;
+            if(m == 1)
+                return find_char(first, last, set[0]);
+#ifdef __AVX2__
+            if(m <= 4) {
+                __m256i s[4];
+                for(size_t j = 0; j < 4; ++j)
+                    s[j] = _mm256_set1_epi8(set[j < m ? j : 0]);
+                for(; last - first >= 32; first += 32) {
+                    __m256i b = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(first));
+                    __m256i eq = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(b, s[0]), _mm256_cmpeq_epi8(b, s[1])),
+                                                 _mm256_or_si256(_mm256_cmpeq_epi8(b, s[2]), _mm256_cmpeq_epi8(b, s[3])));
+                    if(unsigned mask = _mm256_movemask_epi8(eq))
+                        return first + __builtin_ctz(mask);
+                }
+            }
+#endif
+#ifdef __SSE2__
+            if(m <= 4) {
+                __m128i s[4];
+                for(size_t j = 0; j < 4; ++j)
+                    s[j] = _mm_set1_epi8(set[j < m ? j : 0]);
+                for(; last - first >= 16; first += 16) {
+                    __m128i b = _mm_loadu_si128(reinterpret_cast<__m128i const*>(first));
+                    __m128i eq = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(b, s[0]), _mm_cmpeq_epi8(b, s[1])),
+                                              _mm_or_si128(_mm_cmpeq_epi8(b, s[2]), _mm_cmpeq_epi8(b, s[3])));
+                    if(unsigned mask = _mm_movemask_epi8(eq))
+                        return first + __builtin_ctz(mask);
+                }
+            }
+#endif
+#ifdef __SSE4_2__
+            if(m <= 16) {
+                char buffer[16] = {0};
+                std::memcpy(buffer, set, m);
+                __m128i s = _mm_loadu_si128(reinterpret_cast<__m128i const*>(buffer));
+                for(; last - first >= 16; first += 16) {
+                    __m128i b = _mm_loadu_si128(reinterpret_cast<__m128i const*>(first));
+                    int i = _mm_cmpestri(s, m, b, 16, _SIDD_UBYTE_OPS | _SIDD_CMP_EQUAL_ANY | _SIDD_LEAST_SIGNIFICANT);
+                    if(i < 16)
+                        return first + i;
+                }
+            }
+#endif
+            if(m <= 16) {
+                for(; first != last; ++first)
+                    if(std::memchr(set, *first, m))
+                        return first;
+            }
+            else {
+                bool table[256] = {false};
+                for(size_t j = 0; j < m; ++j)
+                    table[static_cast<unsigned char>(set[j])] = true;
+                for(; first != last; ++first)
+                    if(table[static_cast<unsigned char>(*first)])
+                        return first;
+            }
+            return nullptr;
+        }
+
+        /* first occurrence of the m bytes of needle
+         *
+         * Blocks of candidate positions are filtered on the first and last
+         * bytes of the needle, only the matching ones are compared in full.
+         */
+        inline char const* find_substr(char const* first, char const* last, char const* needle, size_t m) {
+            if(m == 0)
+                return first;
+            if(size_t(last - first) < m)
+                return nullptr;
+            if(m == 1)
+                return find_char(first, last, needle[0]);
+            // candidates are in [first, stop)
+            char const* stop = last - m + 1;
+#ifdef __AVX2__
+            {
+                __m256i head = _mm256_set1_epi8(needle[0]), tail = _mm256_set1_epi8(needle[m - 1]);
+                for(; stop - first >= 32; first += 32) {
+                    __m256i bh = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(first));
+                    __m256i bt = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(first + m - 1));
+                    unsigned mask = _mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(bh, head), _mm256_cmpeq_epi8(bt, tail)));
+                    for(; mask; mask &= mask - 1) {
+                        char const* candidate = first + __builtin_ctz(mask);
+                        if(std::memcmp(candidate + 1, needle + 1, m - 2) == 0)
+                            return candidate;
+                    }
+                }
+            }
+#endif
+#ifdef __SSE2__
+            {
+                __m128i head = _mm_set1_epi8(needle[0]), tail = _mm_set1_epi8(needle[m - 1]);
+                for(; stop - first >= 16; first += 16) {
+                    __m128i bh = _mm_loadu_si128(reinterpret_cast<__m128i const*>(first));
+                    __m128i bt = _mm_loadu_si128(reinterpret_cast<__m128i const*>(first + m - 1));
+                    unsigned mask = _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(bh, head), _mm_cmpeq_epi8(bt, tail)));
+                    for(; mask; mask &= mask - 1) {
+                        char const* candidate = first + __builtin_ctz(mask);
+                        if(std::memcmp(candidate + 1, needle + 1, m - 2) == 0)
+                            return candidate;
+                    }
+                }
+            }
+#endif
+            for(; first < stop; ++first) {
+                first = find_char(first, stop, needle[0]);
+                if(not first)
+                    return nullptr;
+                if(std::memcmp(first + 1, needle + 1, m - 1) == 0)
+                    return first;
+            }
+            return nullptr;
+        }
+
+        /* true if (c | fold) is in [lo, hi] for all the bytes c of the range
+         *
+         * fold = 0x20 merges upper case and lower case ASCII letters.
+         */
+        inline bool all_in_range(char const* first, char const* last, char lo, char hi, char fold = 0) {
+#ifdef __SSE2__
+            __m128i vlo = _mm_set1_epi8(lo), vbound = _mm_set1_epi8(hi - lo), vfold = _mm_set1_epi8(fold);
+            for(; last - first >= 16; first += 16) {
+                __m128i b = _mm_or_si128(_mm_loadu_si128(reinterpret_cast<__m128i const*>(first)), vfold);
+                // unsigned (b - lo) <= (hi - lo)
+                __m128i d = _mm_sub_epi8(b, vlo);
+                if(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_max_epu8(d, vbound), vbound)) != 0xFFFF)
+                    return false;
+            }
+#endif
+            for(; first != last; ++first)
+                if(static_cast<unsigned char>((*first | fold) - lo) > static_cast<unsigned char>(hi - lo))
+                    return false;
+            return true;
+        }
+
+        // copies [first, last) to out, adding delta to the bytes in [lo, hi]
+        inline void shift_range(char const* first, char const* last, char* out, char lo, char hi, char delta) {
+#ifdef __SSE2__
+            __m128i vlo = _mm_set1_epi8(lo), vbound = _mm_set1_epi8(hi - lo), vdelta = _mm_set1_epi8(delta);
+            for(; last - first >= 16; first += 16, out += 16) {
+                __m128i b = _mm_loadu_si128(reinterpret_cast<__m128i const*>(first));
+                __m128i d = _mm_sub_epi8(b, vlo);
+                __m128i in = _mm_cmpeq_epi8(_mm_max_epu8(d, vbound), vbound);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_add_epi8(b, _mm_and_si128(in, vdelta)));
+            }
+#endif
+            for(; first != last; ++first, ++out)
+                *out = static_cast<unsigned char>(*first - lo) <= static_cast<unsigned char>(hi - lo) ? *first + delta : *first;
+        }
+
+    }
+
+}
+
+#endif
@@ -3,7 +3,7 @@ This module provides a dummy parser for pythran annotations.
     * spec_parser reads the specs from a python module and returns them.
 '''
 
-from numpy import array
+from numpy import array, ndarray
 from numpy import complex64, complex128
 from numpy import float32, float64
 from numpy import int8, int16, int32, int64
@@ -13,6 +13,22 @@ import ply.lex as lex
 import ply.yacc as yacc
 
 
+class StridedArray(ndarray):
+
+    """
+    Type of exported arrays that may be strided views over foreign memory,
+    as written ``float[:,:]`` in a pythran spec. Such arguments are taken
+    without copy whatever their strides, instead of being restricted to
+    C-contiguous arrays as ``float[][]``.
+    """
+
+
+def strided(t):
+    """ Turns the array type `t`, such as array([[float]]), into a strided
+    array type of the same dtype and dimension. """
+    return t.view(StridedArray)
+
+
 class SpecParser:
 
     """
@@ -23,6 +39,7 @@ class SpecParser:
 #pythran export a(str)
 #pythran export a( (str,str), int, long list list)
 #pythran export a( {str} )
+#pythran export a( float[:,:] )
 """
 
     # lex part
@@ -114,6 +131,7 @@ class SpecParser:
                 | type LIST
                 | type SET
                 | type LARRAY RARRAY
+                | type LARRAY columns RARRAY
                 | type COLUMN type DICT
                 | LPAREN types RPAREN'''
         if len(p) == 2:
@@ -126,12 +144,22 @@ class SpecParser:
             p[0] = tuple(p[2])
         elif len(p) == 4 and p[3] == ']':
             p[0] = array([p[1]])
+        elif len(p) == 5 and p[4] == ']':
+            t = p[1]
+            for _ in range(p[3]):
+                t = array([t])
+            p[0] = strided(t)
         elif len(p) == 5:
             p[0] = {p[1]: p[3]}
         else:
             raise SyntaxError("Invalid Pythran spec. "
                               "Unknown text '{0}'".format(p.value))
 
+    def p_columns(self, p):
+        '''columns : COLUMN
+                   | COLUMN COMMA columns'''
+        p[0] = 1 if len(p) == 2 else 1 + p[3]
+
     def p_term(self, p):
         '''term : STR
                 | BOOL
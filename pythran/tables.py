@@ -184,6 +184,7 @@ modules = {
         "hex": ConstFunctionIntr(),
         "id": ConstFunctionIntr(),
         "int_": ConstFunctionIntr(),
+        "intern": ConstFunctionIntr(),
         "iter": FunctionIntr(),  # not const
         "len": ConstFunctionIntr(),
         "list": ReadOnceFunctionIntr(),
@@ -238,6 +239,7 @@ modules = {
         "arctanh": ConstFunctionIntr(),
         "argmax": ConstFunctionIntr(),
         "argmin": ConstFunctionIntr(),
+        "argpartition": ConstFunctionIntr(),
         "argsort": ConstFunctionIntr(),
         "argwhere": ConstFunctionIntr(),
         "around": ConstFunctionIntr(),
@@ -313,6 +315,9 @@ modules = {
         "fmin": ConstFunctionIntr(),
         "fmod": ConstFunctionIntr(),
         "frexp": ConstFunctionIntr(),
+        "fromfile": FunctionIntr(args=('file', 'dtype', 'count', 'sep'),
+                                 defaults=(float, -1, ''),
+                                 global_effects=True),
         "fromfunction": ConstFunctionIntr(),
         "fromiter": ConstFunctionIntr(),
         "fromstring": ConstFunctionIntr(),
@@ -348,6 +353,12 @@ modules = {
         "less_equal": ConstFunctionIntr(),
         "lexsort": ConstFunctionIntr(),
         "linspace": ConstFunctionIntr(),
+        "loadtxt": FunctionIntr(args=('fname', 'dtype', 'comments', 'delimiter',
+                                      'converters', 'skiprows', 'usecols',
+                                      'unpack', 'ndmin'),
+                                defaults=(float, '#', None, None, 0, None,
+                                          False, 0),
+                                global_effects=True),
         "log": ConstFunctionIntr(),
         "log10": ConstFunctionIntr(),
         "log1p": ConstFunctionIntr(),
@@ -359,10 +370,15 @@ modules = {
         "logical_not": ConstFunctionIntr(),
         "logical_or": ConstFunctionIntr(),
         "logical_xor": ConstFunctionIntr(),
+        "matmul": ConstFunctionIntr(),
         "max": ConstMethodIntr(),
         "maximum": ConstFunctionIntr(),
         "mean": ConstMethodIntr(),
         "median": ConstFunctionIntr(),
+        "memmap": FunctionIntr(args=('filename', 'dtype', 'mode', 'offset',
+                                     'shape'),
+                               defaults=(None, 'r+', 0, None),
+                               global_effects=True),
         "min": ConstMethodIntr(),
         "minimum": ConstFunctionIntr(),
         "mod": ConstFunctionIntr(),
@@ -385,6 +401,8 @@ modules = {
         "ones": ConstFunctionIntr(),
         "ones_like": ConstFunctionIntr(),
         "outer": ConstFunctionIntr(),
+        "partition": ConstFunctionIntr(),
+        "percentile": ConstFunctionIntr(),
         "pi": ConstantIntr(),
         "place": FunctionIntr(),
         "power": ConstFunctionIntr(),
@@ -393,8 +411,34 @@ modules = {
         "ptp": ConstFunctionIntr(),
         "put": FunctionIntr(),
         "putmask": FunctionIntr(),
+        "quantile": ConstFunctionIntr(),
         "rad2deg": ConstFunctionIntr(),
         "radians": ConstFunctionIntr(),
+        "random": {
+            "choice": FunctionIntr(args=('a', 'size', 'replace', 'p'),
+                                   defaults=(None, True, None),
+                                   global_effects=True),
+            "exponential": FunctionIntr(args=('scale', 'size'),
+                                        defaults=(1., None),
+                                        global_effects=True),
+            "normal": FunctionIntr(args=('loc', 'scale', 'size'),
+                                   defaults=(0., 1., None),
+                                   global_effects=True),
+            "permutation": FunctionIntr(global_effects=True),
+            "rand": FunctionIntr(global_effects=True),
+            "randint": FunctionIntr(args=('low', 'high', 'size'),
+                                    defaults=(None, None),
+                                    global_effects=True),
+            "randn": FunctionIntr(global_effects=True),
+            "random_sample": FunctionIntr(args=('size',),
+                                          defaults=(None,),
+                                          global_effects=True),
+            "seed": FunctionIntr(global_effects=True),
+            "shuffle": FunctionIntr(global_effects=True),
+            "uniform": FunctionIntr(args=('low', 'high', 'size'),
+                                    defaults=(0., 1., None),
+                                    global_effects=True),
+            },
         "rank": ConstFunctionIntr(),
         "ravel": ConstFunctionIntr(),
         "real": FunctionIntr(),
@@ -425,6 +469,7 @@ modules = {
         "split": ConstFunctionIntr(),
         "sqrt": ConstFunctionIntr(),
         "square": ConstFunctionIntr(),
+        "std_": ConstMethodIntr(),
         "subtract": ConstFunctionIntr(),
         "sum": ConstMethodIntr(),
         "swapaxes": ConstMethodIntr(),
@@ -897,7 +942,9 @@ modules = {
         "isdigit": ConstMethodIntr(),
         "join": ConstMethodIntr(),
         "lower": ConstMethodIntr(),
+        "partition": ConstMethodIntr(),
         "replace": ConstMethodIntr(),
+        "rpartition": ConstMethodIntr(),
         "split": ConstMethodIntr(),
         "strip": ConstMethodIntr(),
         "lstrip": ConstMethodIntr(),
@@ -1041,6 +1088,10 @@ modules = {
         "size": AttributeIntr(3),
         "strides": AttributeIntr(2),
         "T": AttributeIntr(8),
+        "tofile": MethodIntr(args=('self', 'fid', 'sep'), defaults=('',),
+                             argument_effects=[ReadEffect(), UpdateEffect(),
+                                               ReadEffect()],
+                             global_effects=True),
         "tolist": ConstMethodIntr(),
         "tostring": ConstMethodIntr(),
         },
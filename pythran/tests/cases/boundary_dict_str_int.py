@@ -0,0 +1,6 @@
+#pythran export boundary_dict_str_int(str:int dict)
+#runas boundary_dict_str_int({"a": 1, "b": -2, "pythran": 3})
+#bench d = {str(i): i for i in xrange(1000000)} ; boundary_dict_str_int(d)
+def boundary_dict_str_int(d):
+    # str keys are copied and rehashed, into a map sized from the dict length
+    return d
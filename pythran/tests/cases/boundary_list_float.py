@@ -0,0 +1,6 @@
+#pythran export boundary_list_float(float list)
+#runas boundary_list_float([1.5, 2., -3.25, 4])
+#bench l = [float(i) for i in xrange(1000000)] ; boundary_list_float(l)
+def boundary_list_float(l):
+    # exact floats skip boost::python on the way in and on the way out
+    return l
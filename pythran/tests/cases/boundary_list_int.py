@@ -0,0 +1,6 @@
+#pythran export boundary_list_int(int list)
+#runas boundary_list_int([1, -2, 3, 1 << 40])
+#bench l = range(1000000) ; boundary_list_int(l)
+def boundary_list_int(l):
+    # exact ints skip boost::python, 1 << 40 checks values wider than 32 bits
+    return l
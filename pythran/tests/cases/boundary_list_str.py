@@ -0,0 +1,6 @@
+#pythran export boundary_list_str(str list)
+#runas boundary_list_str(["", "a", "hello world", "pythran" * 10])
+#bench l = [str(i) for i in xrange(1000000)] ; boundary_list_str(l)
+def boundary_list_str(l):
+    # short strings are stored inline, the last one needs its own buffer
+    return l
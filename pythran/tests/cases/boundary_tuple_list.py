@@ -0,0 +1,6 @@
+#pythran export boundary_tuple_list((int, float, complex, bool) list)
+#runas boundary_tuple_list([(1, 2., 3j, True), (-1, .5, 1 + 1j, False)])
+#bench l = [(i, i * .5, i * 1j, i % 2 == 0) for i in xrange(300000)] ; boundary_tuple_list(l)
+def boundary_tuple_list(l):
+    # every field of the tuples takes the fast path of its own type
+    return l
@@ -0,0 +1,12 @@
+#pythran export brownian_paths(int, int, float, float)
+#runas abs(brownian_paths(2000, 50, .05, .2) - 1.01) < .05
+#bench brownian_paths(20000, 250, .05, .2)
+import numpy as np
+
+def brownian_paths(npaths, nsteps, mu, sigma):
+    # mean final price of geometric brownian motions, one step per day
+    dt = 1. / 250
+    s = np.ones(npaths)
+    for i in xrange(nsteps):
+        s *= np.exp((mu - .5 * sigma ** 2) * dt + sigma * np.sqrt(dt) * np.random.randn(npaths))
+    return s.mean()
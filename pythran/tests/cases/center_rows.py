@@ -0,0 +1,11 @@
+#pythran export center_rows(float [][], float[][])
+#runas import numpy as np ; X = np.arange(60.).reshape(6, 10) ; Y = np.arange(60.).reshape(10, 6) ; center_rows(X, Y)
+#bench import numpy as np ; X = np.arange(4000000.).reshape(2000, 2000) ; Y = np.arange(4000000.).reshape(2000, 2000) ; center_rows(X, Y)
+import numpy as np
+
+def center_rows(X, Y):
+    mean_row = np.mean(X, 0)
+    centered = X - mean_row
+    mixed = centered * Y.T
+    selected = mixed[mixed > 0.] * 2.
+    return centered, mixed, selected.sum()
@@ -0,0 +1,7 @@
+#pythran export dot_matmul(float[][], float[][])
+#runas import numpy as np; a = np.arange(900.).reshape(30, 30); b = np.arange(1200.).reshape(30, 40); dot_matmul(a, b)
+#bench import numpy as np; a = np.ones((500, 500)); b = np.ones((500, 500)); dot_matmul(a, b)
+import numpy as np
+
+def dot_matmul(a, b):
+  return np.dot(a, b) + np.dot(a.T, b)
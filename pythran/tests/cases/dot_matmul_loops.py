@@ -0,0 +1,18 @@
+#pythran export dot_matmul_loops(float[][], float[][])
+#runas import numpy as np; a = np.arange(900.).reshape(30, 30); b = np.arange(1200.).reshape(30, 40); dot_matmul_loops(a, b)
+#bench import numpy as np; a = np.ones((500, 500)); b = np.ones((500, 500)); dot_matmul_loops(a, b)
+import numpy as np
+
+def matmul(a, b):
+  m, n, k = a.shape[0], b.shape[1], a.shape[1]
+  c = np.zeros((m, n))
+  for i in xrange(m):
+    for j in xrange(n):
+      r = 0.
+      for p in xrange(k):
+        r += a[i, p] * b[p, j]
+      c[i, j] = r
+  return c
+
+def dot_matmul_loops(a, b):
+  return matmul(a, b) + matmul(a.T, b)
@@ -0,0 +1,10 @@
+#pythran export log_fields(str)
+#runas log_fields("2014-03-12T10:00:00 host-1 GET /index.html 200\n2014-03-12T10:00:01 host-2 GET /favicon.ico 404\n")
+#bench text = "".join("2014-03-12T10:00:%02d host-%d GET /api/v1/resource/with/a/longer/path/%d 200\n" % (i % 60, i % 97, i) for i in xrange(200000)); log_fields(text)
+def log_fields(text):
+    # long lines share the buffer of text, short fields are stored inline
+    hosts = {}
+    for line in text.strip().split("\n"):
+        host, status = line.split(" ")[1], line.rpartition(" ")[2]
+        hosts[host] = hosts.get(host, 0) + (status == "200")
+    return len(hosts), sum(hosts.values())
@@ -0,0 +1,12 @@
+#pythran export log_search(str)
+#runas log_search("2014-03-12 10:00:01 INFO [worker-1] GET /index.html 200 12\n2014-03-12 10:00:02 ERROR [worker-2] GET /missing 404 3\n")
+#bench text = "".join("2014-03-12 10:00:%02d %s [worker-%d] GET /api/v1/items/%d 200 %d\n" % (i % 60, "ERROR" if i % 500 == 0 else "INFO", i % 16, i, i % 1000) for i in xrange(300000)); log_search(text)
+def log_search(text):
+    # substring, separator and character class searches over log lines
+    errors = text.count("ERROR")
+    slow = 0
+    for line in text.split("\n"):
+        if line.find("/api/") >= 0 and line.endswith("99"):
+            slow += 1
+    fields = text.replace("INFO", "I").upper().split()
+    return errors, slow, len(fields), sum(1 for f in fields if f.isdigit())
@@ -0,0 +1,6 @@
+#pythran export median_lanes(float[][])
+#runas import numpy as np; median_lanes(np.array([[1., 5., 2.], [0., -1., 3.], [4., 4., 8.]]))
+#bench import numpy.random; a = numpy.random.rand(256, 20000); median_lanes(a)
+import numpy as np
+def median_lanes(a):
+    return np.median(a, 1), np.percentile(a, 95, 0)
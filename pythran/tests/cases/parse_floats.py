@@ -0,0 +1,8 @@
+#pythran export parse_floats(str)
+#runas s = " ".join(repr(i * .25) for i in xrange(20000)) ; parse_floats(s)
+#bench s = " ".join(repr(i * .25) for i in xrange(1000000)) ; parse_floats(s)
+import numpy
+
+def parse_floats(s):
+    a = numpy.fromstring(s, sep=' ')
+    return a.sum(), a.max(), a.size
@@ -0,0 +1,9 @@
+#pythran export periodic_wrap(float [], float[], float)
+#runas import numpy as np ; x = np.arange(-50., 50., 0.3) ; v = np.arange(0., 100., 0.3) ; periodic_wrap(x, v, 4.)
+#bench import numpy as np ; x = np.arange(-5e5, 5e5, 0.1) ; v = np.arange(0., 1e6, 0.1) ; periodic_wrap(x, v, 4.)
+import numpy as np
+
+def periodic_wrap(x, v, L):
+    # move particles and fold them back into the [0, L) box
+    y = (x + 0.01 * v) % L
+    return y, np.logaddexp(y, -y).sum()
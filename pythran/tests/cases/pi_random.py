@@ -0,0 +1,14 @@
+#pythran export pi_random(int)
+#runas abs(pi_random(100000) - 3.14159) < .05
+#bench pi_random(20000000)
+from random import random
+
+def pi_random(DARTS):
+    hits = 0
+    "omp parallel for reduction(+:hits)"
+    for i in xrange(DARTS):
+        x = random()
+        y = random()
+        if x * x + y * y <= 1.0:
+            hits += 1
+    return 4. * hits / DARTS
@@ -0,0 +1,12 @@
+#pythran export set_dedup(int list, int list)
+#runas set_dedup([i * 7919 % 100003 for i in range(200000)], range(0, 300000, 3))
+#bench set_dedup([i * 7919 % 1000003 for i in range(2000000)], range(0, 3000000, 3))
+def set_dedup(ids, queries):
+    seen = set()
+    for i in ids:
+        seen.add(i)
+    hits = 0
+    for q in queries:
+        if q in seen:
+            hits += 1
+    return len(seen), hits, len(seen & set(queries))
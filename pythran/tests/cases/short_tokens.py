@@ -0,0 +1,9 @@
+#pythran export short_tokens(str)
+#runas short_tokens("the quick brown fox jumps over the lazy dog " * 10)
+#bench text = " ".join(str(i * 7919 % 50021) for i in xrange(1000000)); short_tokens(text)
+def short_tokens(text):
+    # mostly exercises creation and hashing of short strings
+    counts = {}
+    for w in text.split(" "):
+        counts[w] = counts.get(w, 0) + 1
+    return len(counts), max(counts.values())
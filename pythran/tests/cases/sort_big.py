@@ -0,0 +1,6 @@
+#pythran export sort_big(float[], int[][])
+#runas import numpy as np; sort_big(np.array([3.5, -1., 2.25, 0.]), np.array([[4, 1], [2, 3], [0, 5]]))
+#bench import numpy.random; a = numpy.random.rand(4000000); b = numpy.random.randint(0, 1 << 30, (1000, 1000)); sort_big(a, b)
+import numpy as np
+def sort_big(a, b):
+    return np.sort(a), np.argsort(a), np.sort(b, 0), np.sort(b)
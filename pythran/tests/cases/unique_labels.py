@@ -0,0 +1,7 @@
+#pythran export unique_labels(int[])
+#runas import numpy as np; unique_labels(np.array([4, 1, 4, 2, 1, 7]))
+#bench import numpy.random; a = numpy.random.randint(0, 100000, 10000000); unique_labels(a)
+import numpy as np
+def unique_labels(a):
+    values, index, inverse = np.unique(a, True, True)
+    return values, index, inverse
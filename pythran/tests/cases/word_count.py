@@ -0,0 +1,10 @@
+#pythran export word_count(str list)
+#runas word_count(["a", "b", "a", "c", "b", "a"])
+#bench words = [str(i * 7919 % 50021) for i in xrange(2000000)]; word_count(words)
+def word_count(words):
+    # measures dict lookups and insertions, compile with
+    # -DPYTHRAN_DICT_UNORDERED_MAP to compare with the node based dict
+    counts = {}
+    for w in words:
+        counts[w] = counts.get(w, 0) + 1
+    return counts
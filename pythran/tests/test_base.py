@@ -716,3 +716,13 @@ def add_slice_to_list(l):
         self.run_test("def floordiv_float1(n): return n//2, (-n)//2",
                       3.5,
                       floordiv_float1=[float])
+
+    def test_floordiv_float_result(self):
+        self.run_test("def floordiv_float_result(x, y): return x // y, (x // y) / 2, (-x) // y / 2",
+                      7.5, 2.,
+                      floordiv_float_result=[float, float])
+
+    def test_modulo_negative_divisor(self):
+        self.run_test("def modulo_negative_divisor(n, m): return n % -3, m % -3, (-n) // -2, n // -2",
+                      5, 5.4,
+                      modulo_negative_divisor=[int, float])
@@ -0,0 +1,99 @@
+import unittest
+from pythran.cache import ModuleCache
+from pythran.config import cfg
+import pythran.toolchain
+import os
+import shutil
+import tempfile
+import time
+
+
+class TestCache(unittest.TestCase):
+
+    def setUp(self):
+        self.directory = tempfile.mkdtemp()
+        self.module = os.path.join(self.directory, 'module.bin')
+        with open(self.module, 'w') as module:
+            module.write('x' * 1000)
+
+    def tearDown(self):
+        shutil.rmtree(self.directory)
+
+    def key(self, code):
+        return ModuleCache(self.directory, 0).key(
+            'm', code, {'f': ((int,),)}, ['pythran.optimizations.Square'],
+            ('c++', ['-O2']))
+
+    def test_key(self):
+        self.assertEqual(self.key('def f(x): return x'),
+                         self.key('def f(x): return x'))
+        self.assertNotEqual(self.key('def f(x): return x'),
+                            self.key('def f(x): return -x'))
+
+    def test_lookup(self):
+        cache = ModuleCache(self.directory, 10000)
+        key = self.key('def f(x): return x')
+        self.assertIsNone(cache.lookup(key, 'm.so'))
+        cache.store(key, {'m.so': self.module})
+        self.assertIsNotNone(cache.lookup(key, 'm.so'))
+        self.assertIsNone(cache.lookup(key, 'm.cpp'))
+
+    def test_evict(self):
+        cache = ModuleCache(self.directory, 2500)
+        keys = [self.key('def f(x): return {0}'.format(i)) for i in range(3)]
+        cache.store(keys[0], {'m.so': self.module})
+        time.sleep(.01)
+        cache.store(keys[1], {'m.so': self.module})
+        time.sleep(.01)
+        cache.lookup(keys[0], 'm.so')
+        time.sleep(.01)
+        cache.store(keys[2], {'m.so': self.module})
+        self.assertIsNotNone(cache.lookup(keys[0], 'm.so'))
+        self.assertIsNone(cache.lookup(keys[1], 'm.so'))
+        self.assertIsNotNone(cache.lookup(keys[2], 'm.so'))
+
+
+class TestCompileCache(unittest.TestCase):
+    '''Cache seen through compile_pythrancode'''
+
+    code = "#pythran export f(int)\ndef f(x): return x + 1"
+
+    def setUp(self):
+        self.directory = tempfile.mkdtemp()
+        self.saved = dict((option, cfg.get(section, option))
+                          for section, option in (('cache', 'directory'),
+                                                  ('typing', 'max_combiner')))
+        cfg.set('cache', 'directory', self.directory)
+        self.generated = []
+        self.generate_cxx = pythran.toolchain.generate_cxx
+
+        def generate_cxx(*args, **kwargs):
+            self.generated.append(args[0])
+            return self.generate_cxx(*args, **kwargs)
+        pythran.toolchain.generate_cxx = generate_cxx
+
+    def tearDown(self):
+        pythran.toolchain.generate_cxx = self.generate_cxx
+        cfg.set('cache', 'directory', self.saved['directory'])
+        cfg.set('typing', 'max_combiner', self.saved['max_combiner'])
+        shutil.rmtree(self.directory)
+
+    def compile(self):
+        output = pythran.toolchain.compile_pythrancode('m', self.code,
+                                                       cpponly=True)
+        with open(output) as generated:
+            content = generated.read()
+        os.remove(output)
+        return content
+
+    def test_hit(self):
+        first = self.compile()
+        self.assertEqual(self.compile(), first)
+        self.assertEqual(len(self.generated), 1)
+
+    def test_settings_change(self):
+        self.compile()
+        cfg.set('typing', 'max_combiner',
+                str(int(self.saved['max_combiner']) + 1))
+        self.compile()
+        self.assertEqual(len(self.generated), 2)
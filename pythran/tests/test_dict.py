@@ -114,3 +114,6 @@ def dict_copy(a):
 
     def test_dict_setdefault_combiner(self):
         return self.run_test("def dict_setdefault_combiner():\n a=dict()\n a.setdefault(1,'e')\n return a", dict_setdefault_combiner=[])
+
+    def test_dict_grow_and_pop(self):
+        return self.run_test("def dict_grow_and_pop(n):\n a=dict()\n for i in range(n): a[i*7 % n]=i\n for i in range(0, n, 3): a.pop(i)\n for i in range(0, n, 6): a[i]=-i\n return a", 1000, dict_grow_and_pop=[int])
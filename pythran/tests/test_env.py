@@ -1,5 +1,6 @@
 from pythran import compile_pythrancode
 from pythran.backend import Python
+from pythran.config import cfg
 from pythran.middlend import refine
 from pythran.passmanager import PassManager
 from pythran.toolchain import _parse_optimization
@@ -14,6 +15,9 @@ import numpy.testing as npt
 import ast
 import pytest
 
+# test modules are compiled once, keeping them would only fill the user's cache
+cfg.set('cache', 'directory', '')
+
 
 class TestEnv(unittest.TestCase):
     """
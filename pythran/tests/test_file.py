@@ -120,6 +120,29 @@ def file_close(filename):
             self.tempfile()
             self.run_test("""def _iter(filename):\n f=file(filename)\n return [l for l in f]""", self.filename, _iter=[str])
 
+    def test_next_eof(self):
+            self.tempfile()
+            self.run_test("""def _next_eof(filename):\n f=file(filename)\n return [f.next(),f.next(),f.next()]""", self.filename, _next_eof=[str])
+
+    def test_next_stop(self):
+            self.tempfile()
+            self.run_test("""def _next_stop(filename):\n f=file(filename)\n return [f.next(),f.next(),f.next(),f.next()]""", self.filename, _next_stop=[str], check_exception=True)
+
+    def test_iter_long_lines(self):
+            filename=mkstemp()[1]
+            with open(filename,"w") as f:
+                for i in xrange(20000):
+                    f.write("line {0} {1}\n".format(i, "x" * (i % 300)))
+                f.write("last line without newline")
+            self.run_test("""def _iter_long_lines(filename):\n f=file(filename)\n kept=[]\n size=0\n for l in f:\n  size+=len(l)\n  if l.startswith("line 1"): kept.append(l)\n return size, kept""", filename, _iter_long_lines=[str])
+
+    def test_readlines_long_lines(self):
+            filename=mkstemp()[1]
+            with open(filename,"w") as f:
+                for i in xrange(5000):
+                    f.write("{0}\n".format("y" * (i % 1000)))
+            self.run_test("""def _readlines_long_lines(filename):\n return file(filename).readlines()""", filename, _readlines_long_lines=[str])
+
     def test_fileno(self):
             self.tempfile()
             # Useless to check if same fileno, just checking if fct can be called
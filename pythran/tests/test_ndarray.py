@@ -1,5 +1,6 @@
 import unittest
 from test_env import TestEnv
+from pythran.spec import strided
 import numpy
 
 
@@ -473,3 +474,123 @@ def assign_ndarray(t):
         self.run_test("def np_count_nonzero(a): from numpy import count_nonzero; return count_nonzero(a*2)",
                       numpy.array([[-1, -5, -2, 7], [9, 3, 0, -0]]), np_count_nonzero=[numpy.array([[int]])])
 
+
+
+@TestEnv.module
+class TestNdarrayPoolAllocator(TestEnv):
+    PYTHRAN_CXX_FLAGS = TestEnv.PYTHRAN_CXX_FLAGS + ['-DPYTHRAN_ALLOCATOR_POOL']
+
+    def test_pool_temporaries(self):
+        self.run_test("def pool_temporaries(a):\n import numpy as np\n s = 0\n for i in range(100): s += np.sum(np.ones(len(a)) * i + a)\n return s",
+                      numpy.arange(1000.), pool_temporaries=[numpy.array([float])])
+
+    def test_pool_return(self):
+        self.run_test("def pool_return(a): import numpy as np ; b = np.ones(len(a)) + a ; return b, b[1:]",
+                      numpy.arange(100), pool_return=[numpy.array([int])])
+
+
+@TestEnv.module
+class TestNdarrayArenaAllocator(TestEnv):
+    PYTHRAN_CXX_FLAGS = TestEnv.PYTHRAN_CXX_FLAGS + ['-DPYTHRAN_ALLOCATOR_ARENA']
+
+    def test_arena_temporaries(self):
+        self.run_test("def arena_temporaries(a):\n import numpy as np\n s = 0\n for i in range(100): s += np.sum(np.ones(len(a)) * i + a)\n return s",
+                      numpy.arange(1000.), arena_temporaries=[numpy.array([float])])
+
+    def test_arena_return(self):
+        self.run_test("def arena_return(a): import numpy as np ; b = np.ones(len(a)) + a ; return b, b[1:]",
+                      numpy.arange(100), arena_return=[numpy.array([int])])
+
+
+@TestEnv.module
+class TestNdarraySIMD(TestEnv):
+    PYTHRAN_CXX_FLAGS = TestEnv.PYTHRAN_CXX_FLAGS + ['-DUSE_BOOST_SIMD']
+
+    def test_simd_tail(self):
+        self.run_test("def simd_tail(a, b): import numpy as np ; return np.array(a + b * 2), np.array(a[1:] - 1)",
+                      numpy.arange(13.), numpy.arange(13.), simd_tail=[numpy.array([float]), numpy.array([float])])
+
+    def test_simd_tail_int32(self):
+        self.run_test("def simd_tail_int32(a): import numpy as np ; return np.array(-a + a)",
+                      numpy.arange(7, dtype=numpy.int32), simd_tail_int32=[numpy.array([numpy.int32])])
+
+    def test_simd_mixed_scalar(self):
+        self.run_test("def simd_mixed_scalar(a): return a * 2.5 + 1",
+                      numpy.arange(19, dtype=numpy.float32), simd_mixed_scalar=[numpy.array([numpy.float32])])
+
+    def test_simd_mixed_int(self):
+        self.run_test("def simd_mixed_int(a, b): return a + b",
+                      numpy.arange(19, dtype=numpy.int32), numpy.arange(19), simd_mixed_int=[numpy.array([numpy.int32]), numpy.array([int])])
+
+    def test_simd_mixed_int_float(self):
+        self.run_test("def simd_mixed_int_float(a, b): return a * b - a, a + 1.5",
+                      numpy.arange(-9, 10), numpy.arange(19.), simd_mixed_int_float=[numpy.array([int]), numpy.array([float])])
+
+    def test_simd_mixed_float(self):
+        self.run_test("def simd_mixed_float(a, b): return a * b - a",
+                      numpy.arange(19, dtype=numpy.float32), numpy.arange(19.), simd_mixed_float=[numpy.array([numpy.float32]), numpy.array([float])])
+
+    def test_simd_widening(self):
+        self.run_test("def simd_widening(a, b, c): return a * b + a, a[1:] * b[1:], (a * b).sum(), c * b - c",
+                      numpy.arange(37, dtype=numpy.float32) - 9, numpy.arange(37.) / 4, numpy.arange(37, dtype=numpy.int32) - 18,
+                      simd_widening=[numpy.array([numpy.float32]), numpy.array([float]), numpy.array([numpy.int32])])
+
+    def test_simd_narrowing(self):
+        self.run_test("def simd_narrowing(a, b): return a * b + a, a[1:] * b[1:], (a - b).sum()",
+                      numpy.arange(37) - 18, numpy.arange(37, dtype=numpy.float32) / 2,
+                      simd_narrowing=[numpy.array([int]), numpy.array([numpy.float32])])
+
+    def test_simd_broadcasted(self):
+        self.run_test("def simd_broadcasted(a, b): return a - b, b * a + b",
+                      numpy.arange(57.).reshape(3, 19), numpy.arange(19.), simd_broadcasted=[numpy.array([[float]]), numpy.array([float])])
+
+    def test_simd_texpr(self):
+        self.run_test("def simd_texpr(a, b): return a.T + b, a.T.copy()",
+                      numpy.arange(57.).reshape(3, 19), numpy.arange(57.).reshape(19, 3), simd_texpr=[numpy.array([[float]]), numpy.array([[float]])])
+
+    def test_simd_fexpr(self):
+        self.run_test("def simd_fexpr(a): return a[a > 7] * 3 + 1",
+                      numpy.arange(37.), simd_fexpr=[numpy.array([float])])
+
+    def test_simd_mod(self):
+        self.run_test("def simd_mod(a, b): return (a - 3) % 4, (a * 1.5 - 7) % b, a // 3",
+                      numpy.arange(-19, 19), numpy.arange(1., 39.), simd_mod=[numpy.array([int]), numpy.array([float])])
+
+    def test_simd_logaddexp(self):
+        self.run_test("def simd_logaddexp(a, b): import numpy as np ; return np.logaddexp(a, b), np.logaddexp2(a * 100, b)",
+                      numpy.arange(-9., 10.), numpy.arange(19.), simd_logaddexp=[numpy.array([float]), numpy.array([float])])
+
+    def test_strided_input(self):
+        self.run_test("def strided_input(a, b): return a * 2 + b, a.shape",
+                      strided_input=[strided(numpy.array([[float]])), numpy.array([float])],
+                      runas="import numpy; a = numpy.arange(60.).reshape(6, 10); strided_input(a[1::2, ::3], numpy.arange(4.))")
+
+    def test_strided_input_reversed(self):
+        self.run_test("def strided_input_reversed(a): return a.sum(), a[0], a[-1]",
+                      strided_input_reversed=[strided(numpy.array([[int]]))],
+                      runas="import numpy; a = numpy.arange(60).reshape(6, 10); strided_input_reversed(a[::-1, ::-2])")
+
+    def test_strided_input_fortran(self):
+        self.run_test("def strided_input_fortran(a, b): return a + b, a[1]",
+                      strided_input_fortran=[strided(numpy.array([[float]])), strided(numpy.array([[float]]))],
+                      runas="import numpy; a = numpy.asfortranarray(numpy.arange(60.).reshape(6, 10)); strided_input_fortran(a, a.T.T)")
+
+    def test_strided_input_mixed(self):
+        self.run_test("def strided_input_mixed(a, b, c): return a + b, a[1] + c",
+                      strided_input_mixed=[strided(numpy.array([[float]])), strided(numpy.array([[float]])), strided(numpy.array([float]))],
+                      runas="import numpy; a = numpy.asfortranarray(numpy.arange(60.).reshape(6, 10)); b = numpy.arange(120.).reshape(6, 20)[:, ::2]; strided_input_mixed(a, b, numpy.arange(20.)[::2])")
+
+    def test_strided_input_many(self):
+        self.run_test("def strided_input_many(a, b, c, d): return a + b - c * d",
+                      strided_input_many=[strided(numpy.array([[float]]))] * 4,
+                      runas="import numpy; a = numpy.arange(60.).reshape(6, 10); b = numpy.asfortranarray(a); strided_input_many(a, b, a[::-1], b.T.T)")
+
+    def test_strided_input_dense(self):
+        self.run_test("def strided_input_dense(a): return a.T.copy(), a[:, 1]",
+                      strided_input_dense=[strided(numpy.array([[float]]))],
+                      runas="import numpy; a = numpy.arange(60.).reshape(6, 10); strided_input_dense(a)")
+
+    def test_simd_int_mod_padding(self):
+        self.run_test("def simd_int_mod_padding(a, b): return a % b, a // b, (a + 1) % (b * 2)",
+                      numpy.arange(10, 17), numpy.array([3, 4, 5, 6, 7, 8, 9]),
+                      simd_int_mod_padding=[numpy.array([int]), numpy.array([int])])
@@ -1,4 +1,5 @@
 import unittest
+from tempfile import mkstemp
 from test_env import TestEnv
 import numpy
 
@@ -223,6 +224,30 @@ def np_rosen_der(x):
     def test_median1(self):
         self.run_test("def np_median1(a): from numpy import median ; return median(a)", numpy.array([1, 2, 3, 4,5]), np_median1=[numpy.array([int])])
 
+    def test_median2(self):
+        self.run_test("def np_median2(a): from numpy import median ; return median(a, 0)", numpy.arange(24.).reshape(4, 6) * 7 % 11, np_median2=[numpy.array([[float]])])
+
+    def test_median3(self):
+        self.run_test("def np_median3(a): from numpy import median ; return median(a, -1)", numpy.array([[5, 1, 9, 2], [7, 3, 3, 8]]), np_median3=[numpy.array([[int]])])
+
+    def test_percentile0(self):
+        self.run_test("def np_percentile0(a): from numpy import percentile ; return percentile(a, 25)", numpy.array([[5, 1, 9, 2], [7, 3, 3, 8]]), np_percentile0=[numpy.array([[int]])])
+
+    def test_percentile1(self):
+        self.run_test("def np_percentile1(a): from numpy import percentile ; return percentile(a, 90, 1)", numpy.arange(30.).reshape(3, 10) * 7 % 13, np_percentile1=[numpy.array([[float]])])
+
+    def test_quantile0(self):
+        self.run_test("def np_quantile0(a): from numpy import quantile ; return quantile(a, .3, 0)", numpy.arange(30.).reshape(10, 3) * 7 % 13, np_quantile0=[numpy.array([[float]])])
+
+    def test_partition0(self):
+        self.run_test("def np_partition0(a): from numpy import partition ; b = partition(a, 3) ; return b[3], b[:3].max() <= b[3] <= b[4:].min()", numpy.arange(100) * 37 % 101, np_partition0=[numpy.array([int])])
+
+    def test_partition1(self):
+        self.run_test("def np_partition1(a): from numpy import partition ; b = partition(a, [0, -1], 0) ; return b[0], b[-1]", numpy.arange(24.).reshape(6, 4) * 7 % 11, np_partition1=[numpy.array([[float]])])
+
+    def test_argpartition0(self):
+        self.run_test("def np_argpartition0(a): from numpy import argpartition ; return a[argpartition(a, 5)[5]]", numpy.arange(100.) * 37 % 101, np_argpartition0=[numpy.array([float])])
+
     def test_mean0(self):
         self.run_test("def np_mean0(a): from numpy import mean ; return mean(a)", numpy.array([[1, 2], [3, 4]]), np_mean0=[numpy.array([[int]])])
 
@@ -259,6 +284,33 @@ def np_rosen_der(x):
     def test_var5(self):
         self.run_test("def np_var5(a): from numpy import var ; return var(a, 2)", numpy.array([[[1, 2], [3, 4.]]]), np_var5=[numpy.array([[[float]]])])
 
+    def test_mean6(self):
+        self.run_test("def np_mean6(a): from numpy import mean ; return mean(a, 0)", numpy.arange(12).reshape(3,4), np_mean6=[numpy.array([[int]])])
+
+    def test_mean7(self):
+        self.run_test("def np_mean7(a): from numpy import mean ; return mean(a * 2 + 1, 1)", numpy.arange(12.).reshape(3,4), np_mean7=[numpy.array([[float]])])
+
+    def test_var6(self):
+        self.run_test("def np_var6(a): from numpy import var ; return var(a * 2 + 1)", numpy.arange(1000.).reshape(10,100) ** 0.5, np_var6=[numpy.array([[float]])])
+
+    def test_var7(self):
+        self.run_test("def np_var7(a): from numpy import var ; return var(a[1:,::2], 1)", numpy.arange(60).reshape(6,10), np_var7=[numpy.array([[int]])])
+
+    def test_var8(self):
+        self.run_test("def np_var8(a): return a.var(0, None, None, 1)", 1e6 + numpy.arange(60.).reshape(6,10) ** 2, np_var8=[numpy.array([[float]])])
+
+    def test_std0(self):
+        self.run_test("def np_std0(a): from numpy import std ; return std(a)", numpy.arange(12.).reshape(3,4), np_std0=[numpy.array([[float]])])
+
+    def test_std1(self):
+        self.run_test("def np_std1(a): from numpy import std ; return std(a.T, 1)", numpy.arange(12).reshape(3,4), np_std1=[numpy.array([[int]])])
+
+    def test_std2(self):
+        self.run_test("def np_std2(a): return (a - a.mean()).std(0)", numpy.arange(24.).reshape(2,3,4), np_std2=[numpy.array([[[float]]])])
+
+    def test_fused_reduction(self):
+        self.run_test("def np_fused_reduction(x): return ((x - x.mean())**2).sum(axis=1)", numpy.arange(24.).reshape(4,6), np_fused_reduction=[numpy.array([[float]])])
+
     def test_logspace0(self):
         self.run_test("def np_logspace0(start, stop): from numpy import logspace ; start, stop = 3., 4. ; return logspace(start, stop, 4)", 3., 4., np_logspace0=[float, float])
 
@@ -313,6 +365,9 @@ def np_rosen_der(x):
     def test_intersect1d0(self):
         self.run_test("def np_intersect1d0(a): from numpy import intersect1d ; b = [3, 1, 2, 1] ; return intersect1d(a,b)", [1, 3, 4, 3], np_intersect1d0=[[int]])
 
+    def test_intersect1d1(self):
+        self.run_test("def np_intersect1d1(a, b): from numpy import intersect1d ; return intersect1d(a,b)", numpy.arange(1000) * 7 % 101, numpy.arange(50.) * 3, np_intersect1d1=[numpy.array([int]), numpy.array([float])])
+
     def test_insert0(self):
         self.run_test("def np_insert0(a): from numpy import insert ; return insert(a, 1, 5)", numpy.array([[1, 1], [2, 2], [3, 3]]), np_insert0=[numpy.array([[int]])])
 
@@ -349,6 +404,77 @@ def np_rosen_der(x):
     def test_fromstring3(self):
         self.run_test("def np_fromstring3(a): from numpy import fromstring, uint32 ; return fromstring(a, uint32,2, ',')", '1,2, 3, 4', np_fromstring3=[str])
 
+    def test_fromstring4(self):
+        self.run_test("def np_fromstring4(a): from numpy import fromstring ; return fromstring(a, sep=', ')", '1.5, -2e3,3.25 ,inf, 0.1,', np_fromstring4=[str])
+
+    def test_fromstring5(self):
+        self.run_test("def np_fromstring5(a): from numpy import fromstring ; return fromstring(a, sep=' ')", ' '.join(repr(x) for x in numpy.random.randn(100000)), np_fromstring5=[str])
+
+    def test_loadtxt0(self):
+        filename = mkstemp()[1]
+        open(filename, 'w').write('# x y z\n1 2 3\n\n4.5 5 6 # last\n')
+        self.run_test("def np_loadtxt0(f): from numpy import loadtxt ; return loadtxt(f)", filename, np_loadtxt0=[str])
+
+    def test_loadtxt1(self):
+        filename = mkstemp()[1]
+        open(filename, 'w').write('a,b,c\n1,2,3\n4,5,6\n7,8,9\n')
+        self.run_test("def np_loadtxt1(f): from numpy import loadtxt ; return loadtxt(f, int, delimiter=',', skiprows=1, usecols=(2, 0))", filename, np_loadtxt1=[str])
+
+    def test_loadtxt2(self):
+        filename = mkstemp()[1]
+        numpy.savetxt(filename, numpy.random.randn(1000, 3))
+        self.run_test("def np_loadtxt2(f): from numpy import loadtxt ; return loadtxt(f, unpack=True)", filename, np_loadtxt2=[str])
+
+    def test_loadtxt3(self):
+        filename = mkstemp()[1]
+        open(filename, 'w').write('1\n2\n3\n')
+        self.run_test("def np_loadtxt3(f): from numpy import loadtxt ; return loadtxt(f, ndmin=2)", filename, np_loadtxt3=[str])
+
+    def test_loadtxt4(self):
+        filename = mkstemp()[1]
+        open(filename, 'w').write('1 2\n3 4\n')
+        self.run_test("def np_loadtxt4(f): from numpy import loadtxt ; return loadtxt(f, ndmin=1)", filename, np_loadtxt4=[str])
+
+    def test_fromfile0(self):
+        filename = mkstemp()[1]
+        numpy.arange(10.).tofile(filename)
+        self.run_test("def np_fromfile0(f): from numpy import fromfile ; return fromfile(f)", filename, np_fromfile0=[str])
+
+    def test_fromfile1(self):
+        filename = mkstemp()[1]
+        numpy.arange(10, dtype=numpy.uint8).tofile(filename)
+        self.run_test("def np_fromfile1(f): from numpy import fromfile, uint8 ; return fromfile(f, uint8, count=3)", filename, np_fromfile1=[str])
+
+    def test_fromfile2(self):
+        filename = mkstemp()[1]
+        open(filename, 'w').write('1 2 3.5 4')
+        self.run_test("def np_fromfile2(f): from numpy import fromfile ; return fromfile(f, sep=' ')", filename, np_fromfile2=[str])
+
+    def test_fromfile3(self):
+        filename = mkstemp()[1]
+        numpy.arange(10).tofile(filename)
+        self.run_test("def np_fromfile3(f): from numpy import fromfile ; fd = file(f) ; a = fromfile(fd, int, 3) ; return a, fromfile(fd, int)", filename, np_fromfile3=[str])
+
+    def test_memmap0(self):
+        filename = mkstemp()[1]
+        numpy.arange(24.).tofile(filename)
+        self.run_test("def np_memmap0(f): from numpy import memmap, float64 ; m = memmap(f, float64, 'r', 32, (4, 5)) ; return m[1:3] * 1", filename, np_memmap0=[str])
+
+    def test_memmap1(self):
+        filename = mkstemp()[1]
+        numpy.arange(24.).tofile(filename)
+        self.run_test("def np_memmap1(f):\n from numpy import memmap, float64, fromfile\n m = memmap(f, float64, mode='r+')\n m[3:6] = 1.\n return fromfile(f)", filename, np_memmap1=[str])
+
+    def test_memmap2(self):
+        filename = mkstemp()[1]
+        numpy.arange(8, dtype=numpy.int32).tofile(filename)
+        self.run_test("def np_memmap2(f):\n from numpy import memmap, int32, fromfile\n m = memmap(f, int32, 'c')\n m[:] = 3\n return m.sum(), fromfile(f, int32)", filename, np_memmap2=[str])
+
+    def test_memmap3(self):
+        filename = mkstemp()[1]
+        numpy.arange(8, dtype=numpy.uint8).tofile(filename)
+        self.run_test("def np_memmap3(f): from numpy import memmap ; return memmap(f, mode='r').sum()", filename, np_memmap3=[str])
+
     def test_outer0(self):
         self.run_test("def np_outer0(x): from numpy import outer ; return outer(x, x+2)", numpy.arange(6).reshape(2,3), np_outer0=[numpy.array([[int]])])
 
@@ -526,6 +652,12 @@ def np_rosen_der(x):
     def test_sort4(self):
         self.run_test("def np_sort4(a): from numpy import sort ; return sort(a, 1)", numpy.arange(2*3*4, 0, -1).reshape(2,3,4), np_sort4=[numpy.array([[[int]]])])
 
+    def test_sort5(self):
+        self.run_test("def np_sort5(a): from numpy import sort ; return sort(a, 0)", (numpy.arange(6000.) * 7919 % 6007).reshape(2000, 3), np_sort5=[numpy.array([[float]])])
+
+    def test_sort6(self):
+        self.run_test("def np_sort6(a): from numpy import sort ; return sort(a)", numpy.arange(-5000, 5000) * 7919 % 10007 - 5000, np_sort6=[numpy.array([int])])
+
     def test_sort_complex0(self):
         self.run_test("def np_sort_complex0(a): from numpy import sort_complex ; return sort_complex(a)", numpy.array([[1,6],[7,5]]), np_sort_complex0=[numpy.array([[int]])])
 
@@ -556,6 +688,14 @@ def np_rosen_der(x):
     def test_tile1(self):
         self.run_test("def np_tile1(a): from numpy import tile ; return tile(a, (3, 2))", numpy.arange(4), np_tile1=[numpy.array([int])])
 
+    def test_tofile0(self):
+        filename = mkstemp()[1]
+        self.run_test("def np_tofile0(a, f): from numpy import fromfile ; (a * 2).tofile(f) ; return fromfile(f, int)", numpy.arange(12).reshape(3,4), filename, np_tofile0=[numpy.array([[int]]), str])
+
+    def test_tofile1(self):
+        filename = mkstemp()[1]
+        self.run_test("def np_tofile1(a, f): a.tofile(f, sep=', ') ; return file(f).read()", numpy.arange(6.) / 4, filename, np_tofile1=[numpy.array([float]), str])
+
     def test_tolist0(self):
         self.run_test("def np_tolist0(a): return a.tolist()", numpy.arange(12), np_tolist0=[numpy.array([int])])
 
@@ -42,6 +42,18 @@ class TestNumpyFunc1(TestEnv):
     def test_sum11_(self):
         self.run_test("def np_sum11_(a): import numpy as np ; return np.sum(a+a,2)", numpy.arange(12).reshape(2,3,2), np_sum11_=[numpy.array([[[int]]])])
 
+    def test_sum12_(self):
+        self.run_test("def np_sum12_(a): import numpy as np ; return np.sum(a)", numpy.arange(100000.), np_sum12_=[numpy.array([float])])
+
+    def test_sum13_(self):
+        self.run_test("def np_sum13_(a): import numpy as np ; return np.sum(a[::2, 1:], 0)", numpy.arange(30000).reshape(3000,10), np_sum13_=[numpy.array([[int]])])
+
+    def test_sum14_(self):
+        self.run_test("def np_sum14_(a): import numpy as np ; return np.sum(a.T, 1)", numpy.arange(30000).reshape(3000,10), np_sum14_=[numpy.array([[int]])])
+
+    def test_sum_bool3(self):
+        self.run_test("def np_sum_bool3(a): return (a > 4).sum(0)", numpy.arange(12).reshape(3,4), np_sum_bool3=[numpy.array([[int]])])
+
     def test_prod_(self):
         self.run_test("def np_prod_(a): return a.prod()", numpy.arange(10), np_prod_=[numpy.array([int])])
 
@@ -192,6 +204,12 @@ class TestNumpyFunc1(TestEnv):
     def test_all5_(self):
         self.run_test("def np_all5_(a): return a.all(0)", numpy.arange(10), np_all5_=[numpy.array([int])])
 
+    def test_all6_(self):
+        self.run_test("def np_all6_(a): return (a > 3).all(1)", numpy.arange(24).reshape(2,3,4), np_all6_=[numpy.array([[[int]]])])
+
+    def test_any6_(self):
+        self.run_test("def np_any6_(a): return (a > 21).any(2)", numpy.arange(24).reshape(2,3,4), np_any6_=[numpy.array([[[int]]])])
+
     def test_transpose_(self):
         self.run_test("def np_transpose_(a): return a.transpose()", numpy.arange(24).reshape(2,3,4), np_transpose_=[numpy.array([[[int]]])])
 
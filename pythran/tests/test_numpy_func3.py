@@ -22,6 +22,36 @@ class TestNumpyFunc3(TestEnv):
     def test_dot4(self):
         self.run_test("def np_dot4(x): from numpy import dot ; y = [2, 3] ; return dot(x,y)", numpy.array([2, 3]), np_dot4=[numpy.array([int])])
 
+    def test_dot5(self):
+        self.run_test("def np_dot5(x, y): from numpy import dot ; return dot(x,y)", numpy.arange(6.).reshape(2,3), numpy.arange(3.), np_dot5=[numpy.array([[float]]), numpy.array([float])])
+
+    def test_dot6(self):
+        self.run_test("def np_dot6(x, y): from numpy import dot ; return dot(x,y)", numpy.arange(3.), numpy.arange(12.).reshape(3,4), np_dot6=[numpy.array([float]), numpy.array([[float]])])
+
+    def test_dot7(self):
+        self.run_test("def np_dot7(x, y): from numpy import dot ; return dot(x,y)", numpy.arange(70.).reshape(7,10), numpy.arange(130.).reshape(10,13), np_dot7=[numpy.array([[float]]), numpy.array([[float]])])
+
+    def test_dot8(self):
+        self.run_test("def np_dot8(x, y): from numpy import dot ; return dot(x,y)", numpy.arange(300).reshape(20,15), numpy.arange(15.).reshape(15,1), np_dot8=[numpy.array([[int]]), numpy.array([[float]])])
+
+    def test_dot9(self):
+        self.run_test("def np_dot9(x, y): from numpy import dot ; return dot(x.T,y)", numpy.arange(70.).reshape(10,7), numpy.arange(130.).reshape(10,13), np_dot9=[numpy.array([[float]]), numpy.array([[float]])])
+
+    def test_dot10(self):
+        self.run_test("def np_dot10(x, y): from numpy import dot ; return dot(x[1:7:2,::3],y[::3, 2:])", numpy.arange(100.).reshape(10,10), numpy.arange(130.).reshape(10,13), np_dot10=[numpy.array([[float]]), numpy.array([[float]])])
+
+    def test_dot11(self):
+        self.run_test("def np_dot11(x, y): from numpy import dot ; return dot(x.T,y[:,1])", numpy.arange(70.).reshape(10,7), numpy.arange(130.).reshape(10,13), np_dot11=[numpy.array([[float]]), numpy.array([[float]])])
+
+    def test_dot12(self):
+        self.run_test("def np_dot12(x, y): from numpy import dot ; return dot(x+1,y*y)", numpy.arange(300.).reshape(10,30), numpy.arange(1200.).reshape(30,40), np_dot12=[numpy.array([[float]]), numpy.array([[float]])])
+
+    def test_dot13(self):
+        self.run_test("def np_dot13(x, y): from numpy import dot ; return dot(x,y)", numpy.arange(12j).reshape(3,4), numpy.arange(8.).reshape(4,2), np_dot13=[numpy.array([[complex]]), numpy.array([[float]])])
+
+    def test_matmul0(self):
+        self.run_test("def np_matmul0(x, y): from numpy import matmul ; return matmul(x,y)", numpy.arange(6.).reshape(2,3), numpy.arange(12.).reshape(3,4), np_matmul0=[numpy.array([[float]]), numpy.array([[float]])])
+
     def test_digitize0(self):
         self.run_test("def np_digitize0(x): from numpy import array, digitize ; bins = array([0.0, 1.0, 2.5, 4.0, 10.0]) ; return digitize(x, bins)", numpy.array([0.2, 6.4, 3.0, 1.6]), np_digitize0=[numpy.array([float])])
 
@@ -103,6 +133,9 @@ def np_trim_zeros2(x):
     def test_union1d(self):
         self.run_test("def np_union1d(x): from numpy import arange, union1d ; y = arange(1,4); return union1d(x, y)", numpy.arange(-1,2), np_union1d=[numpy.array([int])])
 
+    def test_union1d1(self):
+        self.run_test("def np_union1d1(x, y): from numpy import union1d ; return union1d(x, y)", numpy.array([[3, 1], [1, 7]]), numpy.array([2., 3.]), np_union1d1=[numpy.array([[int]]), numpy.array([float])])
+
     def test_unique0(self):
         self.run_test("def np_unique0(x): from numpy import unique ; return unique(x)", numpy.array([1,1,2,2,2,1,5]), np_unique0=[numpy.array([int])])
 
@@ -115,6 +148,15 @@ def np_trim_zeros2(x):
     def test_unique3(self):
         self.run_test("def np_unique3(x): from numpy import unique ; return unique(x, True, True)", numpy.array([1,1,2,2,2,1,5]), np_unique3=[numpy.array([int])])
 
+    def test_unique4(self):
+        self.run_test("def np_unique4(x): from numpy import unique ; return unique(x, True, True, True)", numpy.array([[1.5,1,2],[2,-2,1.5]]), np_unique4=[numpy.array([[float]])])
+
+    def test_unique5(self):
+        self.run_test("def np_unique5(x): from numpy import unique ; return unique(x, True, True)", numpy.arange(10000) * 7919 % 1009, np_unique5=[numpy.array([int])])
+
+    def test_unique6(self):
+        self.run_test("def np_unique6(x): from numpy import unique ; return unique(x, True, True, True)", numpy.array([1+2j, 1j, 1+2j, 1-1j, 1j]), np_unique6=[numpy.array([complex])])
+
     def test_unwrap0(self):
         self.run_test("def np_unwrap0(x): from numpy import unwrap, pi ; x[:3] += 2*pi; return unwrap(x)", numpy.arange(6), np_unwrap0=[numpy.array([int])])
 
@@ -0,0 +1,53 @@
+from test_env import TestEnv
+
+
+@TestEnv.module
+class TestNumpyRandom(TestEnv):
+
+    def test_numpy_random_rand(self):
+        self.run_test("def numpy_random_rand(n): from numpy.random import rand ; a = rand(n, 3) ; return a.shape, abs(a.mean() - .5) < .05, a.min() >= 0, a.max() < 1", 10**5, numpy_random_rand=[int])
+
+    def test_numpy_random_rand_scalar(self):
+        self.run_test("def numpy_random_rand_scalar(n): from numpy.random import rand ; s = sum(rand() for x in range(n)) ; return abs(s / n - .5) < .05", 10**5, numpy_random_rand_scalar=[int])
+
+    def test_numpy_random_randn(self):
+        self.run_test("def numpy_random_randn(n): from numpy.random import randn ; a = randn(n) ; return abs(a.mean()) < .05, abs(a.std() - 1) < .05", 10**6, numpy_random_randn=[int])
+
+    def test_numpy_random_random_sample(self):
+        self.run_test("def numpy_random_random_sample(n): from numpy.random import random_sample ; a = random_sample((n, 2)) ; return a.shape, abs(a.mean() - .5) < .05", 10**5, numpy_random_random_sample=[int])
+
+    def test_numpy_random_normal(self):
+        self.run_test("def numpy_random_normal(n): from numpy.random import normal ; a = normal(5, 2, n) ; return abs(a.mean() - 5) < .05, abs(a.std() - 2) < .05", 10**6, numpy_random_normal=[int])
+
+    def test_numpy_random_normal_keywords(self):
+        self.run_test("def numpy_random_normal_keywords(n): from numpy.random import normal ; a = normal(size=n, scale=3.) ; return abs(a.mean()) < .05, abs(a.std() - 3) < .05", 10**6, numpy_random_normal_keywords=[int])
+
+    def test_numpy_random_uniform(self):
+        self.run_test("def numpy_random_uniform(n): from numpy.random import uniform ; a = uniform(-2, 6, n) ; return abs(a.mean() - 2) < .05, a.min() >= -2, a.max() < 6", 10**6, numpy_random_uniform=[int])
+
+    def test_numpy_random_exponential(self):
+        self.run_test("def numpy_random_exponential(n): from numpy.random import exponential ; a = exponential(2., n) ; return abs(a.mean() - 2) < .05, a.min() >= 0", 10**6, numpy_random_exponential=[int])
+
+    def test_numpy_random_randint(self):
+        self.run_test("def numpy_random_randint(n): from numpy.random import randint ; a = randint(-3, 7, n) ; return abs(a.mean() - 1.5) < .05, a.min(), a.max()", 10**6, numpy_random_randint=[int])
+
+    def test_numpy_random_randint_keywords(self):
+        self.run_test("def numpy_random_randint_keywords(n): from numpy.random import randint ; a = randint(10, size=(n, 2)) ; return a.shape, a.min(), a.max()", 10**5, numpy_random_randint_keywords=[int])
+
+    def test_numpy_random_choice(self):
+        self.run_test("def numpy_random_choice(n): from numpy.random import choice ; a = choice([1., 2., 3.], n) ; return abs(a.mean() - 2) < .05, sorted(set(a))", 10**5, numpy_random_choice=[int])
+
+    def test_numpy_random_choice_p(self):
+        self.run_test("def numpy_random_choice_p(n): from numpy.random import choice ; a = choice(4, n, p=[0., .5, 0., .5]) ; return abs(a.mean() - 2) < .05, sorted(set(a))", 10**5, numpy_random_choice_p=[int])
+
+    def test_numpy_random_choice_noreplace(self):
+        self.run_test("def numpy_random_choice_noreplace(n): from numpy.random import choice ; a = choice(n, n, replace=False) ; return sorted(a)", 100, numpy_random_choice_noreplace=[int])
+
+    def test_numpy_random_shuffle(self):
+        self.run_test("def numpy_random_shuffle(n): from numpy.random import shuffle ; import numpy ; a = numpy.arange(2 * n).reshape(n, 2) ; shuffle(a) ; return sorted(a[:,0]), all(a[:,1] == a[:,0] + 1)", 100, numpy_random_shuffle=[int])
+
+    def test_numpy_random_permutation(self):
+        self.run_test("def numpy_random_permutation(n): from numpy.random import permutation ; return sorted(permutation(n))", 100, numpy_random_permutation=[int])
+
+    def test_numpy_random_seed(self):
+        self.run_test("def numpy_random_seed(n): from numpy.random import seed, randn ; seed(4) ; a = randn(n) ; seed(4) ; b = randn(n) ; return all(a == b)", 10**5, numpy_random_seed=[int])
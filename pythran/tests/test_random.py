@@ -34,5 +34,14 @@ class TestRandom(TestEnv):
     def test_choice(self):
         self.run_test("def choice_(n): from random import choice ; s= sum(choice(range(n)) for x in xrange(n)) ; return abs(s/n - n/2) < .05", 10**5,  choice_=[int])
 
+    def test_choice_empty(self):
+        self.run_test("def choice_empty(n): from random import choice ; return choice(range(n))", 0, choice_empty=[int], check_exception=True)
+
     def test_random_seed(self):
         self.run_test("def random_seed(): from random import random, seed ; seed(1) ; a = random() ; seed(1); b = random(); return a == b", random_seed=[])
+
+    def test_random_seed_parallel(self):
+        self.run_test('def random_seed_parallel(n):\n from random import random, seed\n def draw():\n  l = [0.] * n\n  "omp parallel for"\n  for i in xrange(n):\n   l[i] = random()\n  return sum(l)\n seed(3)\n a = draw()\n seed(3)\n b = draw()\n return a == b', 10**5, random_seed_parallel=[int])
+
+    def test_randrange_step(self):
+        self.run_test("def randrange_step(n): from random import randrange ; s= [randrange(n,0,-3) for x in range(n)] ; return all(0 < x <= n and (n - x) % 3 == 0 for x in s)", 10**4, randrange_step=[int])
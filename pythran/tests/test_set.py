@@ -190,3 +190,6 @@ def are_equal(s1):
     def test_print_empty_set(self):
         self.run_test("def print_empty_set(s): return str(s)", set(), print_empty_set=[{int}])
 
+
+    def test_large_set_algebra(self):
+        self.run_test("def large_set_algebra(n):\n s = set(i * 7 % n for i in range(n))\n t = set(range(0, 2 * n, 3))\n for i in range(0, n, 2): s.discard(i)\n return len(s), len(s & t), len(s | t), len(s - t), len(s ^ t), sorted(s & t)[:10]", 10000, large_set_algebra=[int])
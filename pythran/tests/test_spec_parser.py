@@ -29,6 +29,8 @@ import os.path
 #pythran export a( (int32, ( uint32 , int64 ) ) )
 #pythran export a( uint64:float32 dict )
 #pythran export a( float64, complex64, complex128 )
+#pythran export a( float[:] )
+#pythran export a( int32[:,:,:] )
 
 class TestSpecParser(unittest.TestCase):
 
@@ -14,6 +14,12 @@ class TestStr(TestEnv):
     def test_str_endswith1(self):
         self.run_test("def str_endswith1(s0, s1): return s0.endswith(s1)", "barbapapa", "papy", str_endswith1=[str, str])
 
+    def test_str_startswith_negative(self):
+        self.run_test("def str_startswith_negative(s0, s1): return s0.startswith(s1, -13), s0.startswith(s1, -3, -1), s0.startswith(s1, 40), s0.startswith('', 40)", "abcdefghijklmnopqrstuvwxyz0123456789", "xyz", str_startswith_negative=[str, str])
+
+    def test_str_endswith_negative(self):
+        self.run_test("def str_endswith_negative(s0, s1): return s0.endswith(s1, -13, -10), s0.endswith(s1, -50, 3), s0.endswith(s1, 0, -40), s0.endswith('', 40)", "abcdefghijklmnopqrstuvwxyz0123456789", "xyz", str_endswith_negative=[str, str])
+
     def test_str_empty(self):
         self.run_test("def str_empty(s0): return '>o_/' if s0 else '0x0'", "", str_empty=[str])
 
@@ -92,6 +98,9 @@ class TestStr(TestEnv):
     def test_str_find1(self):
         self.run_test("def str_find1(s): return s.find('pap')", "popop", str_find1=[str])
 
+    def test_str_find_negative(self):
+        self.run_test("def str_find_negative(s): return s.find('c', 0, -1), s.find('c', -3), s.find('c', -2, -1), s.find('', 7), s.find('', -9, -8)", "abcabc", str_find_negative=[str])
+
     def test_str_reversal(self):
         self.run_test("def str_reversal(s): return map(ord,reversed(s))", "dear", str_reversal=[str])
 
@@ -108,3 +117,29 @@ class TestStr(TestEnv):
         self.run_test("def str_count(s, t, u, v): return s.count(t), s.count(u), s.count(v)",
                       "pythran is good for health", "py", "niet", "t",
                       str_count=[str, str, str, str])
+
+    def test_str_copy_is_not_modified(self):
+        self.run_test("def str_copy_is_not_modified(s):\n t = s\n s += 'x'\n u = t.upper()\n return s, t, u",
+                      "a string longer than the inline buffer",
+                      str_copy_is_not_modified=[str])
+
+    def test_str_intern(self):
+        self.run_test("def str_intern(l):\n d = {}\n for w in l: k = intern(w) ; d[k] = d.get(k, 0) + 1\n return sorted(d.items())",
+                      ["a", "bb", "some rather long token", "a", "some rather long token"],
+                      str_intern=[[str]])
+
+    def test_str_split_views(self):
+        self.run_test("def str_split_views(s, u):\n l = s.split(' ')\n t = l[1]\n t += '!'\n return l, t, '|'.join(l), u.strip(), u.lstrip(), u.rstrip()",
+                      "2014-03-12 some-host-with-a-long-name message: nothing to report here",
+                      "   a padded string that is long enough to be shared   ",
+                      str_split_views=[str, str])
+
+    def test_str_partition(self):
+        self.run_test("def str_partition(s, t): return s.partition(t), s.rpartition(t), s.partition('#'), s.rpartition('#')",
+                      "key = value = other value", " = ",
+                      str_partition=[str, str])
+
+    def test_str_search(self):
+        self.run_test("def str_search(s, t): return s.count(t), s.find(t), s.find(t, 40), s.replace(t, 'x'), s.replace('', '-', 3), s.upper(), s.lower(), s.isdigit(), s[:8].isdigit(), s.isalpha(), 'AbCdEfGhIjKlMnOpQrStUvWxYz'.isalpha()",
+                      "12345678 a longer string to search for pattern, and pattern again, PATTERN", "pattern",
+                      str_search=[str, str])
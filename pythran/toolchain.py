@@ -4,6 +4,7 @@ a dynamic library, see __init__.py for exported interfaces.
 '''
 
 from pythran.backend import Cxx
+from pythran.cache import ModuleCache
 from pythran.config import cfg
 from pythran.cxxgen import BoostPythonModule, Define, Include, Line, Statement
 from pythran.cxxgen import FunctionBody, FunctionDeclaration, Value, Block
@@ -12,7 +13,8 @@ from pythran.middlend import refine
 from pythran.passmanager import PassManager
 from pythran.tables import pythran_ward, functions
 from pythran.typing import extract_constructed_types, pytype_to_ctype
-from pythran.typing import pytype_to_deps
+from pythran.spec import StridedArray
+from pythran.typing import pytype_to_deps, strided_ctype
 import pythran.frontend as frontend
 
 from numpy import get_include
@@ -40,6 +42,34 @@ def _extract_all_constructed_types(v):
                   key=len)
 
 
+def _signature_variants(signature):
+    '''C++ argument types of the overloads generated for an exported
+    signature, in registration order: Boost.Python tries the last registered
+    overload first.
+
+    A strided array argument, such as float[:,:], may be a contiguous array,
+    a strided view over the input memory for sliced arrays or, for matrices,
+    a transposed view for Fortran ordered ones. One overload per combination
+    of layouts would instantiate the function 3^k times for k matrices, so
+    there are at most three of them, tried in this order: every argument
+    contiguous, every matrix transposed, and every argument strided. The
+    converter of the latter copies the arguments that are not slices of a C
+    ordered array, so that calls mixing layouts still match.'''
+    contiguous = [pytype_to_ctype(t) for t in signature]
+    flags = [isinstance(t, StridedArray) for t in signature]
+    if not any(flags):
+        return [contiguous]
+    sliced = [strided_ctype(t) if flag else ctype
+              for t, flag, ctype in zip(signature, flags, contiguous)]
+    variants = [sliced]
+    if any(flag and t.ndim == 2 for t, flag in zip(signature, flags)):
+        variants.append([strided_ctype(t, fortran=True)
+                         if flag and t.ndim == 2 else ctype
+                         for t, flag, ctype in zip(signature, flags, sliced)])
+    variants.append(contiguous)
+    return variants
+
+
 def _extract_specs_dependencies(specs):
     deps = set()
     for _, signatures in specs.iteritems():
@@ -74,6 +104,17 @@ def _pythran_cppflags():
     return [get('.'), get('pythran')]
 
 
+def _allocator_cppflags():
+    allocator = cfg.get('pythran', 'allocator')
+    if allocator == 'malloc':
+        return []
+    elif allocator in ('pool', 'arena'):
+        return ['-DPYTHRAN_ALLOCATOR_' + allocator.upper()]
+    else:
+        raise ValueError("unknown allocator '{0}' in pythran.cfg, "
+                         "expected one of malloc, pool, arena".format(allocator))
+
+
 def _python_ldflags():
     pylibs = sysconfig.get_config_var('LIBS').split()
     return (["-L" + sysconfig.get_config_var("LIBPL")]
@@ -134,6 +175,7 @@ def cppflags():
     return (_python_cppflags() +
             _numpy_cppflags() +
             _pythran_cppflags() +
+            _allocator_cppflags() +
             cfg.get('sys', 'cppflags').split() +
             cfg.get('user', 'cppflags').split())
 
@@ -236,10 +278,12 @@ def generate_cxx(module_name, code, specs=None, optimizations=None):
         for function_name, signatures in specs.iteritems():
             internal_func_name = renamings.get(function_name,
                                                function_name)
-            for sigid, signature in enumerate(signatures):
+            overloads = ((signature, arguments_types)
+                         for signature in signatures
+                         for arguments_types in _signature_variants(signature))
+            for sigid, (signature, arguments_types) in enumerate(overloads):
                 numbered_function_name = "{0}{1}".format(internal_func_name,
                                                          sigid)
-                arguments_types = [pytype_to_ctype(t) for t in signature]
                 has_arguments = HasArgument(internal_func_name).visit(ir)
                 arguments = ["a{0}".format(i)
                              for i in xrange(len(arguments_types))]
@@ -256,6 +300,11 @@ def generate_cxx(module_name, code, specs=None, optimizations=None):
                 mod.add_to_init(
                     [Statement("pythonic::python_to_pythran<{0}>()".format(t))
                      for t in _extract_all_constructed_types(signature)])
+                # strided views of the array arguments, if any
+                mod.add_to_init(
+                    [Statement("pythonic::python_to_pythran<{0}>()".format(t))
+                     for t, s in zip(arguments_types, signature)
+                     if t != pytype_to_ctype(s)])
                 mod.add_to_init([Statement(
                     "pythonic::pythran_to_python<{0}>()".format(result_type))])
                 mod.add_function(
@@ -342,6 +391,25 @@ def compile_pythrancode(module_name, pythrancode, specs=None,
     if specs is None:
         specs = spec_parser(pythrancode)
 
+    # Look for a module previously built from the same input
+    cache = ModuleCache.from_config()
+    if cache:
+        flags = (kwargs.get('cxx', default_compiler()),
+                 cppflags() + kwargs.get('cppflags', []),
+                 cxxflags() + kwargs.get('cxxflags', []),
+                 ldflags() + kwargs.get('ldflags', []))
+        key = cache.key(module_name, pythrancode, specs,
+                        opts or cfg.get('pythran', 'optimizations').split(),
+                        flags)
+        cached = cache.lookup(key, module_name + (".cpp" if cpponly
+                                                  else ".so"))
+        if cached:
+            if not module_so:
+                fd, module_so = mkstemp(os.path.splitext(cached)[1])
+                os.close(fd)
+            shutil.copy(cached, module_so)
+            return module_so
+
     # Generate C++, get a BoostPythonModule object
     module = generate_cxx(module_name, pythrancode, specs, opts)
 
@@ -352,11 +420,19 @@ def compile_pythrancode(module_name, pythrancode, specs=None,
             shutil.move(output_file, module_so)
             output_file = module_so
         logger.info("Generated C++ source file: " + output_file)
+        if cache:
+            cache.store(key, {module_name + ".cpp": output_file})
     else:
         # Compile to binary
-        output_file = compile_cxxcode(str(module.generate()),
+        cxxcode = str(module.generate())
+        output_file = compile_cxxcode(cxxcode,
                                       module_so=module_so,
                                       **kwargs)
+        if cache:
+            _, cxxfile = _get_temp(cxxcode)
+            cache.store(key, {module_name + ".cpp": cxxfile,
+                              module_name + ".so": output_file})
+            os.remove(cxxfile)
 
     return output_file
 
@@ -50,6 +50,19 @@ def pytype_to_ctype(t):
         raise NotImplementedError("{0}:{1}".format(type(t), t))
 
 
+def strided_ctype(t, fortran=False):
+    '''c++ type of a view over the memory of a strided array of type t:
+    a transposed matrix for Fortran ordered matrices, a slice along each
+    dimension otherwise'''
+    dtype = pytype_to_ctype(t.flat[0])
+    if fortran and t.ndim == 2:
+        return ('pythonic::types::numpy_texpr<'
+                'pythonic::types::ndarray<{0},2>>').format(dtype)
+    return ('pythonic::types::numpy_gexpr<'
+            'pythonic::types::ndarray<{0},{1}>,{2}>').format(
+        dtype, t.ndim, ','.join(['pythonic::types::slice'] * t.ndim))
+
+
 def pytype_to_deps(t):
     '''python -> c++ type binding'''
     if isinstance(t, list):